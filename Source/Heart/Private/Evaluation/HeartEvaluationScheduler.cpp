@@ -0,0 +1,174 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Evaluation/HeartEvaluationScheduler.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "Tasks/Task.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartEvaluationScheduler)
+
+namespace Heart::Evaluation
+{
+	static int32 RunSerial(TBitArray<>& Dirty, const FDependentsFunc Dependents, const FRunNodeFunc RunNode)
+	{
+		int32 NumRun = 0;
+
+		// Dirtying dependents only ever marks nodes further ahead.
+		for (int32 Node = Dirty.Find(true); Node != INDEX_NONE; Node = Dirty.FindFrom(true, Node + 1))
+		{
+			Dirty[Node] = false;
+			NumRun++;
+
+			if (RunNode(Node))
+			{
+				for (const int32 Dependent : Dependents(Node))
+				{
+					Dirty[Dependent] = true;
+				}
+			}
+		}
+
+		return NumRun;
+	}
+
+	int32 RunScheduled(const EHeartEvaluationMode Mode, TBitArray<>& Dirty, const TBitArray<>& GameThreadOnly,
+					   const FDependentsFunc Dependents, const FRunNodeFunc RunNode)
+	{
+		if (Mode == EHeartEvaluationMode::Serial)
+		{
+			return RunSerial(Dirty, Dependents, RunNode);
+		}
+
+		check(IsInGameThread());
+
+		const int32 NumNodes = Dirty.Num();
+
+		// Every node that could be dirtied by this run, and the dirtiable producers of each.
+		TBitArray<> Affected = Dirty;
+		TArray<TArray<int32, TInlineAllocator<4>>> Producers;
+		Producers.SetNum(NumNodes);
+
+		TArray<int32> Schedule;
+		for (int32 Node = Affected.Find(true); Node != INDEX_NONE; Node = Affected.FindFrom(true, Node + 1))
+		{
+			Schedule.Add(Node);
+			for (const int32 Dependent : Dependents(Node))
+			{
+				Affected[Dependent] = true;
+				Producers[Dependent].Add(Node);
+			}
+		}
+
+		if (Schedule.IsEmpty())
+		{
+			return 0;
+		}
+
+		// Set by producers whose outputs changed. Tasks only read their own flag after all producers have completed.
+		const TUniquePtr<std::atomic<bool>[]> Pending(new std::atomic<bool>[NumNodes]);
+		for (const int32 Node : Schedule)
+		{
+			Pending[Node].store(Dirty[Node], std::memory_order_relaxed);
+		}
+
+		std::atomic<int32> NumRun = 0;
+
+		auto RunOne = [&](const int32 Node)
+			{
+				if (!Pending[Node].load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				NumRun.fetch_add(1, std::memory_order_relaxed);
+
+				if (RunNode(Node))
+				{
+					for (const int32 Dependent : Dependents(Node))
+					{
+						Pending[Dependent].store(true, std::memory_order_relaxed);
+					}
+				}
+			};
+
+		Dirty.Init(false, NumNodes);
+
+		if (Mode == EHeartEvaluationMode::Deterministic)
+		{
+			// Schedule is already topologically ordered.
+			for (const int32 Node : Schedule)
+			{
+				RunOne(Node);
+			}
+			return NumRun.load();
+		}
+
+		// Game thread nodes are completed by events, triggered once the calling thread has run them.
+		TArray<int32> EventIndex;
+		EventIndex.Init(INDEX_NONE, NumNodes);
+		TArray<UE::Tasks::FTaskEvent> Events;
+		for (const int32 Node : Schedule)
+		{
+			if (GameThreadOnly[Node])
+			{
+				EventIndex[Node] = Events.Num();
+				Events.Emplace(TEXT("HeartGameThreadNode"));
+			}
+		}
+
+		TQueue<int32, EQueueMode::Mpsc> GameThreadQueue;
+		const FEventRef GameThreadWake;
+
+		TArray<UE::Tasks::FTask> Tasks;
+		Tasks.SetNum(NumNodes);
+
+		TArray<UE::Tasks::FTask> Prerequisites;
+		for (const int32 Node : Schedule)
+		{
+			Prerequisites.Reset();
+			for (const int32 Producer : Producers[Node])
+			{
+				Prerequisites.Add(Tasks[Producer]);
+			}
+
+			if (EventIndex[Node] == INDEX_NONE)
+			{
+				Tasks[Node] = UE::Tasks::Launch(TEXT("HeartNode"), [&RunOne, Node] { RunOne(Node); }, Prerequisites);
+			}
+			else
+			{
+				// Hand the node to the game thread, and stay incomplete until it has run.
+				Tasks[Node] = UE::Tasks::Launch(TEXT("HeartGameThreadNodeDispatch"),
+					[&GameThreadQueue, &GameThreadWake, &Events, Event = EventIndex[Node], Node]
+					{
+						GameThreadQueue.Enqueue(Node);
+						GameThreadWake->Trigger();
+						UE::Tasks::AddNested(Events[Event]);
+					},
+					Prerequisites);
+			}
+		}
+
+		for (int32 Remaining = Events.Num(); Remaining > 0;)
+		{
+			int32 Node;
+			if (GameThreadQueue.Dequeue(Node))
+			{
+				RunOne(Node);
+				Events[EventIndex[Node]].Trigger();
+				Remaining--;
+			}
+			else
+			{
+				GameThreadWake->Wait();
+			}
+		}
+
+		for (const int32 Node : Schedule)
+		{
+			Tasks[Node].Wait();
+		}
+
+		return NumRun.load();
+	}
+}
@@ -0,0 +1,178 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Evaluation/HeartGraphEvaluator.h"
+#include "Evaluation/HeartNodeEvaluator.h"
+#include "Model/HeartGraph.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartGraphEvaluator)
+
+void UHeartGraphEvaluator::SetGraph(UHeartGraph* InGraph)
+{
+	if (Graph == InGraph)
+	{
+		return;
+	}
+
+	Graph = InGraph;
+	Program.Reset();
+	Slots.Reset();
+	Dirty.Reset();
+	Compiled = false;
+	FailedVersion.Reset();
+}
+
+int32 UHeartGraphEvaluator::Evaluate(const EHeartEvaluationMode Mode)
+{
+	UpdateProgram();
+
+	const int32 FirstDirty = Dirty.Find(true);
+	if (FirstDirty == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	const int32 NumInstructions = Program.NumInstructions();
+
+	// Resolve evaluators up front, as weak pointers can't be resolved safely from worker threads. Nothing before the
+	// first dirty instruction can run.
+	TArray<const IHeartNodeEvaluator*> Evaluators;
+	Evaluators.SetNumZeroed(NumInstructions);
+	TBitArray<> GameThreadOnly(false, NumInstructions);
+
+	for (int32 i = FirstDirty; i < NumInstructions; ++i)
+	{
+		const Heart::Evaluation::FInstruction& Instruction = Program.GetInstruction(i);
+		Evaluators[i] = Instruction.Evaluator.Get();
+		GameThreadOnly[i] = !Instruction.ThreadSafe;
+	}
+
+	return Heart::Evaluation::RunScheduled(Mode, Dirty, GameThreadOnly,
+		[this](const int32 i)
+		{
+			return Program.GetDependents(Program.GetInstruction(i));
+		},
+		[this, &Evaluators](const int32 i)
+		{
+			const IHeartNodeEvaluator* Evaluator = Evaluators[i];
+			if (!Evaluator)
+			{
+				return false;
+			}
+
+			Heart::Evaluation::FNodeContext Context(Program, i, Slots);
+			Evaluator->EvaluateNode(Context);
+			return Context.HasChangedOutputs();
+		});
+}
+
+void UHeartGraphEvaluator::MarkNodeDirty(const FHeartNodeGuid& Node)
+{
+	UpdateProgram();
+
+	if (const int32 Instruction = Program.FindInstruction(Node);
+		Instruction != INDEX_NONE)
+	{
+		Dirty[Instruction] = true;
+	}
+}
+
+void UHeartGraphEvaluator::MarkAllDirty()
+{
+	UpdateProgram();
+	Dirty.Init(true, Program.NumInstructions());
+}
+
+FBloodValue UHeartGraphEvaluator::GetOutputValue(const FHeartGraphPinReference& Pin) const
+{
+	const FBloodValue* Value = FindOutputValue(Pin);
+	return Value ? *Value : FBloodValue();
+}
+
+const FBloodValue* UHeartGraphEvaluator::FindOutputValue(const FHeartGraphPinReference& Pin) const
+{
+	const int32 Slot = Program.FindSlot(Pin);
+	return Slot != INDEX_NONE ? &Slots[Slot] : nullptr;
+}
+
+void UHeartGraphEvaluator::UpdateProgram()
+{
+	if (!IsValid(Graph))
+	{
+		if (Compiled)
+		{
+			SetGraph(nullptr);
+		}
+		return;
+	}
+
+	// Node moves don't change what runs, so only recompile for changes to the topology.
+	const uint64 TopologyVersion = Graph->GetTopologyVersion();
+	if (Compiled && Program.GetVersion() == TopologyVersion)
+	{
+		return;
+	}
+
+	// Don't retry a compile that already failed, until the graph changes again.
+	if (FailedVersion.IsSet() && FailedVersion.GetValue() == TopologyVersion)
+	{
+		return;
+	}
+
+	Heart::Evaluation::FProgram NewProgram;
+	if (!NewProgram.Compile(Graph))
+	{
+		// Keep the last good program until the cycle is broken.
+		FailedVersion = TopologyVersion;
+		return;
+	}
+
+	FailedVersion.Reset();
+
+	TArray<FBloodValue> NewSlots;
+	NewSlots.SetNum(NewProgram.NumSlots());
+
+	for (int32 Slot = 0; Slot < NewSlots.Num(); ++Slot)
+	{
+		if (const int32 OldSlot = Program.FindSlot(NewProgram.GetOutputPin(Slot));
+			OldSlot != INDEX_NONE)
+		{
+			NewSlots[Slot] = MoveTemp(Slots[OldSlot]);
+		}
+	}
+
+	TBitArray<> NewDirty(false, NewProgram.NumInstructions());
+
+	for (int32 i = 0; i < NewProgram.NumInstructions(); ++i)
+	{
+		const Heart::Evaluation::FInstruction& Instruction = NewProgram.GetInstruction(i);
+
+		const int32 Old = Compiled && Instruction.Node.IsValid() ? Program.FindInstruction(Instruction.Node->GetGuid()) : INDEX_NONE;
+		if (Old == INDEX_NONE || Dirty[Old])
+		{
+			NewDirty[i] = true;
+			continue;
+		}
+
+		const Heart::Evaluation::FInstruction& OldInstruction = Program.GetInstruction(Old);
+		if (Instruction.InputEnd - Instruction.InputBegin != OldInstruction.InputEnd - OldInstruction.InputBegin ||
+			Instruction.OutputEnd - Instruction.OutputBegin != OldInstruction.OutputEnd - OldInstruction.OutputBegin)
+		{
+			NewDirty[i] = true;
+			continue;
+		}
+
+		for (int32 Input = 0; Input < Instruction.InputEnd - Instruction.InputBegin; ++Input)
+		{
+			if (!NewProgram.SameSource(Instruction.InputBegin + Input, Program, OldInstruction.InputBegin + Input))
+			{
+				NewDirty[i] = true;
+				break;
+			}
+		}
+	}
+
+	Program = MoveTemp(NewProgram);
+	Slots = MoveTemp(NewSlots);
+	Dirty = MoveTemp(NewDirty);
+	Compiled = true;
+}
@@ -0,0 +1,265 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Evaluation/HeartGraphProgram.h"
+#include "Evaluation/HeartNodeEvaluator.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+namespace Heart::Evaluation
+{
+	bool FProgram::Compile(const UHeartGraph* Graph)
+	{
+		Reset();
+
+		if (!ensure(IsValid(Graph)))
+		{
+			return false;
+		}
+
+		const FHeartGraphSnapshotRef Snapshot = Graph->GetSnapshot();
+
+		TArray<int32> Order;
+		if (!Algorithms::TopologicalSort(Snapshot->GetTopology(), Order))
+		{
+			UE_LOG(LogHeartGraph, Warning, TEXT("Cannot compile graph '%s' for evaluation, as it contains a cycle"), *Graph->GetName())
+			return false;
+		}
+
+		Version = Snapshot->GetTopologyVersion();
+
+		Instructions.Reserve(Order.Num());
+		InstructionLookup.Reserve(Order.Num());
+
+		// Pass 1: Give each node an instruction, and each output a slot, so inputs can be resolved regardless of order.
+		for (const int32 Vertex : Order)
+		{
+			const FHeartNodeGuid& NodeGuid = Snapshot->GetNode(Vertex);
+			UHeartGraphNode* Node = Graph->GetNode(NodeGuid);
+
+			FInstruction& Instruction = Instructions.AddDefaulted_GetRef();
+			Instruction.Node = Node;
+
+			if (IsValid(Node))
+			{
+				if (Node->Implements<UHeartNodeEvaluator>())
+				{
+					Instruction.Evaluator = TWeakInterfacePtr<IHeartNodeEvaluator>(Node);
+				}
+				else if (UObject* NodeObject = Node->GetNodeObject();
+						 IsValid(NodeObject) && NodeObject->Implements<UHeartNodeEvaluator>())
+				{
+					Instruction.Evaluator = TWeakInterfacePtr<IHeartNodeEvaluator>(NodeObject);
+				}
+			}
+
+			// Nodes without an evaluator have nothing to run, so they're safe anywhere.
+			Instruction.ThreadSafe = !Instruction.Evaluator.IsValid() || Instruction.Evaluator->IsEvaluationThreadSafe();
+
+			InstructionLookup.Add(NodeGuid, Instructions.Num() - 1);
+
+			Instruction.OutputBegin = OutputPins.Num();
+			for (int32 Pin = Snapshot->GetPinBegin(Vertex); Pin < Snapshot->GetPinEnd(Vertex); ++Pin)
+			{
+				if (EnumHasAnyFlags(Snapshot->GetPinDirection(Pin), EHeartPinDirection::Output))
+				{
+					const FHeartGraphPinReference Reference{NodeGuid, Snapshot->GetPinGuid(Pin)};
+					SlotLookup.Add(Reference, OutputPins.Num());
+					OutputPins.Add(Reference);
+					OutputNames.Add(Snapshot->GetPinName(Pin));
+				}
+			}
+			Instruction.OutputEnd = OutputPins.Num();
+		}
+
+		// The instruction owning each slot
+		TArray<int32> SlotOwners;
+		SlotOwners.SetNumUninitialized(OutputPins.Num());
+		for (int32 i = 0; i < Instructions.Num(); ++i)
+		{
+			for (int32 Slot = Instructions[i].OutputBegin; Slot < Instructions[i].OutputEnd; ++Slot)
+			{
+				SlotOwners[Slot] = i;
+			}
+		}
+
+		// Pass 2: Resolve inputs to slots, and record which instructions read from which.
+		TArray<TPair<int32, int32>> Reads;
+		for (int32 i = 0; i < Instructions.Num(); ++i)
+		{
+			const int32 Vertex = Order[i];
+			FInstruction& Instruction = Instructions[i];
+
+			Instruction.InputBegin = InputSlots.Num();
+			for (int32 Pin = Snapshot->GetPinBegin(Vertex); Pin < Snapshot->GetPinEnd(Vertex); ++Pin)
+			{
+				if (Snapshot->GetPinDirection(Pin) != EHeartPinDirection::Input)
+				{
+					continue;
+				}
+
+				int32 Slot = INDEX_NONE;
+				if (const TConstArrayView<FHeartGraphPinReference> Links = Snapshot->GetPinLinks(Pin);
+					!Links.IsEmpty())
+				{
+					if (const int32* Found = SlotLookup.Find(Links[0]))
+					{
+						Slot = *Found;
+						Reads.Add({SlotOwners[Slot], i});
+					}
+				}
+
+				InputSlots.Add(Slot);
+				InputNames.Add(Snapshot->GetPinName(Pin));
+			}
+			Instruction.InputEnd = InputSlots.Num();
+		}
+
+		// Pass 3: Flatten the readers of each instruction.
+		Algo::Sort(Reads, [](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+			{
+				return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+			});
+		Reads.SetNum(Algo::Unique(Reads));
+
+		Dependents.Reserve(Reads.Num());
+		int32 Read = 0;
+		for (int32 i = 0; i < Instructions.Num(); ++i)
+		{
+			Instructions[i].DependentBegin = Dependents.Num();
+			for (; Read < Reads.Num() && Reads[Read].Key == i; ++Read)
+			{
+				Dependents.Add(Reads[Read].Value);
+			}
+			Instructions[i].DependentEnd = Dependents.Num();
+		}
+
+		return true;
+	}
+
+	void FProgram::Reset()
+	{
+		Version = 0;
+		Instructions.Reset();
+		InputSlots.Reset();
+		InputNames.Reset();
+		OutputPins.Reset();
+		OutputNames.Reset();
+		Dependents.Reset();
+		InstructionLookup.Reset();
+		SlotLookup.Reset();
+	}
+
+	int32 FProgram::FindInstruction(const FHeartNodeGuid& Node) const
+	{
+		const int32* Found = InstructionLookup.Find(Node);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	int32 FProgram::FindSlot(const FHeartGraphPinReference& Pin) const
+	{
+		const int32* Found = SlotLookup.Find(Pin);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	bool FProgram::SameSource(const int32 Input, const FProgram& Other, const int32 OtherInput) const
+	{
+		const int32 Slot = InputSlots[Input];
+		const int32 OtherSlot = Other.InputSlots[OtherInput];
+
+		if (Slot == INDEX_NONE || OtherSlot == INDEX_NONE)
+		{
+			return Slot == OtherSlot;
+		}
+
+		return OutputPins[Slot] == Other.OutputPins[OtherSlot];
+	}
+
+	static const FBloodValue EmptyValue;
+
+	FNodeContext::FNodeContext(const FProgram& Program, const int32 Instruction, TArray<FBloodValue>& Slots)
+	  : Program(Program),
+		Instruction(Program.GetInstruction(Instruction)),
+		Slots(Slots)
+	{
+	}
+
+	UHeartGraphNode* FNodeContext::GetNode() const
+	{
+		return Instruction.Node.Get();
+	}
+
+	const FBloodValue& FNodeContext::GetInput(const int32 Index) const
+	{
+		if (!ensure(Index >= 0 && Index < NumInputs()))
+		{
+			return EmptyValue;
+		}
+
+		const int32 Slot = Program.GetInputSlot(Instruction.InputBegin + Index);
+		return Slot == INDEX_NONE ? EmptyValue : Slots[Slot];
+	}
+
+	const FBloodValue& FNodeContext::GetInput(const FName PinName) const
+	{
+		const int32 Index = FindInput(PinName);
+		return Index == INDEX_NONE ? EmptyValue : GetInput(Index);
+	}
+
+	bool FNodeContext::IsInputConnected(const int32 Index) const
+	{
+		return Index >= 0 && Index < NumInputs() && Program.GetInputSlot(Instruction.InputBegin + Index) != INDEX_NONE;
+	}
+
+	int32 FNodeContext::FindInput(const FName PinName) const
+	{
+		for (int32 Input = Instruction.InputBegin; Input < Instruction.InputEnd; ++Input)
+		{
+			if (Program.GetInputName(Input) == PinName)
+			{
+				return Input - Instruction.InputBegin;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	int32 FNodeContext::FindOutput(const FName PinName) const
+	{
+		for (int32 Slot = Instruction.OutputBegin; Slot < Instruction.OutputEnd; ++Slot)
+		{
+			if (Program.GetOutputName(Slot) == PinName)
+			{
+				return Slot - Instruction.OutputBegin;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	void FNodeContext::SetOutput(const int32 Index, FBloodValue&& Value)
+	{
+		if (!ensure(Index >= 0 && Index < NumOutputs()))
+		{
+			return;
+		}
+
+		FBloodValue& Slot = Slots[Instruction.OutputBegin + Index];
+
+		// Comparing requires both to hold data.
+		const bool Changed = Slot.IsValid() && Value.IsValid() ? Slot != Value : Slot.IsValid() != Value.IsValid();
+		if (Changed)
+		{
+			Slot = MoveTemp(Value);
+			ChangedOutputs = true;
+		}
+	}
+
+	void FNodeContext::SetOutput(const FName PinName, FBloodValue&& Value)
+	{
+		if (const int32 Index = FindOutput(PinName);
+			ensure(Index != INDEX_NONE))
+		{
+			SetOutput(Index, MoveTemp(Value));
+		}
+	}
+}
@@ -0,0 +1,5 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Evaluation/HeartNodeEvaluator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartNodeEvaluator)
\ No newline at end of file
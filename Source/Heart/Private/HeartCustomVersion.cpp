@@ -0,0 +1,8 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "HeartCustomVersion.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FHeartCustomVersion::GUID(0x313E2579, 0x999E432D, 0xB5250393, 0x6E0EEF74);
+
+static FCustomVersionRegistration GRegisterHeartCustomVersion(FHeartCustomVersion::GUID, FHeartCustomVersion::LatestVersion, TEXT("Heart"));
\ No newline at end of file
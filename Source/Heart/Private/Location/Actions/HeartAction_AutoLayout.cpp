@@ -2,14 +2,36 @@
 
 #include "Location/Actions/HeartAction_AutoLayout.h"
 #include "Location/HeartLayoutHelper.h"
+#include "Location/HeartLayoutJob.h"
 #include "Location/HeartNodeLocationInterface.h"
 #include "Model/HeartGraph.h"
 #include "Model/HeartGraphNode.h"
+#include "Model/HeartGraphTransaction.h"
 #include "ModelView/HeartActionHistory.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(HeartAction_AutoLayout)
 
 static constexpr FLazyName OriginalLocationsStorage("oldlocs");
+static constexpr FLazyName LayoutLocationsStorage("newlocs");
+
+void UHeartAction_AutoLayout::RecordLayout(const TNotNull<UHeartGraph*> Graph, UHeartLayoutHelper* Layout,
+										   const TMap<FHeartNodeGuid, FVector2D>& OriginalLocations,
+										   const TMap<FHeartNodeGuid, FVector2D>& LayoutLocations)
+{
+	UHeartActionHistory* History = Graph->GetExtension<UHeartActionHistory>();
+	if (!IsValid(History))
+	{
+		return;
+	}
+
+	FHeartActionRecord Record;
+	Record.Action = StaticClass();
+	Record.Arguments.Target = Graph;
+	Record.Arguments.Payload = Layout;
+	Record.UndoData.Add(OriginalLocationsStorage, OriginalLocations);
+	Record.UndoData.Add(LayoutLocationsStorage, LayoutLocations);
+	History->AddRecord(Record);
+}
 
 bool UHeartAction_AutoLayout::CanExecute(const UObject* Target) const
 {
@@ -19,6 +41,29 @@ bool UHeartAction_AutoLayout::CanExecute(const UObject* Target) const
 FHeartEvent UHeartAction_AutoLayout::ExecuteOnGraph(TNotNull<UHeartGraph*> Graph, const FHeartInputActivation& Activation,
 													UObject* ContextObject, FBloodContainer& UndoData) const
 {
+	// Redo restores the recorded result. Running the layout again may not reproduce it, such as for an async layout
+	// that already spent its steps, or one seeded differently.
+	if (Activation.IsRedoAction())
+	{
+		IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
+
+		auto&& Data = UndoData.Get<TMap<FHeartNodeGuid, FVector2D>>(LayoutLocationsStorage);
+
+		Heart::API::FGraphTransaction Transaction(Graph);
+
+		TSet<FHeartNodeGuid> Touched;
+
+		for (auto&& LayoutLocation : Data)
+		{
+			Touched.Add(LayoutLocation.Key);
+			LocationInterface->SetNodeLocation(LayoutLocation.Key, LayoutLocation.Value, false);
+		}
+
+		Graph->NotifyNodeLocationsChanged(Touched, false);
+
+		return FHeartEvent::Handled;
+	}
+
 	UHeartLayoutHelper* LayoutHelper = Cast<UHeartLayoutHelper>(ContextObject);
 
 	if (!IsValid(LayoutHelper))
@@ -36,12 +81,22 @@ FHeartEvent UHeartAction_AutoLayout::ExecuteOnGraph(TNotNull<UHeartGraph*> Graph
 		return FHeartEvent::Failed;
 	}
 
-	if (Heart::Action::History::IsUndoable())
+	// A job records itself once it commits.
+	if (LayoutHelper->GetRunAsync())
 	{
-		TMap<FHeartNodeGuid, FVector2D> OriginalLocations;
+		if (UHeartLayoutJob::Start(Graph, LayoutHelper))
+		{
+			Heart::Action::History::CancelLog();
+			return FHeartEvent::Handled;
+		}
+	}
 
-		IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
+	IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
+	const bool Undoable = Heart::Action::History::IsUndoable();
 
+	TMap<FHeartNodeGuid, FVector2D> OriginalLocations;
+	if (Undoable)
+	{
 		Graph->ForEachNode(
 			[&](const TPair<FHeartNodeGuid, UHeartGraphNode*>& Pair)
 			{
@@ -52,7 +107,23 @@ FHeartEvent UHeartAction_AutoLayout::ExecuteOnGraph(TNotNull<UHeartGraph*> Graph
 		UndoData.Add(OriginalLocationsStorage, OriginalLocations);
 	}
 
-	LayoutHelper->Layout(Graph, *Graph->GetNodeLocationInterface());
+	{
+		Heart::API::FGraphTransaction Transaction(Graph);
+		LayoutHelper->Layout(Graph, *LocationInterface);
+	}
+
+	if (Undoable)
+	{
+		TMap<FHeartNodeGuid, FVector2D> LayoutLocations;
+		LayoutLocations.Reserve(OriginalLocations.Num());
+		for (auto&& OriginalLocation : OriginalLocations)
+		{
+			LayoutLocations.Add(OriginalLocation.Key, LocationInterface->GetNodeLocation(OriginalLocation.Key));
+		}
+
+		UndoData.Add(LayoutLocationsStorage, LayoutLocations);
+	}
+
 	return FHeartEvent::Handled;
 }
 
@@ -61,6 +132,8 @@ bool UHeartAction_AutoLayout::Undo(UObject* Target, const FBloodContainer& UndoD
 	UHeartGraph* Graph = Heart::Action::History::GetGraphFromActionStack();
 	IHeartNodeLocationInterface* NodeLocationInterface = Graph->GetNodeLocationInterface();
 
+	Heart::API::FGraphTransaction Transaction(Graph);
+
 	TSet<FHeartNodeGuid> Touched;
 
 	auto&& Data = UndoData.Get<TMap<FHeartNodeGuid, FVector2D>>(OriginalLocationsStorage);
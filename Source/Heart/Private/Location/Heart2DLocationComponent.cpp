@@ -30,29 +30,39 @@ void UHeart2DLocationComponent::ImportMigrationData(const FInstancedStruct& InDa
 
 FVector2D UHeart2DLocationComponent::GetNodeLocation(const FHeartNodeGuid& Node) const
 {
-	const UHeartGraph* Graph = GetGraph();
-	if (const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-		Locations.IsValidIndex(Index.Index))
+	return GetNodeLocationAtIndex(GetGraph()->GetNodeIndex(Node));
+}
+
+void UHeart2DLocationComponent::SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location, bool)
+{
+	SetNodeLocationAtIndex(GetGraph()->GetNodeIndex(Node), Location);
+}
+
+FVector2D UHeart2DLocationComponent::GetNodeLocationAtIndex(const FHeartNodeIndex Index) const
+{
+	if (Locations.IsValidIndex(Index.Index) &&
+		GetGraph()->IsValidNodeIndex(Index))
 	{
 		return Locations[Index.Index];
 	}
 	return FVector2D::ZeroVector;
 }
 
-void UHeart2DLocationComponent::SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location, bool)
+void UHeart2DLocationComponent::SetNodeLocationAtIndex(const FHeartNodeIndex Index, const FVector2D& Location)
 {
-	const UHeartGraph* Graph = GetGraph();
-	const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-	if (Index.Index != INDEX_NONE)
+	UHeartGraphNode* GraphNode = GetGraph()->ResolveNode(Index);
+	if (!GraphNode)
+	{
+		return;
+	}
+
+	if (!Locations.IsValidIndex(Index.Index))
 	{
-		if (!Locations.IsValidIndex(Index.Index))
-		{
-			Locations.SetNum(Index.Index + 1);
-		}
-		Locations[Index.Index] = Location;
+		Locations.SetNum(Index.Index + 1);
 	}
+	Locations[Index.Index] = Location;
 
-	if (UHeartGraphNode* GraphNode = Graph->GetNode(Node))
+	if (!GetGraph()->DeferNodeLocationChanged(GraphNode->GetGuid()))
 	{
 		GraphNode->OnNodeLocationChanged_Native.Broadcast(GraphNode->GetGuid(), Location);
 		GraphNode->OnNodeLocationChanged.Broadcast(GraphNode, Location);
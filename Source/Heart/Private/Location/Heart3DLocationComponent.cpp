@@ -22,64 +22,57 @@ void UHeart3DLocationComponent::ImportMigrationData(const FInstancedStruct& InDa
 
 FVector2D UHeart3DLocationComponent::GetNodeLocation(const FHeartNodeGuid& Node) const
 {
-	const UHeartGraph* Graph = GetGraph();
-	if (const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-		Locations.IsValidIndex(Index.Index))
-	{
-		return FVector2D(Locations[Index.Index]);
-	}
-	return FVector2D::ZeroVector;
+	return FVector2D(GetNodeLocationAtIndex(GetGraph()->GetNodeIndex(Node)));
 }
 
 void UHeart3DLocationComponent::SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location, bool)
 {
-	const UHeartGraph* Graph = GetGraph();
-	const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-	if (Index.Index != INDEX_NONE)
-	{
-		if (!Locations.IsValidIndex(Index.Index))
-		{
-			Locations.SetNum(Index.Index + 1);
-		}
-		FVector& NodeLocation = Locations[Index.Index];
-		NodeLocation.X = Location.X;
-		NodeLocation.Y = Location.Y;
-	}
+	const FHeartNodeIndex Index = GetGraph()->GetNodeIndex(Node);
 
-	if (UHeartGraphNode* GraphNode = Graph->GetNode(Node))
-	{
-		GraphNode->OnNodeLocationChanged_Native.Broadcast(GraphNode->Guid, Location);
-		GraphNode->OnNodeLocationChanged.Broadcast(GraphNode, Location);
-	}
+	// Preserve the existing Z when moving in 2D
+	FVector NodeLocation = GetNodeLocationAtIndex(Index);
+	NodeLocation.X = Location.X;
+	NodeLocation.Y = Location.Y;
+	SetNodeLocationAtIndex(Index, NodeLocation);
 }
 
 FVector UHeart3DLocationComponent::GetNodeLocation3D(const FHeartNodeGuid& Node) const
 {
-	const UHeartGraph* Graph = GetGraph();
-	if (const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-		Locations.IsValidIndex(Index.Index))
+	return GetNodeLocationAtIndex(GetGraph()->GetNodeIndex(Node));
+}
+
+void UHeart3DLocationComponent::SetNodeLocation3D(const FHeartNodeGuid& Node, const FVector& Location, bool)
+{
+	SetNodeLocationAtIndex(GetGraph()->GetNodeIndex(Node), Location);
+}
+
+FVector UHeart3DLocationComponent::GetNodeLocationAtIndex(const FHeartNodeIndex Index) const
+{
+	if (Locations.IsValidIndex(Index.Index) &&
+		GetGraph()->IsValidNodeIndex(Index))
 	{
 		return Locations[Index.Index];
 	}
 	return FVector::ZeroVector;
 }
 
-void UHeart3DLocationComponent::SetNodeLocation3D(const FHeartNodeGuid& Node, const FVector& Location, bool)
+void UHeart3DLocationComponent::SetNodeLocationAtIndex(const FHeartNodeIndex Index, const FVector& Location)
 {
-	const UHeartGraph* Graph = GetGraph();
-	const FHeartNodeIndex Index = Graph->GetNodeIndex(Node);
-	if (Index.Index != INDEX_NONE)
+	UHeartGraphNode* GraphNode = GetGraph()->ResolveNode(Index);
+	if (!GraphNode)
+	{
+		return;
+	}
+
+	if (!Locations.IsValidIndex(Index.Index))
 	{
-		if (!Locations.IsValidIndex(Index.Index))
-		{
-			Locations.SetNum(Index.Index + 1);
-		}
-		Locations[Index.Index] = Location;
+		Locations.SetNum(Index.Index + 1);
 	}
+	Locations[Index.Index] = Location;
 
-	if (UHeartGraphNode* GraphNode = Graph->GetNode(Node))
+	if (!GetGraph()->DeferNodeLocationChanged(GraphNode->GetGuid()))
 	{
-		GraphNode->OnNodeLocationChanged_Native.Broadcast(GraphNode->Guid, FVector2D(Location));
+		GraphNode->OnNodeLocationChanged_Native.Broadcast(GraphNode->GetGuid(), FVector2D(Location));
 		GraphNode->OnNodeLocationChanged.Broadcast(GraphNode, FVector2D(Location));
 	}
 }
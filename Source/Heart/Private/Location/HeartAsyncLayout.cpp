@@ -0,0 +1,36 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Location/HeartAsyncLayout.h"
+#include "Misc/ScopeLock.h"
+
+namespace Heart::Layout
+{
+	FAsyncLayoutContext::FAsyncLayoutContext(TArray<TArray<int32>>&& InAdjacencyList, TArray<FVector2D>&& InStartPositions)
+	  : AdjacencyList(MoveTemp(InAdjacencyList)),
+		StartPositions(MoveTemp(InStartPositions))
+	{
+		check(AdjacencyList.Num() == StartPositions.Num());
+	}
+
+	void FAsyncLayoutContext::PublishFrame(const TConstArrayView<FVector2D> Positions)
+	{
+		check(Positions.Num() == Num());
+
+		FScopeLock Lock(&FrameLock);
+		Frame = Positions;
+		HasNewFrame = true;
+	}
+
+	bool FAsyncLayoutContext::ConsumeFrame(TArray<FVector2D>& OutPositions)
+	{
+		FScopeLock Lock(&FrameLock);
+		if (!HasNewFrame)
+		{
+			return false;
+		}
+
+		OutPositions = MoveTemp(Frame);
+		HasNewFrame = false;
+		return true;
+	}
+}
@@ -21,23 +21,46 @@ bool UHeartLayoutHelper::Layout(const TNotNull<UHeartGraph*> Graph, IHeartNodeLo
 	return Layout(Graph, Interface, AllNodes, DeltaTime);
 }
 
+bool UHeartLayoutHelper::IsWithinFrameBudget(const double StartSeconds) const
+{
+	return (FPlatformTime::Seconds() - StartSeconds) * 1000.0 < FrameBudget;
+}
+
 FHeartGraphAdjacencyList UHeartLayoutHelper::GetGraphAdjacencyList(const TNotNull<UHeartGraph*> Graph, const TArray<FHeartNodeGuid>& Nodes)
 {
 	FHeartGraphAdjacencyList Result;
 
+	// Map node slots to their position in the Nodes array
+	TArray<FHeartNodeIndex> NodeIndices;
+	NodeIndices.Reserve(Nodes.Num());
+	TArray<int32> SlotToPosition;
+	SlotToPosition.Init(INDEX_NONE, Graph->GetNodeSlots().GetMaxIndex());
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		const FHeartNodeIndex NodeIndex = Graph->GetNodeIndex(Nodes[i]);
+		NodeIndices.Add(NodeIndex);
+		if (NodeIndex.IsValid())
+		{
+			SlotToPosition[NodeIndex.Index] = i;
+		}
+	}
+
+	const Heart::Graph::FAdjacencyIndex& Adjacency = Graph->GetAdjacency();
+	Result.AdjacencyList.SetNum(Nodes.Num());
+
 	for (int32 i = 0; i < Nodes.Num(); ++i)
 	{
-		const TArray<FHeartNodeGuid> OutputLinks = Heart::Utils::GetConnectedNodes(Graph, Nodes[i], EHeartPinDirection::Output);
+		const TConstArrayView<Heart::Graph::FAdjacencyEdge> OutputLinks = Adjacency.GetOutEdges(NodeIndices[i]);
 
-		TArray<int32>& NodeAdjacency = Result.AdjacencyList.AddDefaulted_GetRef();
+		TArray<int32>& NodeAdjacency = Result.AdjacencyList[i];
 		NodeAdjacency.Reserve(OutputLinks.Num());
 
 		for (auto&& OutputLink : OutputLinks)
 		{
-			if (const int32 NodeIndex = Nodes.Find(OutputLink);
-				NodeIndex != INDEX_NONE)
+			if (const int32 Position = SlotToPosition[OutputLink.Node.Index];
+				Position != INDEX_NONE)
 			{
-				NodeAdjacency.Add(NodeIndex);
+				NodeAdjacency.Add(Position);
 			}
 		}
 	}
@@ -0,0 +1,211 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Location/HeartLayoutJob.h"
+#include "Location/HeartAsyncLayout.h"
+#include "Location/HeartLayoutHelper.h"
+#include "Location/HeartNodeLocationInterface.h"
+#include "Location/Actions/HeartAction_AutoLayout.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphTransaction.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartLayoutJob)
+
+UHeartLayoutJob* UHeartLayoutJob::Start(const TNotNull<UHeartGraph*> Graph, const TNotNull<UHeartLayoutHelper*> Layout,
+										const TArray<FHeartNodeGuid>& NodesToLayout)
+{
+	const IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
+	if (!LocationInterface)
+	{
+		UE_LOG(LogHeartGraph, Warning, TEXT("Cannot start a layout job; Graph '%s' has no node location interface!"), *Graph->GetName())
+		return nullptr;
+	}
+
+	Heart::Layout::FAsyncLayoutFunction Function = Layout->MakeAsyncLayout();
+	if (!Function)
+	{
+		return nullptr;
+	}
+
+	UHeartLayoutJob* Job = NewObject<UHeartLayoutJob>(GetTransientPackage());
+	Job->WeakGraph = Graph;
+	Job->LayoutHelper = Layout;
+	Job->Nodes = NodesToLayout;
+	if (Job->Nodes.IsEmpty())
+	{
+		Graph->GetNodeGuids(Job->Nodes);
+	}
+
+	// Copy everything the layout needs now, as it can't touch the graph from the worker thread.
+	FHeartGraphAdjacencyList Adjacency = UHeartLayoutHelper::GetGraphAdjacencyList(Graph, Job->Nodes);
+
+	TArray<FVector2D> StartPositions;
+	StartPositions.Reserve(Job->Nodes.Num());
+	for (const FHeartNodeGuid& Node : Job->Nodes)
+	{
+		StartPositions.Add(LocationInterface->GetNodeLocation(Node));
+	}
+
+	Job->LatestFrame = StartPositions;
+	Job->Context = MakeShared<Heart::Layout::FAsyncLayoutContext>(MoveTemp(Adjacency.AdjacencyList), MoveTemp(StartPositions));
+
+	Job->Task = UE::Tasks::Launch(TEXT("HeartLayoutJob"),
+		[Context = Job->Context.ToSharedRef(), Function = MoveTemp(Function)]() mutable
+		{
+			return Function(*Context);
+		});
+
+	Graph->GetOnNodeAddOrRemove().AddUObject(Job, &ThisClass::OnNodeAddOrRemove);
+	Graph->GetOnNodeConnectionsChanged().AddUObject(Job, &ThisClass::OnNodeConnectionsChanged);
+	Job->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Job, &ThisClass::Tick));
+
+	// Whoever started the job may not hold on to it, so keep it alive until it finishes.
+	Job->AddToRoot();
+
+	return Job;
+}
+
+UHeartLayoutJob* UHeartLayoutJob::StartLayoutJob(UHeartGraph* Graph, UHeartLayoutHelper* Layout,
+												 const TArray<FHeartNodeGuid>& NodesToLayout)
+{
+	if (!IsValid(Graph) || !IsValid(Layout))
+	{
+		return nullptr;
+	}
+
+	return Start(Graph, Layout, NodesToLayout);
+}
+
+void UHeartLayoutJob::Cancel()
+{
+	Finish(EHeartLayoutJobState::Cancelled);
+}
+
+void UHeartLayoutJob::GetLatestFrame(TMap<FHeartNodeGuid, FVector2D>& Positions) const
+{
+	Positions.Reset();
+	Positions.Reserve(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num() && i < LatestFrame.Num(); ++i)
+	{
+		Positions.Add(Nodes[i], LatestFrame[i]);
+	}
+}
+
+void UHeartLayoutJob::BeginDestroy()
+{
+	// Let a layout that is still running stop early. Its task holds its own reference to the context.
+	if (Context.IsValid())
+	{
+		Context->Cancel();
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	Super::BeginDestroy();
+}
+
+bool UHeartLayoutJob::Tick(float DeltaTime)
+{
+	UHeartGraph* TargetGraph = WeakGraph.Get();
+	if (!IsValid(TargetGraph))
+	{
+		Finish(EHeartLayoutJobState::Failed);
+		return false;
+	}
+
+	if (Context->ConsumeFrame(LatestFrame))
+	{
+		OnFrameNative.Broadcast(this);
+		OnFrame.Broadcast(this);
+	}
+
+	if (!Task.IsCompleted())
+	{
+		return true;
+	}
+
+	if (TArray<FVector2D> Result = MoveTemp(Task.GetResult());
+		Result.Num() == Nodes.Num() && !Nodes.IsEmpty())
+	{
+		Commit(TargetGraph, MoveTemp(Result));
+	}
+	else
+	{
+		Finish(EHeartLayoutJobState::Failed);
+	}
+
+	return false;
+}
+
+void UHeartLayoutJob::OnNodeAddOrRemove(const FHeartNodeAddOrRemoveEvent& Event)
+{
+	Cancel();
+}
+
+void UHeartLayoutJob::OnNodeConnectionsChanged(const FHeartGraphConnectionEvent& Event)
+{
+	Cancel();
+}
+
+void UHeartLayoutJob::Commit(UHeartGraph* TargetGraph, TArray<FVector2D>&& Result)
+{
+	IHeartNodeLocationInterface* LocationInterface = TargetGraph->GetNodeLocationInterface();
+	if (!LocationInterface)
+	{
+		Finish(EHeartLayoutJobState::Failed);
+		return;
+	}
+
+	// Nodes may have been moved while the layout ran, so the locations to undo to are taken now, not at the start.
+	TMap<FHeartNodeGuid, FVector2D> OriginalLocations;
+	OriginalLocations.Reserve(Nodes.Num());
+
+	TMap<FHeartNodeGuid, FVector2D> LayoutLocations;
+	LayoutLocations.Reserve(Nodes.Num());
+
+	{
+		Heart::API::FGraphTransaction Transaction(TargetGraph);
+
+		TSet<FHeartNodeGuid> Touched;
+		Touched.Reserve(Nodes.Num());
+
+		for (int32 i = 0; i < Nodes.Num(); ++i)
+		{
+			OriginalLocations.Add(Nodes[i], LocationInterface->GetNodeLocation(Nodes[i]));
+			LocationInterface->SetNodeLocation(Nodes[i], Result[i], false);
+			LayoutLocations.Add(Nodes[i], Result[i]);
+			Touched.Add(Nodes[i]);
+		}
+
+		LocationInterface->NotifyNodeLocationsChanged(Touched, false);
+	}
+
+	UHeartAction_AutoLayout::RecordLayout(TargetGraph, LayoutHelper, OriginalLocations, LayoutLocations);
+
+	LatestFrame = MoveTemp(Result);
+	Finish(EHeartLayoutJobState::Committed);
+}
+
+void UHeartLayoutJob::Finish(const EHeartLayoutJobState NewState)
+{
+	if (State != EHeartLayoutJobState::Running)
+	{
+		return;
+	}
+
+	State = NewState;
+
+	Context->Cancel();
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	if (UHeartGraph* TargetGraph = WeakGraph.Get())
+	{
+		TargetGraph->GetOnNodeAddOrRemove().RemoveAll(this);
+		TargetGraph->GetOnNodeConnectionsChanged().RemoveAll(this);
+	}
+
+	OnFinishedNative.Broadcast(this, State);
+	OnFinished.Broadcast(this, State);
+
+	RemoveFromRoot();
+}
@@ -7,6 +7,9 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(HeartLayout_FruchtermanReingold)
 
+// Steps between frames published by a layout job.
+static constexpr int32 AsyncFrameInterval = 5;
+
 bool UHeartLayout_FruchtermanReingold::Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface,
 											  const TArray<FHeartNodeGuid>& Nodes, const float DeltaTime)
 {
@@ -22,18 +25,68 @@ bool UHeartLayout_FruchtermanReingold::Layout(TNotNull<UHeartGraph*> Graph, IHea
 	{
 		// @todo rebuild this when graph changes!
 		AdjacencyList = GetGraphAdjacencyList(Graph, Nodes);
-		Algorithm = Nodesoup::FruchtermanReingold(AdjacencyList.AdjacencyList, Strength);
+		Algorithm = Nodesoup::FruchtermanReingold(AdjacencyList.AdjacencyList, Strength, UseBarnesHut ? Theta : 0.0,
+			UseScalarKernels ? Nodesoup::EForceKernelPath::Scalar : Nodesoup::EForceKernelPath::Vector, RunInParallel);
 	}
 
-	Accum += DeltaTime;
-	const float IterationInterval = 1.f / IterationsPerSecond;
-	while (Accum > IterationInterval)
+	LayoutPositions.Set(Positions);
+
+	if (FrameBudget > 0.f)
+	{
+		const double StartSeconds = FPlatformTime::Seconds();
+		do
+		{
+			Algorithm.GetValue()(LayoutPositions);
+		}
+		while (IsWithinFrameBudget(StartSeconds));
+	}
+	else
 	{
-		Algorithm.GetValue()(Positions);
-		Accum -= IterationInterval;
+		Accum += DeltaTime;
+		const float IterationInterval = 1.f / IterationsPerSecond;
+		while (Accum > IterationInterval)
+		{
+			Algorithm.GetValue()(LayoutPositions);
+			Accum -= IterationInterval;
+		}
 	}
 
+	LayoutPositions.Get(Positions);
+
 	ApplyNewPositions(Cast<UObject>(&Interface), Nodes, Positions);
 
 	return true;
+}
+
+Heart::Layout::FAsyncLayoutFunction UHeartLayout_FruchtermanReingold::MakeAsyncLayout() const
+{
+	return [InStrength = Strength, InTheta = UseBarnesHut ? Theta : 0.0, Iterations = AsyncIterations,
+			KernelPath = UseScalarKernels ? Nodesoup::EForceKernelPath::Scalar : Nodesoup::EForceKernelPath::Vector,
+			Parallel = RunInParallel](Heart::Layout::FAsyncLayoutContext& Context)
+		{
+			Nodesoup::FruchtermanReingold Stepper(Context.GetAdjacencyList(), InStrength, InTheta, KernelPath, Parallel);
+
+			Nodesoup::FLayoutPositions JobPositions;
+			JobPositions.Set(Context.GetStartPositions());
+
+			TArray<FVector2D> Positions;
+			for (int32 i = 1; i <= Iterations; ++i)
+			{
+				if (Context.IsCancelled())
+				{
+					return TArray<FVector2D>();
+				}
+
+				Stepper(JobPositions);
+
+				if (i % AsyncFrameInterval == 0)
+				{
+					JobPositions.Get(Positions);
+					Context.PublishFrame(Positions);
+				}
+			}
+
+			JobPositions.Get(Positions);
+			return Positions;
+		};
 }
\ No newline at end of file
@@ -2,17 +2,60 @@
 
 #include "Location/Layouts/HeartLayout_KamadaKawai.h"
 #include "Location/HeartNodeLocationInterface.h"
+#include "Algorithms/Layout.h"
 #include "Algorithms/Nodesoup.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(HeartLayout_KamadaKawai)
 
+// Sparse stress steps between frames published by a layout job.
+static constexpr int32 AsyncFrameInterval = 5;
+
 bool UHeartLayout_KamadaKawai::Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface, const TArray<FHeartNodeGuid>& Nodes)
 {
 	const FHeartGraphAdjacencyList GraphAdjacencyList = GetGraphAdjacencyList(Graph, Nodes);
 
-	const TArray<FVector2D> NewPositions = Nodesoup::kamada_kawai(GraphAdjacencyList.AdjacencyList, Width, Height, Strength, EnergyThreshold);
+	TArray<FVector2D> NewPositions;
+	if (Nodes.Num() > SparseStressThreshold)
+	{
+		NewPositions = Nodesoup::sparse_stress(GraphAdjacencyList.AdjacencyList, Width, Height, SparseStressPivots, SparseStressIterations);
+	}
+	else
+	{
+		NewPositions = Nodesoup::kamada_kawai(GraphAdjacencyList.AdjacencyList, Width, Height, Strength, EnergyThreshold,
+			UseScalarKernels ? Nodesoup::EForceKernelPath::Scalar : Nodesoup::EForceKernelPath::Vector);
+	}
 
 	ApplyNewPositions(Cast<UObject>(&Interface), Nodes, NewPositions);
 
 	return true;
+}
+
+Heart::Layout::FAsyncLayoutFunction UHeartLayout_KamadaKawai::MakeAsyncLayout() const
+{
+	return [InWidth = Width, InHeight = Height, InStrength = Strength, InEnergyThreshold = EnergyThreshold,
+			Threshold = SparseStressThreshold, Pivots = SparseStressPivots, Iterations = SparseStressIterations,
+			KernelPath = UseScalarKernels ? Nodesoup::EForceKernelPath::Scalar : Nodesoup::EForceKernelPath::Vector]
+		(Heart::Layout::FAsyncLayoutContext& Context)
+		{
+			if (Context.Num() <= Threshold)
+			{
+				return Nodesoup::kamada_kawai(Context.GetAdjacencyList(), InWidth, InHeight, InStrength, InEnergyThreshold, KernelPath);
+			}
+
+			return Nodesoup::sparse_stress(Context.GetAdjacencyList(),
+				[&Context](const TConstArrayView<FVector2D> Frame, const int32 Iteration)
+				{
+					if (Context.IsCancelled())
+					{
+						return false;
+					}
+
+					if ((Iteration + 1) % AsyncFrameInterval == 0)
+					{
+						Context.PublishFrame(Frame);
+					}
+					return true;
+				},
+				InWidth, InHeight, Pivots, Iterations);
+		};
 }
\ No newline at end of file
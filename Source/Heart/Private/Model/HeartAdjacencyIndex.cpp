@@ -0,0 +1,233 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartAdjacencyIndex.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+
+namespace Heart::Graph
+{
+	// Don't bother compacting until at least this many edges have been abandoned.
+	static constexpr int32 MinAbandonedToCompact = 256;
+
+	void FAdjacencyIndex::Rebuild(const UHeartGraph* Graph)
+	{
+		Reset();
+
+		const FHeartNodeSlotMap& Slots = Graph->GetNodeSlots();
+		AddSlots(Slots.GetMaxIndex());
+
+		for (auto&& Node : Slots)
+		{
+			UpdateNode(Graph, Node);
+		}
+
+		Compact(Lists[0]);
+		Compact(Lists[1]);
+	}
+
+	void FAdjacencyIndex::UpdateNode(const UHeartGraph* Graph, const UHeartGraphNode* Node, FEdgeChanges* OutChanges)
+	{
+		const FHeartNodeIndex NodeIndex = Node->GetNodeIndex();
+		if (!NodeIndex.IsValid())
+		{
+			return;
+		}
+
+		AddSlots(NodeIndex.Index + 1);
+		Owners[NodeIndex.Index] = NodeIndex;
+
+		TArray<FHeartNodeIndex, TInlineAllocator<16>> Neighbors[2];
+
+		for (const FHeartNodePin& Pin : Node->PinData.Pins)
+		{
+			const bool IsInput = EnumHasAnyFlags(Pin.Desc->Direction, EHeartPinDirection::Input);
+			const bool IsOutput = EnumHasAnyFlags(Pin.Desc->Direction, EHeartPinDirection::Output);
+
+			for (const FHeartGraphPinReference& Link : Pin.Connections)
+			{
+				const UHeartGraphNode* Other = Graph->GetNode(Link.NodeGuid);
+				if (!Other || !Other->GetNodeIndex().IsValid())
+				{
+					continue;
+				}
+
+				if (IsInput) Neighbors[0].Add(Other->GetNodeIndex());
+				if (IsOutput) Neighbors[1].Add(Other->GetNodeIndex());
+			}
+		}
+
+		for (int32 List = 0; List < 2; ++List)
+		{
+			// Sort by slot, and collapse multiple links to the same node into one edge.
+			Algo::SortBy(Neighbors[List], &FHeartNodeIndex::Index);
+
+			TArray<FAdjacencyEdge, TInlineAllocator<16>> NewEdges;
+			for (const FHeartNodeIndex Neighbor : Neighbors[List])
+			{
+				if (!NewEdges.IsEmpty() && NewEdges.Last().Node == Neighbor)
+				{
+					NewEdges.Last().Links++;
+				}
+				else
+				{
+					NewEdges.Add({Neighbor, 1});
+				}
+			}
+
+			if (OutChanges && List == 1)
+			{
+				// Diff the old out-edges against the new ones. Both are sorted by slot.
+				const TConstArrayView<FAdjacencyEdge> OldEdges = GetOutEdges(NodeIndex);
+				int32 o = 0, n = 0;
+				while (o < OldEdges.Num() || n < NewEdges.Num())
+				{
+					if (n >= NewEdges.Num() || (o < OldEdges.Num() && OldEdges[o].Node.Index < NewEdges[n].Node.Index))
+					{
+						OutChanges->NumRemoved++;
+						o++;
+					}
+					else if (o >= OldEdges.Num() || NewEdges[n].Node.Index < OldEdges[o].Node.Index)
+					{
+						OutChanges->Added.Add({NodeIndex, NewEdges[n].Node});
+						n++;
+					}
+					else
+					{
+						if (OldEdges[o].Node != NewEdges[n].Node)
+						{
+							// Same slot, but a different node; the old one must have been removed.
+							OutChanges->NumRemoved++;
+							OutChanges->Added.Add({NodeIndex, NewEdges[n].Node});
+						}
+						o++;
+						n++;
+					}
+				}
+			}
+
+			WriteSegment(Lists[List], NodeIndex.Index, NewEdges);
+		}
+	}
+
+	void FAdjacencyIndex::RemoveNode(const FHeartNodeIndex Node)
+	{
+		if (!Owners.IsValidIndex(Node.Index) || Owners[Node.Index] != Node)
+		{
+			return;
+		}
+
+		for (FEdgeList& List : Lists)
+		{
+			FSegment& Segment = List.Segments[Node.Index];
+			List.NumEdges -= Segment.Num;
+			List.Abandoned += Segment.Capacity;
+			Segment = FSegment();
+		}
+
+		Owners[Node.Index] = FHeartNodeIndex();
+	}
+
+	void FAdjacencyIndex::Reset()
+	{
+		Owners.Reset();
+		for (FEdgeList& List : Lists)
+		{
+			List = FEdgeList();
+		}
+	}
+
+	void FAdjacencyIndex::Reserve(const int32 MaxSlot)
+	{
+		Owners.Reserve(MaxSlot);
+		for (FEdgeList& List : Lists)
+		{
+			List.Segments.Reserve(MaxSlot);
+		}
+	}
+
+	TConstArrayView<FAdjacencyEdge> FAdjacencyIndex::GetEdges(const FHeartNodeIndex Node, const EHeartPinDirection Direction) const
+	{
+		if (!Owners.IsValidIndex(Node.Index) || Owners[Node.Index] != Node)
+		{
+			return {};
+		}
+
+		const FEdgeList& List = Lists[DirectionToList(Direction)];
+		const FSegment& Segment = List.Segments[Node.Index];
+		return TConstArrayView<FAdjacencyEdge>(List.Edges.GetData() + Segment.Offset, Segment.Num);
+	}
+
+	bool FAdjacencyIndex::HasEdge(const FHeartNodeIndex Node, const FHeartNodeIndex Neighbor, const EHeartPinDirection Direction) const
+	{
+		const TConstArrayView<FAdjacencyEdge> Edges = GetEdges(Node, Direction);
+		const int32 Found = Algo::LowerBoundBy(Edges, Neighbor.Index, [](const FAdjacencyEdge& Edge) { return Edge.Node.Index; });
+		return Edges.IsValidIndex(Found) && Edges[Found].Node == Neighbor;
+	}
+
+	int32 FAdjacencyIndex::NumEdges(const EHeartPinDirection Direction) const
+	{
+		return Lists[DirectionToList(Direction)].NumEdges;
+	}
+
+	int32 FAdjacencyIndex::DirectionToList(const EHeartPinDirection Direction)
+	{
+		checkf(Direction == EHeartPinDirection::Input || Direction == EHeartPinDirection::Output,
+			TEXT("Adjacency edges can only be retrieved for a single direction"));
+		return Direction == EHeartPinDirection::Input ? 0 : 1;
+	}
+
+	void FAdjacencyIndex::AddSlots(const int32 MaxSlot)
+	{
+		if (Owners.Num() < MaxSlot)
+		{
+			Owners.SetNum(MaxSlot);
+			for (FEdgeList& List : Lists)
+			{
+				List.Segments.SetNum(MaxSlot);
+			}
+		}
+	}
+
+	void FAdjacencyIndex::WriteSegment(FEdgeList& List, const int32 Slot, const TConstArrayView<FAdjacencyEdge> NewEdges)
+	{
+		FSegment& Segment = List.Segments[Slot];
+
+		if (NewEdges.Num() > Segment.Capacity)
+		{
+			// Abandon the old segment, and move to the end of the edge array, with some room to grow.
+			List.Abandoned += Segment.Capacity;
+			Segment.Offset = List.Edges.Num();
+			Segment.Capacity = NewEdges.Num() + NewEdges.Num() / 2 + 1;
+			List.Edges.AddDefaulted(Segment.Capacity);
+		}
+
+		FMemory::Memcpy(List.Edges.GetData() + Segment.Offset, NewEdges.GetData(), NewEdges.Num() * sizeof(FAdjacencyEdge));
+		List.NumEdges += NewEdges.Num() - Segment.Num;
+		Segment.Num = NewEdges.Num();
+
+		if (List.Abandoned > MinAbandonedToCompact &&
+			List.Abandoned > List.Edges.Num() / 2)
+		{
+			Compact(List);
+		}
+	}
+
+	void FAdjacencyIndex::Compact(FEdgeList& List)
+	{
+		TArray<FAdjacencyEdge> Compacted;
+		Compacted.Reserve(List.NumEdges);
+
+		for (FSegment& Segment : List.Segments)
+		{
+			const int32 NewOffset = Compacted.Num();
+			Compacted.Append(List.Edges.GetData() + Segment.Offset, Segment.Num);
+			Segment.Offset = NewOffset;
+			Segment.Capacity = Segment.Num;
+		}
+
+		List.Edges = MoveTemp(Compacted);
+		List.Abandoned = 0;
+	}
+}
@@ -0,0 +1,93 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartAlgorithmGraph.h"
+#include "Model/HeartGraph.h"
+
+namespace Heart::Graph
+{
+	FAlgorithmGraph::FAlgorithmGraph(const UHeartGraph* Graph, const EHeartPinDirection Direction)
+	  : Graph(Graph)
+	{
+		check(Graph);
+
+		const FAdjacencyIndex& Adjacency = Graph->GetAdjacency();
+		const int32 MaxSlot = Adjacency.GetMaxIndex();
+
+		SlotToVertex.Init(INDEX_NONE, MaxSlot);
+		Nodes.Reserve(Graph->GetNodes().Num());
+
+		for (int32 Slot = 0; Slot < MaxSlot; ++Slot)
+		{
+			const FHeartNodeIndex NodeIndex = Adjacency.GetNodeAt(Slot);
+			if (NodeIndex.IsValid() && Graph->IsValidNodeIndex(NodeIndex))
+			{
+				SlotToVertex[Slot] = Nodes.Add(Graph->GetNodeGuidFromIndex(NodeIndex));
+			}
+		}
+
+		const bool Weighted = Direction == EHeartPinDirection::Input || Direction == EHeartPinDirection::Output;
+
+		Csr.Offsets.Reserve(Nodes.Num() + 1);
+		Csr.Offsets.Add(0);
+		Csr.Targets.Reserve(Adjacency.NumEdges(Weighted ? Direction : EHeartPinDirection::Output));
+
+		for (int32 Slot = 0; Slot < MaxSlot; ++Slot)
+		{
+			if (SlotToVertex[Slot] == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FHeartNodeIndex NodeIndex = Adjacency.GetNodeAt(Slot);
+
+			if (Weighted)
+			{
+				for (const FAdjacencyEdge& Edge : Adjacency.GetEdges(NodeIndex, Direction))
+				{
+					if (const int32 Vertex = SlotToVertex[Edge.Node.Index];
+						Vertex != INDEX_NONE)
+					{
+						Csr.Targets.Add(Vertex);
+						Csr.Weights.Add(Edge.Links);
+					}
+				}
+			}
+			else
+			{
+				Adjacency.ForEachNeighbor(NodeIndex, Direction,
+					[this](const FHeartNodeIndex Neighbor)
+					{
+						if (const int32 Vertex = SlotToVertex[Neighbor.Index];
+							Vertex != INDEX_NONE)
+						{
+							Csr.Targets.Add(Vertex);
+						}
+						return true;
+					});
+			}
+
+			Csr.Offsets.Add(Csr.Targets.Num());
+		}
+	}
+
+	int32 FAlgorithmGraph::FindVertex(const FHeartNodeGuid& Node) const
+	{
+		const FHeartNodeIndex NodeIndex = Graph->GetNodeIndex(Node);
+		if (!NodeIndex.IsValid() || !SlotToVertex.IsValidIndex(NodeIndex.Index))
+		{
+			return INDEX_NONE;
+		}
+		return SlotToVertex[NodeIndex.Index];
+	}
+
+	TArray<FHeartNodeGuid> FAlgorithmGraph::ToNodes(const TConstArrayView<int32> Vertices) const
+	{
+		TArray<FHeartNodeGuid> Out;
+		Out.Reserve(Vertices.Num());
+		for (const int32 Vertex : Vertices)
+		{
+			Out.Add(Nodes[Vertex]);
+		}
+		return Out;
+	}
+}
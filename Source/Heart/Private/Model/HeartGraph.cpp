@@ -79,6 +79,12 @@ void UHeartGraph::PreSave(FObjectPreSaveContext SaveContext)
 		if (GetSchema()->FlushNodesForRuntime)
 		{
 			Nodes.Empty();
+			NodeSlots.Reset();
+			Adjacency.Reset();
+			TopologicalOrder.Reset();
+			NodeLookupIndex.Reset();
+			Reachability.Reset();
+			MarkChanged();
 		}
 	}
 #endif
@@ -91,6 +97,22 @@ void UHeartGraph::PostInitProperties()
 	{
 		Guid = FHeartGraphGuid::New();
 	}
+
+#if WITH_EDITOR
+	if (!IsTemplate())
+	{
+		ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddUObject(this, &ThisClass::OnObjectsReinstanced);
+	}
+#endif
+}
+
+void UHeartGraph::BeginDestroy()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+#endif
+
+	Super::BeginDestroy();
 }
 
 void UHeartGraph::PostLoad()
@@ -166,7 +188,11 @@ void UHeartGraph::PostLoad()
 			It.RemoveCurrent();
 		}
 	}
+#endif
 
+	RebuildIndexes();
+
+#if WITH_EDITOR
 	// Cannot do this without also running the presave action
 	/*
 	if (!IsTemplate())
@@ -191,13 +217,200 @@ void UHeartGraph::PostDuplicate(const EDuplicateMode::Type DuplicateMode)
 		if (GetSchema()->FlushNodesForRuntime)
 		{
 			Nodes.Empty();
+			NodeSlots.Reset();
 		}
 	}
 #endif
 
+	RebuildIndexes();
+
 	Super::PostDuplicate(DuplicateMode);
 }
 
+#if WITH_EDITOR
+void UHeartGraph::PostEditUndo()
+{
+	Super::PostEditUndo();
+	RebuildIndexes();
+}
+#endif
+
+void UHeartGraph::RebuildIndexes()
+{
+	MarkChanged();
+
+	NodeSlots.Rebuild(Nodes);
+	Adjacency.Rebuild(this);
+	TopologicalOrder.Rebuild(Adjacency);
+	NodeComponentIndex.Rebuild(NodeComponents);
+
+	// Rebuilt on demand
+	Reachability.Reset();
+
+	// Build it up front if the schema wants it, so that lookups from other threads don't find it missing.
+	if (NodeLookupIndex.IsBuilt())
+	{
+		NodeLookupIndex.Rebuild(this);
+	}
+	else if (!IsTemplate())
+	{
+		if (const UHeartGraphSchema* Schema = GetSchema();
+			IsValid(Schema) && Schema->GetUseNodeLookupIndex())
+		{
+			NodeLookupIndex.Rebuild(this);
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UHeartGraph::OnObjectsReinstanced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	NodeComponentIndex.ResetClassCache();
+
+	if (NodeLookupIndex.IsBuilt())
+	{
+		NodeLookupIndex.Rebuild(this);
+	}
+}
+#endif
+
+FHeartGraphSnapshotRef UHeartGraph::GetSnapshot() const
+{
+	if (!CachedSnapshot.IsValid() || CachedSnapshot->GetVersion() != Version)
+	{
+		CachedSnapshot = FHeartGraphSnapshot::Create(this);
+	}
+	return CachedSnapshot.ToSharedRef();
+}
+
+const Heart::Graph::FNodeLookupIndex* UHeartGraph::GetNodeLookupIndex() const
+{
+	if (!NodeLookupIndex.IsBuilt())
+	{
+		// Building writes to the index, which isn't safe while other threads may be reading it.
+		if (!IsInGameThread())
+		{
+			return nullptr;
+		}
+
+		const UHeartGraphSchema* Schema = GetSchema();
+		if (!IsValid(Schema) || !Schema->GetUseNodeLookupIndex())
+		{
+			return nullptr;
+		}
+
+		NodeLookupIndex.Rebuild(this);
+	}
+
+	return &NodeLookupIndex;
+}
+
+const Heart::Graph::FReachabilityIndex* UHeartGraph::GetReachabilityIndex() const
+{
+	if (!Reachability.IsBuilt())
+	{
+		const UHeartGraphSchema* Schema = GetSchema();
+		if (!IsValid(Schema) || !Schema->GetUseReachabilityIndex())
+		{
+			return nullptr;
+		}
+
+		if (!TopologicalOrder.IsAcyclic(Adjacency))
+		{
+			return nullptr;
+		}
+
+		Reachability.Rebuild(Adjacency, TopologicalOrder);
+	}
+
+	return &Reachability;
+}
+
+bool UHeartGraph::IsNodeReachable(const FHeartNodeIndex From, const FHeartNodeIndex To) const
+{
+	if (const Heart::Graph::FReachabilityIndex* Index = GetReachabilityIndex())
+	{
+		return Index->IsReachable(Adjacency, From, To);
+	}
+
+	if (!IsValidNodeIndex(From) || !IsValidNodeIndex(To))
+	{
+		return false;
+	}
+
+	TBitArray<> Reachable;
+	GetReachableNodes(From, Reachable);
+	return Reachable.IsValidIndex(To.Index) && Reachable[To.Index];
+}
+
+void UHeartGraph::GetReachableNodes(const FHeartNodeIndex From, TBitArray<>& OutSlots) const
+{
+	if (const Heart::Graph::FReachabilityIndex* Index = GetReachabilityIndex())
+	{
+		Index->GetReachable(Adjacency, From, OutSlots);
+		return;
+	}
+
+	OutSlots.Init(false, Adjacency.GetMaxIndex());
+	if (!IsValidNodeIndex(From))
+	{
+		return;
+	}
+
+	TArray<FHeartNodeIndex> Stack;
+	Stack.Add(From);
+
+	while (!Stack.IsEmpty())
+	{
+		const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+		for (const Heart::Graph::FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+		{
+			if (IsValidNodeIndex(Edge.Node) && !OutSlots[Edge.Node.Index])
+			{
+				OutSlots[Edge.Node.Index] = true;
+				Stack.Add(Edge.Node);
+			}
+		}
+	}
+}
+
+bool UHeartGraph::WouldEdgeCreateCycle(const FHeartNodeIndex From, const FHeartNodeIndex To) const
+{
+	return TopologicalOrder.WouldCreateCycle(Adjacency, From, To);
+}
+
+bool UHeartGraph::WouldConnectionCreateCycle(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB) const
+{
+	const UHeartGraphNode* NodeA = GetNode(PinA.NodeGuid);
+	const UHeartGraphNode* NodeB = GetNode(PinB.NodeGuid);
+	if (!IsValid(NodeA) || !IsValid(NodeB))
+	{
+		return false;
+	}
+
+	const TConstStructView<FHeartGraphPinDesc> DescA = NodeA->ViewPin(PinA.PinGuid);
+	const TConstStructView<FHeartGraphPinDesc> DescB = NodeB->ViewPin(PinB.PinGuid);
+	if (!DescA.IsValid() || !DescB.IsValid())
+	{
+		return false;
+	}
+
+	// A connection adds an edge away from each side that is an output.
+	if (EnumHasAnyFlags(DescA.Get().Direction, EHeartPinDirection::Output) &&
+		WouldEdgeCreateCycle(NodeA->GetNodeIndex(), NodeB->GetNodeIndex()))
+	{
+		return true;
+	}
+
+	if (EnumHasAnyFlags(DescB.Get().Direction, EHeartPinDirection::Output) &&
+		WouldEdgeCreateCycle(NodeB->GetNodeIndex(), NodeA->GetNodeIndex()))
+	{
+		return true;
+	}
+
+	return false;
+}
+
 FVector2D UHeartGraph::GetNodeLocation(const FHeartNodeGuid& Node) const
 {
 	if (const UHeartGraphNode* GraphNode = GetNode(Node))
@@ -248,7 +461,7 @@ void UHeartGraph::NotifyNodeLocationChanged(const FHeartNodeGuid& AffectedNode,
 	FHeartNodeMoveEvent Event;
 	Event.AffectedNodes.Add(AffectedNode);
 	Event.MoveFinished = !InProgress;
-	HandleNodeMoveEvent(Event);
+	DispatchNodeMoveEvent(Event);
 }
 
 void UHeartGraph::NotifyNodeLocationsChanged(const TSet<FHeartNodeGuid>& AffectedNodes, const bool InProgress)
@@ -264,16 +477,31 @@ void UHeartGraph::NotifyNodeLocationsChanged(const TSet<FHeartNodeGuid>& Affecte
 		}
 	}
 	Event.MoveFinished = !InProgress;
-	HandleNodeMoveEvent(Event);
+	DispatchNodeMoveEvent(Event);
 }
 
 void UHeartGraph::ForEachNode(const TFunctionRef<bool(const TPair<FHeartNodeGuid, UHeartGraphNode*>&)>& Iter) const
 {
-	for (auto&& Element : Nodes)
+	if (!AreNodeSlotsInSync())
 	{
-		if (ensure(Element.Value))
+		for (auto&& Node : Nodes)
 		{
-			if (!Iter(Element))
+			if (Node.Value)
+			{
+				if (!Iter(TPair<FHeartNodeGuid, UHeartGraphNode*>(Node.Key, Node.Value)))
+				{
+					break;
+				}
+			}
+		}
+		return;
+	}
+
+	for (auto&& Node : NodeSlots)
+	{
+		if (ensure(Node))
+		{
+			if (!Iter(TPair<FHeartNodeGuid, UHeartGraphNode*>(Node->GetGuid(), Node)))
 			{
 				break;
 			}
@@ -313,20 +541,212 @@ void UHeartGraph::HandleGraphConnectionEvent(const FHeartGraphConnectionEvent& E
 	OnNodeConnectionsChanged.Broadcast(Event);
 }
 
-FHeartNodeIndex UHeartGraph::GetNodeIndex(const FHeartNodeGuid& Node) const
+void UHeartGraph::HandleGraphChangeSet(const FHeartGraphChangeSet& ChangeSet)
 {
-	const FSetElementId NodeID = Nodes.FindId(Node);
-	return FHeartNodeIndex(NodeID.AsInteger());
+	OnGraphChanged.Broadcast(ChangeSet);
 }
 
-FHeartNodeGuid UHeartGraph::GetNodeGuidFromIndex(const FHeartNodeIndex NodeIndex) const
+bool UHeartGraph::DeferNodeLocationChanged(const FHeartNodeGuid& Node)
 {
-	FSetElementId NodeID = FSetElementId::FromInteger(NodeIndex.Index);
-	if (Nodes.IsValidId(NodeID))
+	// Every location change passes through here, transaction or not.
+	MarkMoved();
+
+	if (!IsInTransaction())
 	{
-		return Nodes.Get(NodeID).Key;
+		return false;
+	}
+
+	PendingLocationBroadcasts.Add(Node);
+	return true;
+}
+
+void UHeartGraph::DispatchNodeAddOrRemoveEvent(const FHeartNodeAddOrRemoveEvent& Event)
+{
+	MarkChanged();
+
+	if (!IsInTransaction())
+	{
+		HandleNodeAddOrRemoveEvent(Event);
+		return;
+	}
+
+	switch (Event.Type)
+	{
+	case EHeartNodeAddOrRemoveEventType::Add:
+		PendingChanges.RecordNodesAdded(Event.Nodes);
+		break;
+	case EHeartNodeAddOrRemoveEventType::Remove:
+		PendingChanges.RecordNodesRemoved(Event.Nodes);
+		for (auto&& Node : Event.Nodes)
+		{
+			PendingLocationBroadcasts.Remove(Node);
+		}
+		break;
 	}
-	return FHeartNodeGuid();
+}
+
+void UHeartGraph::DispatchNodeMoveEvent(const FHeartNodeMoveEvent& Event)
+{
+	MarkMoved();
+
+	if (!IsInTransaction())
+	{
+		HandleNodeMoveEvent(Event);
+		return;
+	}
+
+	PendingChanges.RecordNodesMoved(Event.AffectedNodes, Event.MoveFinished);
+}
+
+void UHeartGraph::DispatchGraphConnectionEvent(const FHeartGraphConnectionEvent& Event)
+{
+	MarkChanged();
+
+	if (!IsInTransaction())
+	{
+		HandleGraphConnectionEvent(Event);
+		return;
+	}
+
+	TArray<FHeartNodeGuid, TInlineAllocator<4>> AffectedNodes;
+	for (const UHeartGraphNode* Node : Event.AffectedNodes)
+	{
+		if (IsValid(Node))
+		{
+			AffectedNodes.Add(Node->GetGuid());
+		}
+	}
+	PendingChanges.RecordConnectionsChanged(AffectedNodes, Event.AffectedPinReferences);
+}
+
+void UHeartGraph::DispatchNodeComponentEvent(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component,
+											 const Heart::Events::EComponentEventType Type)
+{
+	MarkChanged();
+
+	if (!IsInTransaction())
+	{
+		OnComponentAddOrRemove.Broadcast(Node, Component, Type);
+		return;
+	}
+
+	switch (Type)
+	{
+	case Heart::Events::Add:
+		PendingChanges.RecordComponentAdded(Node, Component);
+		break;
+	case Heart::Events::Remove:
+		PendingChanges.RecordComponentRemoved(Node, Component);
+		break;
+	}
+}
+
+void UHeartGraph::ReserveNodes(const int32 Number)
+{
+	Nodes.Reserve(Nodes.Num() + Number);
+	NodeSlots.Reserve(NodeSlots.GetMaxIndex() + Number);
+	Adjacency.Reserve(NodeSlots.GetMaxIndex() + Number);
+	TopologicalOrder.Reserve(NodeSlots.GetMaxIndex() + Number);
+	NodeLookupIndex.Reserve(Number);
+}
+
+void UHeartGraph::FlushChangeSet()
+{
+	// Listeners may edit the graph in response, so take the pending state first.
+	const FHeartGraphChangeSet ChangeSet = MoveTemp(PendingChanges);
+	const TSet<FHeartNodeGuid> LocationBroadcasts = MoveTemp(PendingLocationBroadcasts);
+	PendingChanges.Reset();
+	PendingLocationBroadcasts.Reset();
+
+	if (ChangeSet.IsEmpty() && LocationBroadcasts.IsEmpty())
+	{
+		return;
+	}
+
+	// Replay one consolidated event per delegate, in the same order an unbatched edit would have sent them.
+	for (auto&& Change : ChangeSet.RemovedComponents)
+	{
+		OnComponentAddOrRemove.Broadcast(Change.Node, Change.Component, Heart::Events::Remove);
+	}
+
+	if (!ChangeSet.RemovedNodes.IsEmpty())
+	{
+		FHeartNodeAddOrRemoveEvent Event;
+		Event.Type = EHeartNodeAddOrRemoveEventType::Remove;
+		Event.Nodes = ChangeSet.RemovedNodes.Array();
+		HandleNodeAddOrRemoveEvent(Event);
+	}
+
+	if (!ChangeSet.AddedNodes.IsEmpty())
+	{
+		FHeartNodeAddOrRemoveEvent Event;
+		Event.Type = EHeartNodeAddOrRemoveEventType::Add;
+		Event.Nodes = ChangeSet.AddedNodes.Array();
+		HandleNodeAddOrRemoveEvent(Event);
+	}
+
+	for (auto&& Change : ChangeSet.AddedComponents)
+	{
+		OnComponentAddOrRemove.Broadcast(Change.Node, Change.Component, Heart::Events::Add);
+	}
+
+	if (!ChangeSet.ReconnectedNodes.IsEmpty())
+	{
+		FHeartGraphConnectionEvent Event;
+		for (auto&& Node : ChangeSet.ReconnectedNodes)
+		{
+			if (UHeartGraphNode* GraphNode = GetNode(Node))
+			{
+				Event.AffectedNodes.Add(GraphNode);
+			}
+		}
+		Event.AffectedPins = ChangeSet.AffectedPins;
+		Event.AffectedPinReferences = ChangeSet.AffectedPinReferences;
+		HandleGraphConnectionEvent(Event);
+	}
+
+	for (auto&& Node : LocationBroadcasts)
+	{
+		// Listeners learn the location of new nodes from the add event.
+		if (ChangeSet.AddedNodes.Contains(Node))
+		{
+			continue;
+		}
+
+		if (UHeartGraphNode* GraphNode = GetNode(Node))
+		{
+			const FVector2D Location = GetNodeLocationInterface()->GetNodeLocation(Node);
+			GraphNode->OnNodeLocationChanged_Native.Broadcast(Node, Location);
+			GraphNode->OnNodeLocationChanged.Broadcast(GraphNode, Location);
+		}
+	}
+
+	if (!ChangeSet.MovedNodes.IsEmpty())
+	{
+		FHeartNodeMoveEvent Event;
+		Event.AffectedNodes = ChangeSet.MovedNodes;
+		Event.MoveFinished = ChangeSet.MoveFinished;
+		HandleNodeMoveEvent(Event);
+	}
+
+	if (!ChangeSet.IsEmpty())
+	{
+		HandleGraphChangeSet(ChangeSet);
+	}
+}
+
+FHeartNodeIndex UHeartGraph::GetNodeIndex(const FHeartNodeGuid& Node) const
+{
+	if (const UHeartGraphNode* GraphNode = GetNode(Node))
+	{
+		return GraphNode->GetNodeIndex();
+	}
+	return FHeartNodeIndex();
+}
+
+FHeartNodeGuid UHeartGraph::GetNodeGuidFromIndex(const FHeartNodeIndex NodeIndex) const
+{
+	return NodeSlots.GetGuid(NodeIndex);
 }
 
 UHeartGraphNode* UHeartGraph::GetNode(const FHeartNodeGuid& NodeGuid) const
@@ -337,12 +757,46 @@ UHeartGraphNode* UHeartGraph::GetNode(const FHeartNodeGuid& NodeGuid) const
 
 void UHeartGraph::GetNodeGuids(TArray<FHeartNodeGuid>& OutGuids) const
 {
-	Nodes.GenerateKeyArray(OutGuids);
+	if (!AreNodeSlotsInSync())
+	{
+		OutGuids.Reset(Nodes.Num());
+		for (auto&& Node : Nodes)
+		{
+			if (Node.Value)
+			{
+				OutGuids.Add(Node.Key);
+			}
+		}
+		return;
+	}
+
+	OutGuids.Reset(NodeSlots.Num());
+	for (auto&& Node : NodeSlots)
+	{
+		OutGuids.Add(Node->GetGuid());
+	}
 }
 
 void UHeartGraph::GetNodeArray(TArray<UHeartGraphNode*>& OutNodes) const
 {
-	Nodes.GenerateValueArray(ObjectPtrWrap(OutNodes));
+	if (!AreNodeSlotsInSync())
+	{
+		OutNodes.Reset(Nodes.Num());
+		for (auto&& Node : Nodes)
+		{
+			if (Node.Value)
+			{
+				OutNodes.Add(Node.Value);
+			}
+		}
+		return;
+	}
+
+	OutNodes.Reset(NodeSlots.Num());
+	for (auto&& Node : NodeSlots)
+	{
+		OutNodes.Add(Node);
+	}
 }
 
 Heart::Query::FGraphNodeQuery UHeartGraph::QueryNodes() const
@@ -604,20 +1058,7 @@ TArray<UHeartGraphNodeComponent*> UHeartGraph::GetNodeComponentsForNode(const FH
 		return {};
 	}
 
-	TArray<UHeartGraphNodeComponent*> Out;
-
-	for (auto&& ClassMap : NodeComponents)
-	{
-		for (auto&& NodeComponent : ClassMap.Value.Components)
-		{
-			if (NodeComponent.Key == Node)
-			{
-				Out.Add(NodeComponent.Value);
-			}
-		}
-	}
-
-	return Out;
+	return TArray<UHeartGraphNodeComponent*>(NodeComponentIndex.GetComponentsForNode(Node));
 }
 
 TArray<UHeartGraphNodeComponent*> UHeartGraph::GetAllNodeComponentsOfClass(const TSubclassOf<UHeartGraphNodeComponent> Class) const
@@ -636,14 +1077,11 @@ TArray<UHeartGraphNodeComponent*> UHeartGraph::GetNodeComponentsWithInterface(co
 {
 	TArray<UHeartGraphNodeComponent*> Out;
 
-	for (auto&& ComponentSet : NodeComponents)
+	for (UHeartGraphNodeComponent* Component : NodeComponentIndex.GetComponentsForNode(Node))
 	{
-		if (ComponentSet.Key->ImplementsInterface(Interface))
+		if (NodeComponentIndex.ClassImplements(Component->GetClass(), Interface))
 		{
-			if (auto&& Component = ComponentSet.Value.Find(Node))
-			{
-				Out.Add(Component);
-			}
+			Out.Add(Component);
 		}
 	}
 
@@ -668,30 +1106,27 @@ UHeartGraphNodeComponent* UHeartGraph::FindOrAddNodeComponent(const FHeartNodeGu
 	}
 
 	// Create and assign a new component for the node.
-	UHeartGraphNodeComponent* NewComponent =
-		NodeMap.Components.Add(Node, NewObject<UHeartGraphNodeComponent>(this, Class));
+	UHeartGraphNodeComponent* NewComponent = NewObject<UHeartGraphNodeComponent>(this, Class);
 
 	// @todo isn't this redundant, and gets assigned in PostInitProperties?
 	NewComponent->Guid = FHeartExtensionGuid::New();
 
+	NodeMap.Components.Add(Node, NewComponent);
+	NodeComponentIndex.Add(Node, NewComponent);
+
 	NewComponent->PostComponentAdded();
 
-	OnComponentAddOrRemove.Broadcast(Node, NewComponent, Heart::Events::Add);
+	DispatchNodeComponentEvent(Node, NewComponent, Heart::Events::Add);
 
 	return NewComponent;
 }
 
 UHeartGraphNodeComponent* UHeartGraph::FindNodeComponentByGuid(const FHeartNodeGuid& Node, const FHeartExtensionGuid& ExtensionGuid) const
 {
-	for (auto&& Element : NodeComponents)
+	if (const Heart::Graph::FNodeComponentIndex::FGuidEntry* Entry = NodeComponentIndex.FindByGuid(ExtensionGuid);
+		Entry && Entry->Node == Node)
 	{
-		if (const TObjectPtr<UHeartGraphNodeComponent>& Component = Element.Value.Find(Node))
-		{
-			if (Component->GetGuid() == ExtensionGuid)
-			{
-				return Component;
-			}
-		}
+		return Entry->Component;
 	}
 	return nullptr;
 }
@@ -699,16 +1134,14 @@ UHeartGraphNodeComponent* UHeartGraph::FindNodeComponentByGuid(const FHeartNodeG
 void UHeartGraph::FindNodeComponentByGuid(const TSubclassOf<UHeartGraphNodeComponent>& Class, const FHeartExtensionGuid& ExtensionGuid, FHeartNodeGuid& OutNode,
 										  UHeartGraphNodeComponent*& OutNodeComponent) const
 {
+	// Only components owned under exactly Class, not its subclasses.
 	if (const FHeartGraphNodeComponentMap* NodeMap = NodeComponents.Find(Class))
 	{
-		for (auto&& Component : NodeMap->Components)
+		if (const Heart::Graph::FNodeComponentIndex::FGuidEntry* Entry = NodeComponentIndex.FindByGuid(ExtensionGuid);
+			Entry && NodeMap->Components.FindRef(Entry->Node) == Entry->Component)
 		{
-			if (Component.Value->GetGuid() == ExtensionGuid)
-			{
-				OutNode = Component.Key;
-				OutNodeComponent = Component.Value;
-				return;
-			}
+			OutNode = Entry->Node;
+			OutNodeComponent = Entry->Component;
 		}
 	}
 }
@@ -728,8 +1161,9 @@ bool UHeartGraph::RemoveNodeComponent(const FHeartNodeGuid& Node, const TSubclas
 		NodeMap->Components.RemoveAndCopyValue(Node, Component);
 		if (IsValid(Component))
 		{
+			NodeComponentIndex.Remove(Node, Component);
 			Component->PreComponentRemoved();
-			OnComponentAddOrRemove.Broadcast(Node, Component, Heart::Events::Add);
+			DispatchNodeComponentEvent(Node, Component, Heart::Events::Remove);
 			return true;
 		}
 	}
@@ -739,21 +1173,71 @@ bool UHeartGraph::RemoveNodeComponent(const FHeartNodeGuid& Node, const TSubclas
 
 void UHeartGraph::RemoveComponentsForNode(const FHeartNodeGuid& Node)
 {
-	for (auto&& NodeMap : NodeComponents)
+	for (const UHeartGraphNodeComponent* Component : NodeComponentIndex.RemoveNode(Node))
 	{
-		NodeMap.Value.Components.Remove(Node);
+		if (FHeartGraphNodeComponentMap* NodeMap = NodeComponents.Find(Component->GetClass()))
+		{
+			NodeMap->Components.Remove(Node);
+		}
 	}
 }
 
 void UHeartGraph::RemoveComponentsForNodes(const TConstArrayView<FHeartNodeGuid> InNodes)
 {
-	for (auto&& NodeMap : NodeComponents)
+	for (auto&& Node : InNodes)
 	{
-		for (auto&& Node : InNodes)
+		RemoveComponentsForNode(Node);
+	}
+}
+
+void UHeartGraph::AddDefaultNodeComponents(const UHeartGraphNode* Node)
+{
+	for (auto&& Element : Node->GetDefaultComponents())
+	{
+		UHeartGraphNodeComponent* NewComponent = DuplicateObject(Element, this);
+
+		// The duplicate copies the template's guid, which would be shared by every node of this class.
+		NewComponent->Guid = FHeartExtensionGuid::New();
+
+		AddNodeComponent(Node->GetGuid(), NewComponent);
+	}
+}
+
+void UHeartGraph::AddDefaultNodeComponents(const TConstArrayView<UHeartGraphNode*> InNodes)
+{
+	TMap<UClass*, int32> NumByClass;
+	int32 NumComponents = 0;
+	for (const UHeartGraphNode* Node : InNodes)
+	{
+		for (auto&& Element : Node->GetDefaultComponents())
 		{
-			NodeMap.Value.Components.Remove(Node);
+			NumByClass.FindOrAdd(Element->GetClass())++;
+			NumComponents++;
 		}
 	}
+
+	if (NumComponents == 0)
+	{
+		return;
+	}
+
+	for (auto&& Element : NumByClass)
+	{
+		auto& Components = NodeComponents.FindOrAdd(Element.Key).Components;
+		Components.Reserve(Components.Num() + Element.Value);
+	}
+	NodeComponentIndex.Reserve(InNodes.Num(), NumComponents);
+
+	for (const UHeartGraphNode* Node : InNodes)
+	{
+		AddDefaultNodeComponents(Node);
+	}
+}
+
+void UHeartGraph::AddNodeComponent(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component)
+{
+	NodeComponents.FindOrAdd(Component->GetClass()).Components.Add(Node, Component);
+	NodeComponentIndex.Add(Node, Component);
 }
 
 FHeartPinGuid UHeartGraph::FindNodePin(const FHeartNodeGuid NodeGuid, FName PinName) const
@@ -0,0 +1,106 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartGraphChangeSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartGraphChangeSet)
+
+void FHeartGraphChangeSet::RecordNodesAdded(const TConstArrayView<FHeartNodeGuid> Nodes)
+{
+	AddedNodes.Append(Nodes);
+}
+
+void FHeartGraphChangeSet::RecordNodesRemoved(const TConstArrayView<FHeartNodeGuid> Nodes)
+{
+	bool RemovedPins = false;
+
+	for (const FHeartNodeGuid& Node : Nodes)
+	{
+		// Nobody was told about a node that was added during this transaction, so they don't need to hear about its removal either.
+		if (AddedNodes.Remove(Node) == 0)
+		{
+			RemovedNodes.Add(Node);
+		}
+
+		MovedNodes.Remove(Node);
+		ReconnectedNodes.Remove(Node);
+		AddedComponents.RemoveAll(
+			[&Node](const FHeartNodeComponentChange& Change)
+			{
+				return Change.Node == Node;
+			});
+
+		for (auto It = AffectedPinReferences.CreateIterator(); It; ++It)
+		{
+			if (It->NodeGuid == Node)
+			{
+				It.RemoveCurrent();
+				RemovedPins = true;
+			}
+		}
+	}
+
+	// Pin guids are only unique within a node, so the bare set is rebuilt from the references that remain.
+	if (RemovedPins)
+	{
+		AffectedPins.Reset();
+		for (const FHeartGraphPinReference& Pin : AffectedPinReferences)
+		{
+			AffectedPins.Add(Pin.PinGuid);
+		}
+	}
+}
+
+void FHeartGraphChangeSet::RecordNodesMoved(const TSet<FHeartNodeGuid>& Nodes, const bool Finished)
+{
+	MovedNodes.Append(Nodes);
+	MoveFinished |= Finished;
+}
+
+void FHeartGraphChangeSet::RecordConnectionsChanged(const TConstArrayView<FHeartNodeGuid> Nodes, const TSet<FHeartGraphPinReference>& Pins)
+{
+	ReconnectedNodes.Append(Nodes);
+	AffectedPinReferences.Append(Pins);
+	for (const FHeartGraphPinReference& Pin : Pins)
+	{
+		AffectedPins.Add(Pin.PinGuid);
+	}
+}
+
+void FHeartGraphChangeSet::RecordComponentAdded(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component)
+{
+	AddedComponents.AddUnique({Node, Component});
+}
+
+void FHeartGraphChangeSet::RecordComponentRemoved(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component)
+{
+	// Components added and removed in the same transaction cancel out.
+	if (AddedComponents.RemoveSingle({Node, Component}) == 0)
+	{
+		RemovedComponents.AddUnique({Node, Component});
+	}
+}
+
+bool FHeartGraphChangeSet::IsEmpty() const
+{
+	return AddedNodes.IsEmpty() &&
+		RemovedNodes.IsEmpty() &&
+		MovedNodes.IsEmpty() &&
+		ReconnectedNodes.IsEmpty() &&
+		AffectedPins.IsEmpty() &&
+		AffectedPinReferences.IsEmpty() &&
+		AddedComponents.IsEmpty() &&
+		RemovedComponents.IsEmpty();
+}
+
+void FHeartGraphChangeSet::Reset()
+{
+	AddedNodes.Reset();
+	RemovedNodes.Reset();
+	MovedNodes.Reset();
+	MoveFinished = false;
+	ReconnectedNodes.Reset();
+	AffectedPins.Reset();
+	AffectedPinReferences.Reset();
+	AddedComponents.Reset();
+	RemovedComponents.Reset();
+}
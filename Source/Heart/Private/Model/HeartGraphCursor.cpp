@@ -0,0 +1,112 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartGraphCursor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartGraphCursor)
+
+bool FHeartGraphCursor::IsValid(const UHeartGraph* Graph) const
+{
+	return ::IsValid(Graph) && Graph->IsValidNodeIndex(Node);
+}
+
+UHeartGraphNode* FHeartGraphCursor::GetNode(const UHeartGraph* Graph) const
+{
+	return ::IsValid(Graph) ? Graph->ResolveNode(Node) : nullptr;
+}
+
+int32 FHeartGraphCursor::NumBranches(const UHeartGraph* Graph) const
+{
+	int32 Num = 0;
+	ForEachBranch(Graph,
+		[&Num](int32, int32, const FHeartGraphPinReference&)
+		{
+			Num++;
+			return true;
+		});
+	return Num;
+}
+
+bool FHeartGraphCursor::Step(const UHeartGraph* Graph, const int32 Branch)
+{
+	FHeartGraphPinReference Target;
+	ForEachBranch(Graph,
+		[Branch, &Target](const int32 Index, int32, const FHeartGraphPinReference& Link)
+		{
+			if (Index == Branch)
+			{
+				Target = Link;
+				return false;
+			}
+			return true;
+		});
+
+	if (!Target.IsValid())
+	{
+		return false;
+	}
+
+	const UHeartGraphNode* Next = Graph->GetNode(Target.NodeGuid);
+	if (!::IsValid(Next))
+	{
+		return false;
+	}
+
+	Node = Next->GetNodeIndex();
+	EntryPin = Next->PinData.GetPinIndex(Target.PinGuid);
+	return true;
+}
+
+bool FHeartGraphCursor::Serialize(FArchive& Ar)
+{
+	Ar << Node.Index;
+	Ar << Node.Generation;
+	Ar << EntryPin;
+	return true;
+}
+
+int32 FHeartGraphCursorBatch::Add(const FHeartGraphCursor& Cursor)
+{
+	if (!FreeIds.IsEmpty())
+	{
+		const int32 Id = FreeIds.Pop(EAllowShrinking::No);
+		Cursors[Id] = Cursor;
+		Active[Id] = true;
+		return Id;
+	}
+
+	Active.Add(true);
+	return Cursors.Add(Cursor);
+}
+
+void FHeartGraphCursorBatch::Remove(const int32 Id)
+{
+	if (Active.IsValidIndex(Id) && Active[Id])
+	{
+		Active[Id] = false;
+		Cursors[Id] = FHeartGraphCursor();
+		FreeIds.Add(Id);
+	}
+}
+
+void FHeartGraphCursorBatch::Reset()
+{
+	Cursors.Reset();
+	Active.Reset();
+	FreeIds.Reset();
+}
+
+void FHeartGraphCursorBatch::Reserve(const int32 Number)
+{
+	Cursors.Reserve(Number);
+	Active.Reserve(Number);
+}
+
+FHeartGraphCursor* FHeartGraphCursorBatch::Find(const int32 Id)
+{
+	return Active.IsValidIndex(Id) && Active[Id] ? &Cursors[Id] : nullptr;
+}
+
+const FHeartGraphCursor* FHeartGraphCursorBatch::Find(const int32 Id) const
+{
+	return Active.IsValidIndex(Id) && Active[Id] ? &Cursors[Id] : nullptr;
+}
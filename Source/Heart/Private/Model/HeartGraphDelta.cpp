@@ -0,0 +1,192 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartGraphDelta.h"
+#include "Model/HeartGraphSnapshot.h"
+#include "Algo/Sort.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartGraphDelta)
+
+namespace Heart::Graph
+{
+	static bool PinLess(const FHeartGraphPinReference& Lhs, const FHeartGraphPinReference& Rhs)
+	{
+		if (Lhs.NodeGuid != Rhs.NodeGuid)
+		{
+			return Lhs.NodeGuid < Rhs.NodeGuid;
+		}
+		return Lhs.PinGuid < Rhs.PinGuid;
+	}
+
+	/**
+	 * Walk two sorted ranges together. OnlyA and OnlyB are called for elements in just one range, Both for elements in
+	 * both.
+	 */
+	template <typename T, typename LessType, typename OnlyAType, typename OnlyBType, typename BothType>
+	static void MergeSorted(const TConstArrayView<T> A, const TConstArrayView<T> B, LessType Less,
+							OnlyAType&& OnlyA, OnlyBType&& OnlyB, BothType&& Both)
+	{
+		int32 i = 0, j = 0;
+		while (i < A.Num() || j < B.Num())
+		{
+			if (j >= B.Num() || (i < A.Num() && Less(A[i], B[j])))
+			{
+				OnlyA(A[i++]);
+			}
+			else if (i >= A.Num() || Less(B[j], A[i]))
+			{
+				OnlyB(B[j++]);
+			}
+			else
+			{
+				Both(A[i++], B[j++]);
+			}
+		}
+	}
+
+	// Connections are stored on both of their pins, so each is only recorded from its lesser end.
+	static void AddConnection(TArray<FHeartGraphConnection>& Out, const FHeartGraphPinReference& Self, const FHeartGraphPinReference& Link)
+	{
+		if (PinLess(Self, Link))
+		{
+			Out.Add({Self, Link});
+		}
+	}
+}
+
+FHeartGraphDelta FHeartGraphDelta::Compute(const FHeartGraphSnapshot& From, const FHeartGraphSnapshot& To)
+{
+	using namespace Heart::Graph;
+
+	FHeartGraphDelta Delta;
+
+	auto SortVertices = [](const FHeartGraphSnapshot& Snapshot)
+		{
+			TArray<int32> Vertices;
+			Vertices.SetNumUninitialized(Snapshot.NumNodes());
+			for (int32 i = 0; i < Vertices.Num(); ++i)
+			{
+				Vertices[i] = i;
+			}
+			Algo::Sort(Vertices, [&Snapshot](const int32 A, const int32 B) { return Snapshot.GetNode(A) < Snapshot.GetNode(B); });
+			return Vertices;
+		};
+
+	auto SortPins = [](const FHeartGraphSnapshot& Snapshot, const int32 Vertex, TArray<int32>& OutPins)
+		{
+			OutPins.Reset();
+			for (int32 Pin = Snapshot.GetPinBegin(Vertex); Pin < Snapshot.GetPinEnd(Vertex); ++Pin)
+			{
+				OutPins.Add(Pin);
+			}
+			Algo::Sort(OutPins, [&Snapshot](const int32 A, const int32 B) { return Snapshot.GetPinGuid(A) < Snapshot.GetPinGuid(B); });
+		};
+
+	auto AddAllLinks = [](const FHeartGraphSnapshot& Snapshot, const int32 Vertex, const int32 Pin, TArray<FHeartGraphConnection>& Out)
+		{
+			const FHeartGraphPinReference Self{Snapshot.GetNode(Vertex), Snapshot.GetPinGuid(Pin)};
+			for (const FHeartGraphPinReference& Link : Snapshot.GetPinLinks(Pin))
+			{
+				AddConnection(Out, Self, Link);
+			}
+		};
+
+	auto AddNodeLinks = [&AddAllLinks](const FHeartGraphSnapshot& Snapshot, const int32 Vertex, TArray<FHeartGraphConnection>& Out)
+		{
+			for (int32 Pin = Snapshot.GetPinBegin(Vertex); Pin < Snapshot.GetPinEnd(Vertex); ++Pin)
+			{
+				AddAllLinks(Snapshot, Vertex, Pin, Out);
+			}
+		};
+
+	const TArray<int32> FromVertices = SortVertices(From);
+	const TArray<int32> ToVertices = SortVertices(To);
+
+	// Scratch, reused for every node in both states
+	TArray<int32> FromPins;
+	TArray<int32> ToPins;
+	TArray<FHeartGraphPinReference> FromLinks;
+	TArray<FHeartGraphPinReference> ToLinks;
+
+	MergeSorted<int32>(FromVertices, ToVertices,
+		[&](const int32 A, const int32 B) { return From.GetNode(A) < To.GetNode(B); },
+		[&](const int32 Removed)
+		{
+			Delta.RemovedNodes.Add(From.GetNode(Removed));
+			AddNodeLinks(From, Removed, Delta.RemovedConnections);
+		},
+		[&](const int32 Added)
+		{
+			Delta.AddedNodes.Add(To.GetNode(Added));
+			AddNodeLinks(To, Added, Delta.AddedConnections);
+		},
+		[&](const int32 FromVertex, const int32 ToVertex)
+		{
+			const FHeartNodeGuid& Node = From.GetNode(FromVertex);
+
+			if (From.GetLocation(FromVertex) != To.GetLocation(ToVertex))
+			{
+				Delta.MovedNodes.Add(Node);
+			}
+
+			SortPins(From, FromVertex, FromPins);
+			SortPins(To, ToVertex, ToPins);
+
+			MergeSorted<int32>(FromPins, ToPins,
+				[&](const int32 A, const int32 B) { return From.GetPinGuid(A) < To.GetPinGuid(B); },
+				[&](const int32 Removed)
+				{
+					Delta.RemovedPins.Add({Node, From.GetPinGuid(Removed)});
+					AddAllLinks(From, FromVertex, Removed, Delta.RemovedConnections);
+				},
+				[&](const int32 Added)
+				{
+					Delta.AddedPins.Add({Node, To.GetPinGuid(Added)});
+					AddAllLinks(To, ToVertex, Added, Delta.AddedConnections);
+				},
+				[&](const int32 FromPin, const int32 ToPin)
+				{
+					const FHeartGraphPinReference Self{Node, From.GetPinGuid(FromPin)};
+
+					if (From.GetPinName(FromPin) != To.GetPinName(ToPin) ||
+						From.GetPinDirection(FromPin) != To.GetPinDirection(ToPin) ||
+						From.GetPinTag(FromPin) != To.GetPinTag(ToPin))
+					{
+						Delta.ChangedPins.Add(Self);
+					}
+
+					FromLinks.Reset();
+					FromLinks.Append(From.GetPinLinks(FromPin));
+					ToLinks.Reset();
+					ToLinks.Append(To.GetPinLinks(ToPin));
+					Algo::Sort(FromLinks, &PinLess);
+					Algo::Sort(ToLinks, &PinLess);
+
+					MergeSorted<FHeartGraphPinReference>(FromLinks, ToLinks, &PinLess,
+						[&](const FHeartGraphPinReference& Link) { AddConnection(Delta.RemovedConnections, Self, Link); },
+						[&](const FHeartGraphPinReference& Link) { AddConnection(Delta.AddedConnections, Self, Link); },
+						[](const FHeartGraphPinReference&, const FHeartGraphPinReference&) {});
+				});
+		});
+
+	// Connections were found in node order of either side, so put them in one order.
+	auto ConnectionLess = [](const FHeartGraphConnection& Lhs, const FHeartGraphConnection& Rhs)
+		{
+			return PinLess(Lhs.A, Rhs.A) || (Lhs.A == Rhs.A && PinLess(Lhs.B, Rhs.B));
+		};
+	Algo::Sort(Delta.AddedConnections, ConnectionLess);
+	Algo::Sort(Delta.RemovedConnections, ConnectionLess);
+
+	return Delta;
+}
+
+bool FHeartGraphDelta::IsEmpty() const
+{
+	return AddedNodes.IsEmpty()
+		&& RemovedNodes.IsEmpty()
+		&& MovedNodes.IsEmpty()
+		&& AddedConnections.IsEmpty()
+		&& RemovedConnections.IsEmpty()
+		&& AddedPins.IsEmpty()
+		&& RemovedPins.IsEmpty()
+		&& ChangedPins.IsEmpty();
+}
@@ -2,6 +2,7 @@
 
 #include "Model/HeartGraphNode.h"
 #include "Model/HeartGraph.h"
+#include "ModelView/HeartGraphSchema.h"
 #include "Engine/World.h"
 #include "PinProviders/HeartInstancedPinsComponent.h"
 
@@ -158,11 +159,11 @@ FHeartGraphPinReference UHeartGraphNode::GetPinReference(const FHeartPinGuid& Pi
 FHeartPinGuid UHeartGraphNode::GetPinByName(FName Name) const
 {
 	auto&& RetVal = PinData.Find(
-		[Name](const TPair<FHeartPinGuid, FHeartGraphPinDesc>& Desc) -> TOptional<FHeartPinGuid>
+		[Name](const FHeartNodePin& Pin) -> TOptional<FHeartPinGuid>
 		{
-			if (Desc.Value.Name == Name)
+			if (Pin.Desc->Name == Name)
 			{
-				return Desc.Key;
+				return Pin.Guid;
 			}
 			return NullOpt;
 		});
@@ -272,20 +273,45 @@ Heart::Query::FPinQueryResult UHeartGraphNode::FindPinsByDirection(EHeartPinDire
 }
 
 FHeartPinGuid UHeartGraphNode::AddPin(const FHeartGraphPinDesc& Desc)
+{
+	const FHeartPinGuid NewKey = AddPin_NoNotify(Desc);
+	if (NewKey.IsValid())
+	{
+		NotifyPinsRebuilt();
+	}
+	return NewKey;
+}
+
+FHeartPinGuid UHeartGraphNode::AddPin_NoNotify(const FHeartGraphPinDesc& Desc)
 {
 	if (!ensure(Desc.IsValid()))
 	{
 		return FHeartPinGuid();
 	}
 
-	const FHeartPinGuid NewKey = FHeartPinGuid::New();
+	const UHeartGraphSchema* Schema = GetGraph()->GetSchema();
+	const FHeartPinGuid NewKey = IsValid(Schema) && Schema->GetUseCompactPinIds() ?
+		PinData.MakeCompactPinGuid(Desc.Name) : FHeartPinGuid::New();
 
 	PinData.AddPin(NewKey, Desc);
+	return NewKey;
+}
+
+void UHeartGraphNode::NotifyPinsRebuilt()
+{
+	UHeartGraph* Graph = GetGraph();
+
+	// Nodes that aren't in the lookup index yet, like those of a batch being added, are skipped by it.
+	Graph->NodeLookupIndex.UpdatePins(this);
+
+	// A batch of new nodes marks the graph changed once every node is built.
+	if (!Graph->DeferPinUpdates)
+	{
+		Graph->MarkChanged();
+	}
 
 	OnNodePinsChanged_Native.Broadcast(Guid);
 	OnNodePinsChanged.Broadcast(this);
-
-	return NewKey;
 }
 
 bool UHeartGraphNode::RemovePin(const FHeartPinGuid& Pin)
@@ -295,8 +321,16 @@ bool UHeartGraphNode::RemovePin(const FHeartPinGuid& Pin)
 		return false;
 	}
 
+	// Break links from the other side as well, so the graph's adjacency stays in sync.
+	if (NodeIndex.IsValid() && PinData.HasConnections(Pin))
+	{
+		Heart::API::FPinEdit(GetGraph()).DisconnectAll({Guid, Pin});
+	}
+
 	if (PinData.RemovePin(Pin))
 	{
+		GetGraph()->NodeLookupIndex.UpdatePins(this);
+		GetGraph()->MarkChanged();
 		OnNodePinsChanged_Native.Broadcast(Guid);
 		OnNodePinsChanged.Broadcast(this);
 		return true;
@@ -339,11 +373,12 @@ bool UHeartGraphNode::ReconstructPins(const bool IsCreation)
 
 	if (IsCreation)
 	{
-		// Create all pins
+		// Create all pins, then index and notify for all of them at once.
 		for (auto&& Pin : GatheredPins)
 		{
-			AddPin(Pin);
+			AddPin_NoNotify(Pin);
 		}
+		NotifyPinsRebuilt();
 		return true;
 	}
 	else
@@ -351,16 +386,16 @@ bool UHeartGraphNode::ReconstructPins(const bool IsCreation)
 		TArray<FHeartPinGuid> DiscardedPins;
 
 		// Iterate over existing pins and remove the ones we already have from GatheredPins, or discard them
-		for (auto&& ExistingPin : PinData.PinDescriptions)
+		for (FHeartNodePin& ExistingPin : PinData.Pins)
 		{
 			bool Found = false;
 
 			for (auto It = GatheredPins.CreateIterator(); It; ++It)
 			{
 				auto&& GatheredPin = *It;
-				if (GatheredPin.Name == ExistingPin.Value.Name)
+				if (GatheredPin.Name == ExistingPin.Desc->Name)
 				{
-					ExistingPin.Value = GatheredPin; // Overwrite anyway, to update other info that may have changed.
+					ExistingPin.Desc = FHeartPinDescHandle(GatheredPin); // Overwrite anyway, to update other info that may have changed.
 					// @todo should we do anything about metadata?
 					It.RemoveCurrent();
 					Found = true;
@@ -371,7 +406,7 @@ bool UHeartGraphNode::ReconstructPins(const bool IsCreation)
 			if (!Found)
 			{
 				// A pin with this name was not gathered, remove it.
-				DiscardedPins.Add(ExistingPin.Key);
+				DiscardedPins.Add(ExistingPin.Guid);
 			}
 		}
 
@@ -382,7 +417,7 @@ bool UHeartGraphNode::ReconstructPins(const bool IsCreation)
 			// The remaining pins in Gathered do not exist, but should
 			for (auto&& GatheredPin : GatheredPins)
 			{
-				AddPin(GatheredPin);
+				AddPin_NoNotify(GatheredPin);
 			}
 
 			Modified |= true;
@@ -399,6 +434,9 @@ bool UHeartGraphNode::ReconstructPins(const bool IsCreation)
 			Modified |= true;
 		}
 
+		// Existing pins may have been given new tags above.
+		NotifyPinsRebuilt();
+
 		return Modified;
 	}
 }
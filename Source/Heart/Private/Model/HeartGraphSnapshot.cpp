@@ -0,0 +1,108 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartGraphSnapshot.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+
+FHeartGraphSnapshotRef FHeartGraphSnapshot::Create(const UHeartGraph* Graph)
+{
+	check(IsInGameThread());
+	check(Graph);
+
+	TSharedRef<FHeartGraphSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShareable(new FHeartGraphSnapshot());
+	FHeartGraphSnapshot& S = *Snapshot;
+
+	S.Version = Graph->GetVersion();
+	S.TopologyVersion = Graph->GetTopologyVersion();
+	S.GraphGuid = Graph->GetGuid();
+
+	const Heart::Graph::FAdjacencyIndex& Adjacency = Graph->GetAdjacency();
+	const IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
+	const int32 MaxSlot = Adjacency.GetMaxIndex();
+	const int32 NumNodes = Graph->GetNodes().Num();
+
+	// Number the live slots, so edges to later nodes can be written as vertices in the same pass.
+	TArray<int32> SlotToVertex;
+	SlotToVertex.Init(INDEX_NONE, MaxSlot);
+	int32 NumVertices = 0;
+	for (int32 Slot = 0; Slot < MaxSlot; ++Slot)
+	{
+		if (Graph->ResolveNode(Adjacency.GetNodeAt(Slot)))
+		{
+			SlotToVertex[Slot] = NumVertices++;
+		}
+	}
+
+	S.Nodes.Reserve(NumVertices);
+	S.NodeClassIds.Reserve(NumVertices);
+	S.Locations.Reserve(NumVertices);
+	S.PinOffsets.Reserve(NumVertices + 1);
+	S.VertexLookup.Reserve(NumVertices);
+	S.Topology.Offsets.Reserve(NumVertices + 1);
+	S.Topology.Targets.Reserve(Adjacency.NumEdges(EHeartPinDirection::Output));
+	S.Topology.Weights.Reserve(Adjacency.NumEdges(EHeartPinDirection::Output));
+
+	S.PinOffsets.Add(0);
+	S.LinkOffsets.Add(0);
+	S.Topology.Offsets.Add(0);
+
+	TMap<const UClass*, int32> ClassIds;
+
+	for (int32 Slot = 0; Slot < MaxSlot; ++Slot)
+	{
+		if (SlotToVertex[Slot] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FHeartNodeIndex NodeIndex = Adjacency.GetNodeAt(Slot);
+		const UHeartGraphNode* Node = Graph->ResolveNode(NodeIndex);
+		const FHeartNodeGuid& Guid = Node->GetGuid();
+
+		S.VertexLookup.Add(Guid, S.Nodes.Add(Guid));
+
+		const UClass* Class = Node->GetClass();
+		if (const int32* ClassId = ClassIds.Find(Class))
+		{
+			S.NodeClassIds.Add(*ClassId);
+		}
+		else
+		{
+			S.NodeClassIds.Add(ClassIds.Add(Class, S.Classes.Add(Class->GetClassPathName())));
+		}
+
+		S.Locations.Add(LocationInterface ? LocationInterface->GetNodeLocation(Guid) : FVector2D::ZeroVector);
+
+		for (const FHeartNodePin& Pin : Node->PinData.Pins)
+		{
+			S.PinGuids.Add(Pin.Guid);
+			S.PinNames.Add(Pin.Desc->Name);
+			S.PinDirections.Add(Pin.Desc->Direction);
+			S.PinTags.Add(Pin.Desc->Tag);
+			S.Links.Append(Pin.Connections.GetLinks());
+			S.LinkOffsets.Add(S.Links.Num());
+		}
+		S.PinOffsets.Add(S.PinGuids.Num());
+
+		for (const Heart::Graph::FAdjacencyEdge& Edge : Adjacency.GetOutEdges(NodeIndex))
+		{
+			if (const int32 Target = SlotToVertex[Edge.Node.Index];
+				Target != INDEX_NONE)
+			{
+				S.Topology.Targets.Add(Target);
+				S.Topology.Weights.Add(Edge.Links);
+			}
+		}
+		S.Topology.Offsets.Add(S.Topology.Targets.Num());
+	}
+
+	ensureMsgf(S.Nodes.Num() == NumNodes, TEXT("Graph '%s' has nodes missing from its slot storage"), *Graph->GetName());
+
+	return Snapshot;
+}
+
+int32 FHeartGraphSnapshot::FindVertex(const FHeartNodeGuid& Node) const
+{
+	const int32* Vertex = VertexLookup.Find(Node);
+	return Vertex ? *Vertex : INDEX_NONE;
+}
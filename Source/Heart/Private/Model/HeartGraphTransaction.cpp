@@ -0,0 +1,22 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartGraphTransaction.h"
+#include "Model/HeartGraph.h"
+
+namespace Heart::API
+{
+	FGraphTransaction::FGraphTransaction(const TNotNull<UHeartGraph*> Graph)
+	  : Graph(Graph)
+	{
+		Graph->TransactionDepth++;
+	}
+
+	FGraphTransaction::~FGraphTransaction()
+	{
+		check(Graph->TransactionDepth > 0);
+		if (--Graph->TransactionDepth == 0)
+		{
+			Graph->FlushChangeSet();
+		}
+	}
+}
@@ -35,20 +35,14 @@ namespace Heart::Utils
 	{
 		if (!IsValid(Class)) return nullptr;
 
-		UHeartGraphNode* OutNode = nullptr;
-
 		// Find the first node of the given class
-		Graph->ForEachNode(
-			[Class, &OutNode](const TPair<FHeartNodeGuid, UHeartGraphNode*>& Pair)
-			{
-				if (Pair.Value->IsA(Class))
-				{
-					OutNode = Pair.Value;
-				}
-				return IsValid(OutNode);
-			});
+		if (const TOptional<FHeartNodeGuid> Found = Graph->QueryNodes().Lazy().OfClass(Class).First();
+			Found.IsSet())
+		{
+			return Graph->GetNode(Found.GetValue());
+		}
 
-		return OutNode;
+		return nullptr;
 	}
 
 	UHeartGraphNode* FindNodeByPredicate(const UHeartGraph* Graph, const FFindNodePredicate& Predicate)
@@ -76,15 +70,11 @@ namespace Heart::Utils
 
 		TArray<UHeartGraphNode*> OutNodes;
 
-		// Find the first node of the given class
-		Graph->ForEachNode(
-			[Class, &OutNodes](const TPair<FHeartNodeGuid, UHeartGraphNode*>& Pair)
+		// Find all nodes of the given class
+		Graph->QueryNodes().OfClass(Class).ForEach(
+			[&OutNodes](UHeartGraphNode* Node)
 			{
-				if (Pair.Value->IsA(Class))
-				{
-					OutNodes.Add(Pair.Value);
-				}
-				return true;
+				OutNodes.Add(Node);
 			});
 
 		return OutNodes;
@@ -121,33 +111,49 @@ namespace Heart::Utils
 	{
 		if (!Node.IsValid()) return {};
 
-		TSet<FHeartNodeGuid> UniqueConnections;
 		const UHeartGraphNode* GraphNode = Graph->GetNode(Node);
 		if (!IsValid(GraphNode))
 		{
 			return {};
 		}
 
-		GraphNode->FindPinsByDirection(Direction)
-			.ForEach(
-			[&](const FHeartPinGuid PinGuid)
+		TArray<FHeartNodeGuid> Connections;
+		Graph->GetAdjacency().ForEachNeighbor(GraphNode->GetNodeIndex(), Direction,
+			[&](const FHeartNodeIndex Neighbor)
 			{
-				auto&& LinksView = GraphNode->ViewConnections(PinGuid);
-				if (!LinksView.IsValid())
-				{
-					return;
-				}
+				Connections.Add(Graph->GetNodeGuidFromIndex(Neighbor));
+				return true;
+			});
 
-				const TConstArrayView<FHeartGraphPinReference> LinksArrayView = LinksView.Get().GetLinks();
-				UniqueConnections.Reserve(LinksArrayView.Num());
+		return Connections;
+	}
 
-				for (auto&& Link : LinksArrayView)
-				{
-					UniqueConnections.Add(Link.NodeGuid);
-				}
-			});
+	bool IsNodeReachable(const UHeartGraph* Graph, const FHeartNodeGuid& From, const FHeartNodeGuid& To)
+	{
+		if (!IsValid(Graph))
+		{
+			return false;
+		}
 
-		return UniqueConnections.Array();
+		return Graph->IsNodeReachable(Graph->GetNodeIndex(From), Graph->GetNodeIndex(To));
+	}
+
+	TArray<FHeartNodeGuid> GetReachableNodes(const UHeartGraph* Graph, const FHeartNodeGuid& From)
+	{
+		if (!IsValid(Graph))
+		{
+			return {};
+		}
+
+		TBitArray<> Slots;
+		Graph->GetReachableNodes(Graph->GetNodeIndex(From), Slots);
+
+		TArray<FHeartNodeGuid> Nodes;
+		for (TConstSetBitIterator<> It(Slots); It; ++It)
+		{
+			Nodes.Add(Graph->GetNodeGuidFromIndex(Graph->GetAdjacency().GetNodeAt(It.GetIndex())));
+		}
+		return Nodes;
 	}
 
 	TConstStructView<FHeartGraphPinDesc> ResolvePinReference(const UHeartGraph* Graph, const FHeartGraphPinReference& Reference)
@@ -258,47 +264,28 @@ TArray<FHeartNodeGuid> UHeartGraphUtils::GetConnectedNodes(UHeartGraph* Graph, c
 
 bool UHeartGraphUtils::WouldConnectionCreateLoop(const UHeartGraphNode* A, const UHeartGraphNode* B)
 {
-	// This is based on the engine class FNodeVisitorCycleChecker found in both EdGraphSchema_BehaviorTree.cpp and ConversationGraphSchema.cpp
-
-	class FNodeVisitorCycleChecker
+	if (!IsValid(A) || !IsValid(B))
 	{
-	public:
-		/** Check whether a loop in the graph would be caused by linking the passed-in nodes */
-		bool CheckForLoop(const UHeartGraphNode* StartNode, const UHeartGraphNode* EndNode)
-		{
-			VisitedNodes.Add(EndNode->GetGuid());
-			return TraverseInputNodesToRoot(StartNode->GetGraph(), StartNode->GetGuid());
-		}
-
-	private:
-		/**
-		 * Helper function for CheckForLoop()
-		 * @param	Node	The node to start traversal at
-		 * @return true if we reached a root node (i.e. a node with no input pins), false if we encounter a node we have already seen
-		 */
-		bool TraverseInputNodesToRoot(const TNotNull<UHeartGraph*> Graph, const FHeartNodeGuid& Node)
-		{
-			VisitedNodes.Add(Node);
-
-			TArray<FHeartNodeGuid> LinkedNodes = Heart::Utils::GetConnectedNodes(
-				Graph, Node, EHeartPinDirection::Input);
+		return false;
+	}
 
-			for (auto&& LinkedNode : LinkedNodes)
-			{
-				if (VisitedNodes.Contains(LinkedNode))
-				{
-					return false;
-				}
-				return TraverseInputNodesToRoot(Graph, LinkedNode);
-			}
+	const UHeartGraph* Graph = A->GetGraph();
+	if (!IsValid(Graph) || Graph != B->GetGraph())
+	{
+		return false;
+	}
 
-			return true;
-		}
+	return Graph->WouldEdgeCreateCycle(A->GetNodeIndex(), B->GetNodeIndex());
+}
 
-		TSet<FHeartNodeGuid> VisitedNodes;
-	};
+bool UHeartGraphUtils::IsNodeReachable(const UHeartGraph* Graph, const FHeartNodeGuid& From, const FHeartNodeGuid& To)
+{
+	return Heart::Utils::IsNodeReachable(Graph, From, To);
+}
 
-	return !FNodeVisitorCycleChecker().CheckForLoop(A, B);
+TArray<FHeartNodeGuid> UHeartGraphUtils::GetReachableNodes(const UHeartGraph* Graph, const FHeartNodeGuid& Node)
+{
+	return Heart::Utils::GetReachableNodes(Graph, Node);
 }
 
 UHeartGraphExtension* UHeartGraphUtils::FindExtension(const TScriptInterface<IHeartGraphInterface>& Graph, const TSubclassOf<UHeartGraphExtension> Class)
@@ -374,6 +361,11 @@ void UHeartGraphUtils::BreakHeartActionRecord(const FHeartActionRecord& Record,
 	UndoData = Record.UndoData;
 }
 
+FHeartGraphPinDesc UHeartGraphUtils::BreakPinDescHandle(const FHeartPinDescHandle& Handle)
+{
+	return Handle.Get();
+}
+
 FHeartNodeSource UHeartGraphUtils::MakeNodeSourceFromClass(UClass* Class)
 {
 	return FHeartNodeSource(Class);
@@ -0,0 +1,401 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartLightweightNodes.h"
+#include "Location/HeartNodeLocationInterface.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+#include "Model/HeartGraphTransaction.h"
+#include "Model/HeartNodeEdit.h"
+#include "Model/HeartPinConnectionEdit.h"
+#include "ModelView/HeartGraphSchema.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartLightweightNodes)
+
+void UHeartLightweightNodeExtension::PostLoad()
+{
+	Super::PostLoad();
+	RebuildLookup();
+}
+
+void UHeartLightweightNodeExtension::PostDuplicate(const bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+	RebuildLookup();
+}
+
+FHeartNodeGuid UHeartLightweightNodeExtension::AddNode(const FHeartNodeArchetype& Archetype, const FInstancedStruct& State,
+													   const FVector2D& Location)
+{
+	if (!ensure(IsValid(Archetype.GraphNode)))
+	{
+		return FHeartNodeGuid();
+	}
+
+	const FHeartNodeGuid Guid = FHeartNodeGuid::New();
+
+	const int32 Row = Guids.Add(Guid);
+	ArchetypeIndices.Add(FindOrAddArchetype(Archetype));
+	States.Add(State);
+	Locations.Add(Location);
+	FHeartNodePinData& Pins = PinData.AddDefaulted_GetRef();
+	RowByGuid.Add(Guid, Row);
+
+	const UHeartGraphSchema* Schema = GetGraph()->GetSchema();
+	const bool UseCompactPinIds = IsValid(Schema) && Schema->GetUseCompactPinIds();
+
+	for (auto&& Desc : GetDefault<UHeartGraphNode>(Archetype.GraphNode)->GetDefaultPins())
+	{
+		if (ensure(Desc.IsValid()))
+		{
+			Pins.AddPin(UseCompactPinIds ? Pins.MakeCompactPinGuid(Desc.Name) : FHeartPinGuid::New(), Desc);
+		}
+	}
+
+	return Guid;
+}
+
+bool UHeartLightweightNodeExtension::RemoveNode(const FHeartNodeGuid& Node)
+{
+	const int32* Row = RowByGuid.Find(Node);
+	if (!Row)
+	{
+		return false;
+	}
+
+	for (const FHeartNodePin& Pin : PinData[*Row].Pins)
+	{
+		for (const TArray<FHeartGraphPinReference> Links(Pin.Connections.GetLinks());
+			 const FHeartGraphPinReference& Link : Links)
+		{
+			RemoveLink(Link, {Node, Pin.Guid});
+		}
+	}
+
+	RemoveRow(*Row);
+	return true;
+}
+
+void UHeartLightweightNodeExtension::Reserve(const int32 Number)
+{
+	Guids.Reserve(Guids.Num() + Number);
+	ArchetypeIndices.Reserve(ArchetypeIndices.Num() + Number);
+	States.Reserve(States.Num() + Number);
+	Locations.Reserve(Locations.Num() + Number);
+	PinData.Reserve(PinData.Num() + Number);
+	RowByGuid.Reserve(RowByGuid.Num() + Number);
+}
+
+void UHeartLightweightNodeExtension::ForEachNode(const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const
+{
+	for (const FHeartNodeGuid& Guid : Guids)
+	{
+		if (!Iter(Guid))
+		{
+			break;
+		}
+	}
+}
+
+const FHeartNodeArchetype* UHeartLightweightNodeExtension::FindArchetype(const FHeartNodeGuid& Node) const
+{
+	const int32* Row = RowByGuid.Find(Node);
+	return Row ? &Archetypes[ArchetypeIndices[*Row]] : nullptr;
+}
+
+const FInstancedStruct* UHeartLightweightNodeExtension::FindState(const FHeartNodeGuid& Node) const
+{
+	const int32* Row = RowByGuid.Find(Node);
+	return Row ? &States[*Row] : nullptr;
+}
+
+FInstancedStruct* UHeartLightweightNodeExtension::FindStateMutable(const FHeartNodeGuid& Node)
+{
+	const int32* Row = RowByGuid.Find(Node);
+	return Row ? &States[*Row] : nullptr;
+}
+
+FVector2D UHeartLightweightNodeExtension::GetNodeLocation(const FHeartNodeGuid& Node) const
+{
+	const int32* Row = RowByGuid.Find(Node);
+	return Row ? Locations[*Row] : FVector2D::ZeroVector;
+}
+
+void UHeartLightweightNodeExtension::SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location)
+{
+	if (const int32* Row = RowByGuid.Find(Node))
+	{
+		Locations[*Row] = Location;
+	}
+}
+
+Heart::Query::FPinQueryResult UHeartLightweightNodeExtension::QueryPins(const FHeartNodeGuid& Node) const
+{
+	static const FHeartNodePinData Empty;
+	const int32* Row = RowByGuid.Find(Node);
+	return Heart::Query::FPinQueryResult(Row ? PinData[*Row] : Empty);
+}
+
+TConstStructView<FHeartGraphPinDesc> UHeartLightweightNodeExtension::ViewPin(const FHeartNodeGuid& Node, const FHeartPinGuid& Pin) const
+{
+	if (const int32* Row = RowByGuid.Find(Node))
+	{
+		return PinData[*Row].ViewPin(Pin);
+	}
+	return TConstStructView<FHeartGraphPinDesc>();
+}
+
+TConstStructView<FHeartGraphPinConnections> UHeartLightweightNodeExtension::ViewConnections(const FHeartNodeGuid& Node,
+	const FHeartPinGuid& Pin) const
+{
+	if (const int32* Row = RowByGuid.Find(Node))
+	{
+		return PinData[*Row].ViewConnections(Pin);
+	}
+	return TConstStructView<FHeartGraphPinConnections>();
+}
+
+FHeartPinGuid UHeartLightweightNodeExtension::GetPinByName(const FHeartNodeGuid& Node, const FName Name) const
+{
+	const int32* Row = RowByGuid.Find(Node);
+	if (!Row)
+	{
+		return FHeartPinGuid();
+	}
+
+	auto&& RetVal = PinData[*Row].Find(
+		[Name](const FHeartNodePin& Pin) -> TOptional<FHeartPinGuid>
+		{
+			if (Pin.Desc->Name == Name)
+			{
+				return Pin.Guid;
+			}
+			return NullOpt;
+		});
+
+	if (RetVal.IsSet())
+	{
+		return RetVal.GetValue();
+	}
+
+	return FHeartPinGuid();
+}
+
+bool UHeartLightweightNodeExtension::Connect(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB)
+{
+	const int32* RowA = RowByGuid.Find(PinA.NodeGuid);
+	const int32* RowB = RowByGuid.Find(PinB.NodeGuid);
+	if (!RowA || !RowB)
+	{
+		return false;
+	}
+
+	if (!PinData[*RowA].Contains(PinA.PinGuid) ||
+		!PinData[*RowB].Contains(PinB.PinGuid))
+	{
+		return false;
+	}
+
+	PinData[*RowA].AddConnection(PinA.PinGuid, PinB);
+	PinData[*RowB].AddConnection(PinB.PinGuid, PinA);
+	return true;
+}
+
+bool UHeartLightweightNodeExtension::Disconnect(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB)
+{
+	const bool RemovedA = RemoveLink(PinA, PinB);
+	const bool RemovedB = RemoveLink(PinB, PinA);
+	return RemovedA || RemovedB;
+}
+
+UHeartGraphNode* UHeartLightweightNodeExtension::Promote(const FHeartNodeGuid& Node)
+{
+	const int32* RowPtr = RowByGuid.Find(Node);
+	if (!RowPtr)
+	{
+		return nullptr;
+	}
+
+	UHeartGraph* Graph = GetGraph();
+	if (!ensure(IsValid(Graph)))
+	{
+		return nullptr;
+	}
+
+	const int32 Row = *RowPtr;
+	const FHeartNodeArchetype& Archetype = Archetypes[ArchetypeIndices[Row]];
+
+	UHeartGraphNode* GraphNode;
+	if (const UClass* AsClass = Archetype.Source.As<UClass>())
+	{
+		GraphNode = Heart::API::FNodeCreator::CreateNode_Instanced(Graph, Archetype.GraphNode, AsClass);
+	}
+	else
+	{
+		GraphNode = Heart::API::FNodeCreator::CreateNode_Reference(Graph, Archetype.GraphNode, Archetype.Source.As<UObject>());
+	}
+
+	if (!ensure(IsValid(GraphNode)))
+	{
+		return nullptr;
+	}
+
+	GraphNode->Guid = Node;
+	InitializePromotedNode(GraphNode, States[Row]);
+
+	const FHeartNodePinData OldPins = PinData[Row];
+	const FVector2D Location = Locations[Row];
+
+	Heart::API::FGraphTransaction Transaction(Graph);
+
+	// Adding the node builds its pins anew, along with any provided by its components.
+	if (!Heart::API::FNodeEdit::AddNode(Graph, GraphNode))
+	{
+		// The graph never took the node, so nothing else refers to it.
+		GraphNode->MarkAsGarbage();
+		return nullptr;
+	}
+
+	// Only drop the row once the graph has the node, so a failed add doesn't lose it.
+	RemoveRow(Row);
+
+	Graph->GetNodeLocationInterface()->SetNodeLocation(Node, Location, false);
+
+	// Re-point links at the rebuilt pins, matching them by name.
+	Heart::API::FPinEdit Edit(Graph);
+	for (const FHeartNodePin& OldPin : OldPins.Pins)
+	{
+		const FHeartGraphPinReference OldRef{Node, OldPin.Guid};
+		const FHeartPinGuid NewPin = GraphNode->GetPinByName(OldPin.Desc->Name);
+
+		for (const FHeartGraphPinReference& Link : OldPin.Connections)
+		{
+			if (!NewPin.IsValid())
+			{
+				RemoveLink(Link, OldRef);
+				continue;
+			}
+
+			const FHeartGraphPinReference NewRef{Node, NewPin};
+
+			if (const int32* NeighborRow = RowByGuid.Find(Link.NodeGuid))
+			{
+				PinData[*NeighborRow].RemoveConnection(Link.PinGuid, OldRef);
+				PinData[*NeighborRow].AddConnection(Link.PinGuid, NewRef);
+				GraphNode->PinData.AddConnection(NewPin, Link);
+			}
+			else if (Graph->GetNode(Link.NodeGuid))
+			{
+				Edit.Disconnect(Link, OldRef);
+				Edit.Connect(Link, NewRef);
+			}
+		}
+	}
+
+	return GraphNode;
+}
+
+UHeartGraphNode* UHeartLightweightNodeExtension::GetOrPromote(const FHeartNodeGuid& Node)
+{
+	if (UHeartGraphNode* GraphNode = GetGraph()->GetNode(Node))
+	{
+		return GraphNode;
+	}
+	return Promote(Node);
+}
+
+void UHeartLightweightNodeExtension::InitializePromotedNode(UHeartGraphNode* GraphNode, const FInstancedStruct& State) const
+{
+	UObject* NodeObject = GraphNode->GetNodeObject();
+
+	// Only write into node objects the graph node owns, never a referenced asset.
+	if (!IsValid(NodeObject) || NodeObject->GetOuter() != GraphNode || !State.IsValid())
+	{
+		return;
+	}
+
+	for (TFieldIterator<FStructProperty> It(NodeObject->GetClass()); It; ++It)
+	{
+		if (It->Struct == State.GetScriptStruct())
+		{
+			It->Struct->CopyScriptStruct(It->ContainerPtrToValuePtr<void>(NodeObject), State.GetMemory());
+			return;
+		}
+	}
+}
+
+bool UHeartLightweightNodeExtension::CopyConnections(const FHeartNodeGuid& Node,
+													 TMap<FHeartPinGuid, FHeartGraphPinConnections>& OutConnections) const
+{
+	if (const int32* Row = RowByGuid.Find(Node))
+	{
+		OutConnections = PinData[*Row].CopyConnections();
+		return true;
+	}
+	return false;
+}
+
+bool UHeartLightweightNodeExtension::SetConnections(const FHeartNodeGuid& Node,
+													const TMap<FHeartPinGuid, FHeartGraphPinConnections>& Connections)
+{
+	if (const int32* Row = RowByGuid.Find(Node))
+	{
+		PinData[*Row].SetConnections(Connections);
+		return true;
+	}
+	return false;
+}
+
+int32 UHeartLightweightNodeExtension::FindOrAddArchetype(const FHeartNodeArchetype& Archetype)
+{
+	const int32 Existing = Archetypes.IndexOfByPredicate(
+		[&Archetype](const FHeartNodeArchetype& Other)
+		{
+			return Other.GraphNode == Archetype.GraphNode && Other.Source == Archetype.Source;
+		});
+
+	return Existing != INDEX_NONE ? Existing : Archetypes.Add(Archetype);
+}
+
+bool UHeartLightweightNodeExtension::RemoveLink(const FHeartGraphPinReference& From, const FHeartGraphPinReference& To)
+{
+	if (const int32* Row = RowByGuid.Find(From.NodeGuid))
+	{
+		return PinData[*Row].RemoveConnection(From.PinGuid, To);
+	}
+
+	if (UHeartGraph* Graph = GetGraph();
+		IsValid(Graph) && Graph->GetNode(From.NodeGuid))
+	{
+		Heart::API::FPinEdit(Graph).Disconnect(From, To);
+		return true;
+	}
+
+	return false;
+}
+
+void UHeartLightweightNodeExtension::RemoveRow(const int32 Row)
+{
+	RowByGuid.Remove(Guids[Row]);
+
+	Guids.RemoveAtSwap(Row, EAllowShrinking::No);
+	ArchetypeIndices.RemoveAtSwap(Row, EAllowShrinking::No);
+	States.RemoveAtSwap(Row, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Row, EAllowShrinking::No);
+	PinData.RemoveAtSwap(Row, EAllowShrinking::No);
+
+	// The last row was swapped into this one
+	if (Guids.IsValidIndex(Row))
+	{
+		RowByGuid.Add(Guids[Row], Row);
+	}
+}
+
+void UHeartLightweightNodeExtension::RebuildLookup()
+{
+	RowByGuid.Reset();
+	RowByGuid.Reserve(Guids.Num());
+	for (int32 Row = 0; Row < Guids.Num(); ++Row)
+	{
+		RowByGuid.Add(Guids[Row], Row);
+	}
+}
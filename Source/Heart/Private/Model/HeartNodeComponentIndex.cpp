@@ -0,0 +1,128 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartNodeComponentIndex.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNodeComponent.h"
+
+namespace Heart::Graph
+{
+	void FNodeComponentIndex::Rebuild(const FComponentMap& NodeComponents)
+	{
+		Reset();
+
+		for (auto&& ClassMap : NodeComponents)
+		{
+			for (auto&& Element : ClassMap.Value.Components)
+			{
+				if (IsValid(Element.Value))
+				{
+					Add(Element.Key, Element.Value);
+				}
+			}
+		}
+	}
+
+	void FNodeComponentIndex::Reset()
+	{
+		ByNode.Reset();
+		ByGuid.Reset();
+	}
+
+	void FNodeComponentIndex::Reserve(const int32 NumNodes, const int32 NumComponents)
+	{
+		ByNode.Reserve(ByNode.Num() + NumNodes);
+		ByGuid.Reserve(ByGuid.Num() + NumComponents);
+	}
+
+	void FNodeComponentIndex::Add(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component)
+	{
+		check(Component);
+		ByNode.FindOrAdd(Node).AddUnique(Component);
+
+		if (const FGuidEntry* Existing = ByGuid.Find(Component->GetGuid());
+			Existing && Existing->Component != Component)
+		{
+			UE_LOG(LogHeartGraph, Verbose, TEXT("Node component '%s' has the same guid as '%s'. Only one can be found by guid."),
+				*Component->GetName(), *GetNameSafe(Existing->Component));
+		}
+		ByGuid.Add(Component->GetGuid(), {Node, Component});
+	}
+
+	void FNodeComponentIndex::Remove(const FHeartNodeGuid& Node, const UHeartGraphNodeComponent* Component)
+	{
+		if (FNodeComponentList* List = ByNode.Find(Node))
+		{
+			List->RemoveSingle(const_cast<UHeartGraphNodeComponent*>(Component));
+			if (List->IsEmpty())
+			{
+				ByNode.Remove(Node);
+			}
+		}
+
+		if (const FGuidEntry* Entry = ByGuid.Find(Component->GetGuid());
+			Entry && Entry->Component == Component)
+		{
+			ByGuid.Remove(Component->GetGuid());
+		}
+	}
+
+	FNodeComponentIndex::FNodeComponentList FNodeComponentIndex::RemoveNode(const FHeartNodeGuid& Node)
+	{
+		FNodeComponentList Removed;
+		if (ByNode.RemoveAndCopyValue(Node, Removed))
+		{
+			for (const UHeartGraphNodeComponent* Component : Removed)
+			{
+				if (const FGuidEntry* Entry = ByGuid.Find(Component->GetGuid());
+					Entry && Entry->Component == Component)
+				{
+					ByGuid.Remove(Component->GetGuid());
+				}
+			}
+		}
+		return Removed;
+	}
+
+	TConstArrayView<UHeartGraphNodeComponent*> FNodeComponentIndex::GetComponentsForNode(const FHeartNodeGuid& Node) const
+	{
+		if (const FNodeComponentList* List = ByNode.Find(Node))
+		{
+			return *List;
+		}
+		return {};
+	}
+
+	const FNodeComponentIndex::FGuidEntry* FNodeComponentIndex::FindByGuid(const FHeartExtensionGuid& Guid) const
+	{
+		return ByGuid.Find(Guid);
+	}
+
+	bool FNodeComponentIndex::ClassImplements(const UClass* Class, const UClass* Interface) const
+	{
+		const FObjectKey ClassKey(Class);
+		const FObjectKey InterfaceKey(Interface);
+
+		{
+			FReadScopeLock ReadLock(InterfaceClassesLock);
+			if (const TMap<FObjectKey, bool>* Classes = InterfaceClasses.Find(InterfaceKey))
+			{
+				if (const bool* Cached = Classes->Find(ClassKey))
+				{
+					return *Cached;
+				}
+			}
+		}
+
+		const bool Implements = Class->ImplementsInterface(Interface);
+
+		FWriteScopeLock WriteLock(InterfaceClassesLock);
+		InterfaceClasses.FindOrAdd(InterfaceKey).Add(ClassKey, Implements);
+		return Implements;
+	}
+
+	void FNodeComponentIndex::ResetClassCache()
+	{
+		FWriteScopeLock WriteLock(InterfaceClassesLock);
+		InterfaceClasses.Reset();
+	}
+}
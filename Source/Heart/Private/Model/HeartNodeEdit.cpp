@@ -3,6 +3,7 @@
 #include "Model/HeartNodeEdit.h"
 #include "Model/HeartGraph.h"
 #include "Model/HeartGraphNode.h"
+#include "Model/HeartGraphTransaction.h"
 
 namespace Heart::API
 {
@@ -84,15 +85,17 @@ namespace Heart::API
 		}
 
 		Graph->Nodes.Add(NodeGuid, Node);
-		for (auto&& Element : Node->GetDefaultComponents())
-		{
-			Graph->NodeComponents.FindOrAdd(Element->GetClass()).Components.Add(NodeGuid, DuplicateObject(Element, Graph));
-		}
+		Graph->NodeSlots.Add(Node);
+		Graph->Adjacency.UpdateNode(Graph, Node);
+		Graph->TopologicalOrder.AddNode(Node->GetNodeIndex());
+		Graph->Reachability.AddNode(Node->GetNodeIndex());
+		Graph->AddDefaultNodeComponents(Node);
 		Node->OnAddedToGraph(Graph, NodeGuid);
+		Graph->NodeLookupIndex.AddNode(Node);
 		FHeartNodeAddOrRemoveEvent Event;
 		Event.Type = EHeartNodeAddOrRemoveEventType::Add;
 		Event.Nodes.Add(NodeGuid);
-		Graph->HandleNodeAddOrRemoveEvent(Event);
+		Graph->DispatchNodeAddOrRemoveEvent(Event);
 		return true;
 	}
 
@@ -108,6 +111,8 @@ namespace Heart::API
 			return false;
 		}
 
+		FGraphTransaction Transaction(Graph);
+
 		Graph->RemoveComponentsForNode(Node);
 
 		FPinEdit(Graph).DisconnectAll(Node);
@@ -116,12 +121,16 @@ namespace Heart::API
 		Graph->Nodes.RemoveAndCopyValue(Node, NodeBeingRemoved);
 		if (IsValid(NodeBeingRemoved))
 		{
+			Graph->Adjacency.RemoveNode(NodeBeingRemoved->GetNodeIndex());
+			Graph->TopologicalOrder.EdgesRemoved();
+			Graph->NodeLookupIndex.RemoveNode(NodeBeingRemoved->GetGuid());
+			Graph->NodeSlots.Remove(NodeBeingRemoved->GetNodeIndex());
 			NodeBeingRemoved->OnRemovedFromGraph(Graph, Node);
 
 			FHeartNodeAddOrRemoveEvent Event;
 			Event.Type = EHeartNodeAddOrRemoveEventType::Remove;
 			Event.Nodes.Add(Node);
-			Graph->HandleNodeAddOrRemoveEvent(Event);
+			Graph->DispatchNodeAddOrRemoveEvent(Event);
 			return true;
 		}
 
@@ -191,6 +200,9 @@ namespace Heart::API
 
 	void FNodeEdit::HandlePending()
 	{
+		// Deletes, their disconnections, and creates all reach listeners as one change set.
+		FGraphTransaction Transaction(Graph);
+
 		if (!PendingDeletes.IsEmpty())
 		{
 			// Pending delete pass 0: Verify and clean
@@ -229,11 +241,15 @@ namespace Heart::API
 					Graph->Nodes.RemoveAndCopyValue(PendingDelete, NodeBeingRemoved);
 					if (IsValid(NodeBeingRemoved))
 					{
+						Graph->Adjacency.RemoveNode(NodeBeingRemoved->GetNodeIndex());
+						Graph->TopologicalOrder.EdgesRemoved();
+						Graph->NodeLookupIndex.RemoveNode(NodeBeingRemoved->GetGuid());
+						Graph->NodeSlots.Remove(NodeBeingRemoved->GetNodeIndex());
 						NodeBeingRemoved->OnRemovedFromGraph(Graph, PendingDelete);
 					}
 				}
 
-				Graph->HandleNodeAddOrRemoveEvent(Event);
+				Graph->DispatchNodeAddOrRemoveEvent(Event);
 			}
 		}
 
@@ -244,7 +260,14 @@ namespace Heart::API
 
 			IHeartNodeLocationInterface* LocationInterface = Graph->GetNodeLocationInterface();
 
-			// Pending create pass
+			// Pending create pass 0: Size the graph for every node up front
+			Graph->ReserveNodes(PendingCreates.Num());
+
+			TArray<UHeartGraphNode*> AddedNodes;
+			AddedNodes.Reserve(PendingCreates.Num());
+			Event.Nodes.Reserve(PendingCreates.Num());
+
+			// Pending create pass 1: Insert nodes
 			for (auto&& Pending : PendingCreates)
 			{
 				if (!ensure(IsValid(Pending.Node->GetNodeObject())))
@@ -262,19 +285,35 @@ namespace Heart::API
 				}
 
 				Graph->Nodes.Add(NodeGuid, Pending.Node);
+				Graph->NodeSlots.Add(Pending.Node);
+				Graph->TopologicalOrder.AddNode(Pending.Node->GetNodeIndex());
+				Graph->Reachability.AddNode(Pending.Node->GetNodeIndex());
 
 				LocationInterface->SetNodeLocation(NodeGuid, Pending.Location, false);
 
-				for (auto&& Element : Pending.Node->GetDefaultComponents())
+				AddedNodes.Add(Pending.Node);
+				Event.Nodes.Add(NodeGuid);
+			}
+
+			// Pending create pass 2: Instance default components for all nodes at once
+			Graph->AddDefaultNodeComponents(AddedNodes);
+
+			// Pending create pass 3: Build pins, now that every component that may provide them exists. Each node is
+			// added to the lookup index with all of its pins, and the graph is marked changed once for the batch.
+			{
+				TGuardValue<bool> DeferGuard(Graph->DeferPinUpdates, true);
+
+				for (UHeartGraphNode* Node : AddedNodes)
 				{
-					Graph->NodeComponents.FindOrAdd(Element->GetClass()).Components.Add(NodeGuid, DuplicateObject(Element, Graph));
+					Node->OnAddedToGraph(Graph, Node->GetGuid());
+					Graph->Adjacency.UpdateNode(Graph, Node);
+					Graph->NodeLookupIndex.AddNode(Node);
 				}
-
-				Pending.Node->OnAddedToGraph(Graph, NodeGuid);
-				Event.Nodes.Add(NodeGuid);
 			}
 
-			Graph->HandleNodeAddOrRemoveEvent(Event);
+			Graph->MarkChanged();
+
+			Graph->DispatchNodeAddOrRemoveEvent(Event);
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartNodeLookupIndex.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+
+namespace Heart::Graph
+{
+	namespace
+	{
+		void GatherPinTags(const UHeartGraphNode* Node, TArray<FHeartGraphPinTag, TInlineAllocator<4>>& OutTags)
+		{
+			OutTags.Reset();
+			Node->QueryPins().ForEach(
+				[&OutTags](const FHeartGraphPinDesc& Desc)
+				{
+					if (Desc.Tag.IsValid())
+					{
+						OutTags.AddUnique(Desc.Tag);
+					}
+				});
+		}
+	}
+
+	void FNodeLookupIndex::FClassIndex::Add(const UClass* Class, const FHeartNodeGuid& Node)
+	{
+		if (!Class) return;
+
+		const FObjectKey ClassKey(Class);
+		FNodeSet* Set = ByClass.Find(ClassKey);
+		if (!Set)
+		{
+			// A class we haven't seen before may derive from any cached query class.
+			FWriteScopeLock WriteLock(DerivedLock);
+			Derived.Reset();
+			Set = &ByClass.Add(ClassKey);
+		}
+		Set->Add(Node);
+	}
+
+	void FNodeLookupIndex::FClassIndex::Remove(const FObjectKey& Class, const FHeartNodeGuid& Node)
+	{
+		if (FNodeSet* Set = ByClass.Find(Class))
+		{
+			Set->Remove(Node);
+			if (Set->IsEmpty())
+			{
+				ByClass.Remove(Class);
+
+				FWriteScopeLock WriteLock(DerivedLock);
+				Derived.Reset();
+			}
+		}
+	}
+
+	void FNodeLookupIndex::FClassIndex::Reset()
+	{
+		ByClass.Reset();
+
+		FWriteScopeLock WriteLock(DerivedLock);
+		Derived.Reset();
+	}
+
+	bool FNodeLookupIndex::FClassIndex::ForEach(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const
+	{
+		const FObjectKey ClassKey(Class);
+
+		TArray<FObjectKey> Classes;
+		bool Cached = false;
+		{
+			FReadScopeLock ReadLock(DerivedLock);
+			if (const TArray<FObjectKey>* Found = Derived.Find(ClassKey))
+			{
+				Classes = *Found;
+				Cached = true;
+			}
+		}
+
+		if (!Cached)
+		{
+			for (auto&& Element : ByClass)
+			{
+				// Classes that have been garbage collected no longer resolve, and are skipped.
+				if (const UClass* Indexed = Cast<UClass>(Element.Key.ResolveObjectPtr());
+					Indexed && Indexed->IsChildOf(Class))
+				{
+					Classes.Add(Element.Key);
+				}
+			}
+
+			FWriteScopeLock WriteLock(DerivedLock);
+			Derived.Add(ClassKey, Classes);
+		}
+
+		for (const FObjectKey& Subclass : Classes)
+		{
+			if (const FNodeSet* Set = ByClass.Find(Subclass))
+			{
+				for (const FHeartNodeGuid& Node : *Set)
+				{
+					if (!Iter(Node))
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void FNodeLookupIndex::Rebuild(const UHeartGraph* Graph)
+	{
+		Reset();
+		Built = true;
+
+		Reserve(Graph->GetNodes().Num());
+		for (auto&& Element : Graph->GetNodes())
+		{
+			if (IsValid(Element.Value))
+			{
+				AddNode(Element.Value);
+			}
+		}
+	}
+
+	void FNodeLookupIndex::Reset()
+	{
+		Entries.Reset();
+		NodeClasses.Reset();
+		ObjectClasses.Reset();
+		ByPinTag.Reset();
+		Built = false;
+	}
+
+	void FNodeLookupIndex::Reserve(const int32 NumNodes)
+	{
+		if (!Built) return;
+		Entries.Reserve(Entries.Num() + NumNodes);
+	}
+
+	void FNodeLookupIndex::AddNode(const UHeartGraphNode* Node)
+	{
+		if (!Built) return;
+
+		const FHeartNodeGuid& Guid = Node->GetGuid();
+		if (Entries.Contains(Guid))
+		{
+			RemoveNode(Guid);
+		}
+
+		const UClass* NodeClass = Node->GetClass();
+		const UClass* ObjectClass = IsValid(Node->GetNodeObject()) ? Node->GetNodeObject()->GetClass() : nullptr;
+
+		FNodeEntry& Entry = Entries.Add(Guid);
+		Entry.NodeClass = FObjectKey(NodeClass);
+		Entry.ObjectClass = FObjectKey(ObjectClass);
+		GatherPinTags(Node, Entry.PinTags);
+
+		NodeClasses.Add(NodeClass, Guid);
+		ObjectClasses.Add(ObjectClass, Guid);
+		AddPinTags(Guid, Entry.PinTags);
+	}
+
+	void FNodeLookupIndex::RemoveNode(const FHeartNodeGuid& Node)
+	{
+		if (!Built) return;
+
+		FNodeEntry Entry;
+		if (Entries.RemoveAndCopyValue(Node, Entry))
+		{
+			NodeClasses.Remove(Entry.NodeClass, Node);
+			ObjectClasses.Remove(Entry.ObjectClass, Node);
+			RemovePinTags(Node, Entry.PinTags);
+		}
+	}
+
+	void FNodeLookupIndex::UpdatePins(const UHeartGraphNode* Node)
+	{
+		if (!Built) return;
+
+		// Nodes still being added are indexed with all of their pins once they are in the graph.
+		FNodeEntry* Entry = Entries.Find(Node->GetGuid());
+		if (!Entry) return;
+
+		TArray<FHeartGraphPinTag, TInlineAllocator<4>> NewTags;
+		GatherPinTags(Node, NewTags);
+
+		RemovePinTags(Node->GetGuid(), Entry->PinTags.FilterByPredicate(
+			[&NewTags](const FHeartGraphPinTag& Tag) { return !NewTags.Contains(Tag); }));
+		AddPinTags(Node->GetGuid(), NewTags.FilterByPredicate(
+			[Entry](const FHeartGraphPinTag& Tag) { return !Entry->PinTags.Contains(Tag); }));
+
+		Entry->PinTags = MoveTemp(NewTags);
+	}
+
+	void FNodeLookupIndex::ForEachNodeOfClass(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const
+	{
+		if (Class)
+		{
+			NodeClasses.ForEach(Class, Iter);
+		}
+	}
+
+	void FNodeLookupIndex::ForEachNodeWithObjectClass(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const
+	{
+		if (Class)
+		{
+			ObjectClasses.ForEach(Class, Iter);
+		}
+	}
+
+	const FNodeLookupIndex::FNodeSet* FNodeLookupIndex::FindNodesWithPinTag(const FHeartGraphPinTag& Tag) const
+	{
+		return ByPinTag.Find(Tag);
+	}
+
+	void FNodeLookupIndex::AddPinTags(const FHeartNodeGuid& Node, const TConstArrayView<FHeartGraphPinTag> Tags)
+	{
+		for (const FHeartGraphPinTag& Tag : Tags)
+		{
+			ByPinTag.FindOrAdd(Tag).Add(Node);
+		}
+	}
+
+	void FNodeLookupIndex::RemovePinTags(const FHeartNodeGuid& Node, const TConstArrayView<FHeartGraphPinTag> Tags)
+	{
+		for (const FHeartGraphPinTag& Tag : Tags)
+		{
+			if (FNodeSet* Set = ByPinTag.Find(Tag))
+			{
+				Set->Remove(Node);
+				if (Set->IsEmpty())
+				{
+					ByPinTag.Remove(Tag);
+				}
+			}
+		}
+	}
+}
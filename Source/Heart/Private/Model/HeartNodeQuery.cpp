@@ -23,4 +23,65 @@ namespace Heart::Query
 	  : Reference(Src) {}
 
 	const FNodeMap& TNodeQueryResult<UHeartGraph>::SimpleData() const { return Reference->GetNodes(); }
+
+	TNodeQueryResult<UHeartGraph>& TNodeQueryResult<UHeartGraph>::OfClass(const UClass* Class)
+	{
+		if (const Graph::FNodeLookupIndex* Index = Reference->GetNodeLookupIndex())
+		{
+			FStorage Keys;
+			Index->ForEachNodeOfClass(Class,
+				[&Keys](const FHeartNodeGuid& Node)
+				{
+					Keys.Add(Node);
+					return true;
+				});
+			return Restrict(MoveTemp(Keys));
+		}
+
+		return Filter(
+			[Class](const UHeartGraphNode* Node)
+			{
+				return IsValid(Node) && Node->IsA(Class);
+			});
+	}
+
+	TNodeQueryResult<UHeartGraph>& TNodeQueryResult<UHeartGraph>::WithObjectClass(const UClass* Class)
+	{
+		if (const Graph::FNodeLookupIndex* Index = Reference->GetNodeLookupIndex())
+		{
+			FStorage Keys;
+			Index->ForEachNodeWithObjectClass(Class,
+				[&Keys](const FHeartNodeGuid& Node)
+				{
+					Keys.Add(Node);
+					return true;
+				});
+			return Restrict(MoveTemp(Keys));
+		}
+
+		return Filter(
+			[Class](const UHeartGraphNode* Node)
+			{
+				return IsValid(Node) && IsValid(Node->GetNodeObject()) && Node->GetNodeObject()->IsA(Class);
+			});
+	}
+
+	TNodeQueryResult<UHeartGraph>& TNodeQueryResult<UHeartGraph>::WithPinTag(const FHeartGraphPinTag& Tag)
+	{
+		if (const Graph::FNodeLookupIndex* Index = Reference->GetNodeLookupIndex())
+		{
+			const Graph::FNodeLookupIndex::FNodeSet* Nodes = Index->FindNodesWithPinTag(Tag);
+			return Restrict(Nodes ? Nodes->Array() : FStorage());
+		}
+
+		return Filter(
+			[Tag](const UHeartGraphNode* Node)
+			{
+				return IsValid(Node) && Node->QueryPins().Find(
+					[&Tag](const FHeartGraphPinDesc& Desc)
+					{
+						return Desc.Tag == Tag;
+					}).IsSet();
+			});
+	}
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartNodeSlotMap.h"
+#include "Model/HeartGraphNode.h"
+#include "Algo/Reverse.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartNodeSlotMap)
+
+FHeartNodeIndex FHeartNodeSlotMap::Add(UHeartGraphNode* Node)
+{
+	check(Node);
+
+	int32 Slot;
+	if (!FreeSlots.IsEmpty())
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = Slots.AddDefaulted();
+	}
+
+	FHeartNodeSlot& SlotData = Slots[Slot];
+	SlotData.Guid = Node->GetGuid();
+	SlotData.DenseIndex = DenseNodes.Add(Node);
+	DenseToSlot.Add(Slot);
+
+	Node->NodeIndex = FHeartNodeIndex(Slot, SlotData.Generation);
+	return Node->NodeIndex;
+}
+
+bool FHeartNodeSlotMap::Remove(const FHeartNodeIndex Index)
+{
+	if (!IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	FHeartNodeSlot& SlotData = Slots[Index.Index];
+	const int32 DenseIndex = SlotData.DenseIndex;
+
+	if (UHeartGraphNode* Node = DenseNodes[DenseIndex])
+	{
+		Node->NodeIndex = FHeartNodeIndex();
+	}
+
+	// Fill the hole in the dense arrays with the last node, and repoint its slot.
+	DenseNodes.RemoveAtSwap(DenseIndex, EAllowShrinking::No);
+	DenseToSlot.RemoveAtSwap(DenseIndex, EAllowShrinking::No);
+	if (DenseToSlot.IsValidIndex(DenseIndex))
+	{
+		Slots[DenseToSlot[DenseIndex]].DenseIndex = DenseIndex;
+	}
+
+	SlotData.Guid = FHeartNodeGuid();
+	SlotData.DenseIndex = INDEX_NONE;
+	SlotData.Generation++;
+	FreeSlots.Add(Index.Index);
+	return true;
+}
+
+void FHeartNodeSlotMap::Reserve(const int32 Number)
+{
+	Slots.Reserve(Number);
+	DenseNodes.Reserve(Number);
+	DenseToSlot.Reserve(Number);
+}
+
+void FHeartNodeSlotMap::Reset()
+{
+	for (auto&& Node : DenseNodes)
+	{
+		if (Node)
+		{
+			Node->NodeIndex = FHeartNodeIndex();
+		}
+	}
+
+	Slots.Reset();
+	DenseNodes.Reset();
+	DenseToSlot.Reset();
+	FreeSlots.Reset();
+}
+
+void FHeartNodeSlotMap::Rebuild(const TMap<FHeartNodeGuid, TObjectPtr<UHeartGraphNode>>& Nodes)
+{
+	DenseNodes.Reset(Nodes.Num());
+	DenseToSlot.Reset(Nodes.Num());
+	FreeSlots.Reset();
+
+	TSet<FHeartNodeGuid> Slotted;
+	Slotted.Reserve(Nodes.Num());
+
+	for (int32 Slot = 0; Slot < Slots.Num(); ++Slot)
+	{
+		FHeartNodeSlot& SlotData = Slots[Slot];
+		SlotData.DenseIndex = INDEX_NONE;
+
+		const TObjectPtr<UHeartGraphNode>* Node = SlotData.Guid.IsValid() ? Nodes.Find(SlotData.Guid) : nullptr;
+
+		bool AlreadySlotted = false;
+		if (Node && *Node)
+		{
+			Slotted.Add(SlotData.Guid, &AlreadySlotted);
+		}
+
+		if (!Node || !*Node || AlreadySlotted)
+		{
+			// The node for this slot is gone, or is a duplicate entry; free the slot.
+			if (SlotData.Guid.IsValid())
+			{
+				SlotData.Guid = FHeartNodeGuid();
+				SlotData.Generation++;
+			}
+			FreeSlots.Add(Slot);
+			continue;
+		}
+
+		SlotData.DenseIndex = DenseNodes.Add(*Node);
+		DenseToSlot.Add(Slot);
+		(*Node)->NodeIndex = FHeartNodeIndex(Slot, SlotData.Generation);
+	}
+
+	// Reuse low slots first
+	Algo::Reverse(FreeSlots);
+
+	// Graphs saved before nodes had slots, or nodes added directly to the map, are assigned one now. They are taken in
+	// guid order, so the same graph always gets the same slots, however the map was filled.
+	TArray<FHeartNodeGuid> Unslotted;
+	for (auto&& Element : Nodes)
+	{
+		if (Element.Value && !Slotted.Contains(Element.Key))
+		{
+			Unslotted.Add(Element.Key);
+		}
+	}
+
+	Unslotted.Sort();
+
+	for (const FHeartNodeGuid& Guid : Unslotted)
+	{
+		Add(Nodes[Guid]);
+	}
+}
@@ -3,6 +3,7 @@
 #include "Model/HeartPinConnectionEdit.h"
 #include "Model/HeartGraph.h"
 #include "Model/HeartGraphNode.h"
+#include "Model/HeartLightweightNodes.h"
 
 namespace Heart::API
 {
@@ -19,10 +20,41 @@ namespace Heart::API
 		{
 			Event.AffectedNodes.Add(Element.Key);
 			Event.AffectedPins.Add(Element.Value);
+			Event.AffectedPinReferences.Add({Element.Key->GetGuid(), Element.Value});
+		}
+
+		// Bring the graph's adjacency and order up to date before anyone is notified
+		Heart::Graph::FAdjacencyIndex::FEdgeChanges EdgeChanges;
+		for (const UHeartGraphNode* Node : Event.AffectedNodes)
+		{
+			Graph->Adjacency.UpdateNode(Graph, Node, &EdgeChanges);
+		}
+
+		if (EdgeChanges.NumRemoved > 0)
+		{
+			Graph->TopologicalOrder.EdgesRemoved();
+		}
+
+		if (!EdgeChanges.Added.IsEmpty())
+		{
+			Graph->TopologicalOrder.AddEdges(Graph->Adjacency, EdgeChanges.Added);
+		}
+
+		if (EdgeChanges.NumRemoved > 0)
+		{
+			Graph->Reachability.EdgesRemoved();
+		}
+		else if (!EdgeChanges.Added.IsEmpty())
+		{
+			Graph->Reachability.EdgesAdded(EdgeChanges.Added);
+		}
+
+		for (auto&& Element : ChangedPins)
+		{
 			Element.Key->NotifyPinConnectionsChanged(Element.Value);
 		}
 
-		Graph->HandleGraphConnectionEvent(Event);
+		Graph->DispatchGraphConnectionEvent(Event);
 	}
 
 	FPinEdit& FPinEdit::Connect(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB)
@@ -35,6 +67,12 @@ namespace Heart::API
 			return *this;
 		}
 
+		// Check both pins before linking either, so a missing pin can't leave a one-sided link.
+		if (!ensure(ANode->PinData.Contains(PinA.PinGuid) && BNode->PinData.Contains(PinB.PinGuid)))
+		{
+			return *this;
+		}
+
 		// Add to both lists
 		ANode->PinData.AddConnection(PinA.PinGuid, PinB);
 		BNode->PinData.AddConnection(PinB.PinGuid, PinA);
@@ -85,7 +123,7 @@ namespace Heart::API
 			return *this;
 		}
 
-		for (auto ConnectionsCopy = Node->PinData.PinConnections;
+		for (auto ConnectionsCopy = Node->PinData.CopyConnections();
 			 auto&& Element : ConnectionsCopy)
 		{
 			const FHeartGraphPinReference This = {NodeGuid, Element.Key};
@@ -107,7 +145,13 @@ namespace Heart::API
 			return *this;
 		}
 
-		ANode->PinData.GetConnectionsMutable(Pin.PinGuid) = Connections;
+		FHeartGraphPinConnections* PinConnections = ANode->PinData.FindConnectionsMutable(Pin.PinGuid);
+		if (!ensure(PinConnections))
+		{
+			return *this;
+		}
+
+		*PinConnections = Connections;
 
 		ChangedPins.Add(ANode, Pin.PinGuid);
 
@@ -123,7 +167,7 @@ namespace Heart::API
 		}
 
 		// Memento for self
-		OutMementos.Add(Pin.NodeGuid).PinConnections = Node->PinData.PinConnections;
+		OutMementos.Add(Pin.NodeGuid).PinConnections = Node->PinData.CopyConnections();
 
 		// Mementos for all connected pins
 		if (auto&& Connections = Node->PinData.ViewConnections(Pin.PinGuid);
@@ -131,7 +175,7 @@ namespace Heart::API
 		{
 			for (const FHeartGraphPinReference& Link : Connections.Get())
 			{
-				OutMementos.Add(Link.NodeGuid).PinConnections = Graph->GetNode(Link.NodeGuid)->PinData.PinConnections;
+				Internal_CreateMemento(Link.NodeGuid, OutMementos);
 			}
 		}
 
@@ -147,15 +191,14 @@ namespace Heart::API
 		}
 
 		// Memento for this pin
-		OutMementos.Add(NodeGuid).PinConnections = Node->PinData.PinConnections;
+		OutMementos.Add(NodeGuid).PinConnections = Node->PinData.CopyConnections();
 
-		for (auto&& Connections = Node->PinData.PinConnections;
-			 auto&& Element : Connections)
+		for (const FHeartNodePin& NodePin : Node->PinData.Pins)
 		{
 			// Mementos for all connected pins
-			for (const FHeartGraphPinReference& Link : Element.Value)
+			for (const FHeartGraphPinReference& Link : NodePin.Connections)
 			{
-				OutMementos.Add(Link.NodeGuid).PinConnections = Graph->GetNode(Link.NodeGuid)->PinData.PinConnections;
+				Internal_CreateMemento(Link.NodeGuid, OutMementos);
 			}
 		}
 
@@ -167,21 +210,27 @@ namespace Heart::API
 		for (auto&& PinAndMemento : Mementos)
 		{
 			UHeartGraphNode* ANode = Graph->GetNode(PinAndMemento.Key);
-			if (!ensure(IsValid(ANode)))
+			if (!IsValid(ANode))
 			{
-				return *this;
+				// Lightweight nodes aren't in the graph, and keep no pin events to fire.
+				UHeartLightweightNodeExtension* Lightweight = Graph->GetExtension<UHeartLightweightNodeExtension>();
+				ensure(IsValid(Lightweight) && Lightweight->SetConnections(PinAndMemento.Key, PinAndMemento.Value.PinConnections));
+				continue;
 			}
 
 			// Mark all pins as changed, we have no idea what the memento will remove.
-			for (auto&& Element : ANode->PinData.PinConnections)
+			for (const FHeartNodePin& NodePin : ANode->PinData.Pins)
 			{
-				ChangedPins.Add(ANode, Element.Key);
+				if (!NodePin.Connections.GetLinks().IsEmpty())
+				{
+					ChangedPins.Add(ANode, NodePin.Guid);
+				}
 			}
 
-			ANode->PinData.PinConnections = PinAndMemento.Value.PinConnections;
+			ANode->PinData.SetConnections(PinAndMemento.Value.PinConnections);
 
 			// Mark all pins as changed again, as we have no idea what the memento has restored.
-			for (auto&& Element : ANode->PinData.PinConnections)
+			for (auto&& Element : PinAndMemento.Value.PinConnections)
 			{
 				ChangedPins.Add(ANode, Element.Key);
 			}
@@ -207,5 +256,40 @@ namespace Heart::API
 				ChangedPins.Add(NodeB, PinB.PinGuid);
 			}
 		}
+
+		// Either side may be on a lightweight node, whose links only the extension can remove.
+		if (IsValid(NodeA) != IsValid(NodeB))
+		{
+			if (UHeartLightweightNodeExtension* Lightweight = Graph->GetExtension<UHeartLightweightNodeExtension>())
+			{
+				if (IsValid(NodeA))
+				{
+					Lightweight->RemoveLink(PinB, PinA);
+				}
+				else
+				{
+					Lightweight->RemoveLink(PinA, PinB);
+				}
+			}
+		}
+	}
+
+	void FPinEdit::Internal_CreateMemento(const FHeartNodeGuid& NodeGuid, TMap<FHeartNodeGuid, FMemento>& OutMementos) const
+	{
+		if (const UHeartGraphNode* Node = Graph->GetNode(NodeGuid))
+		{
+			OutMementos.Add(NodeGuid).PinConnections = Node->PinData.CopyConnections();
+			return;
+		}
+
+		// Links to nodes that are neither in the graph nor lightweight have nothing to restore.
+		if (const UHeartLightweightNodeExtension* Lightweight = Graph->GetExtension<UHeartLightweightNodeExtension>())
+		{
+			if (TMap<FHeartPinGuid, FHeartGraphPinConnections> Connections;
+				Lightweight->CopyConnections(NodeGuid, Connections))
+			{
+				OutMementos.Add(NodeGuid).PinConnections = MoveTemp(Connections);
+			}
+		}
 	}
 }
\ No newline at end of file
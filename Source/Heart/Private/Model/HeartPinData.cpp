@@ -1,111 +1,194 @@
 ﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Model/HeartPinData.h"
+#include "Algo/Sort.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(HeartPinData)
 
 void FHeartNodePinData::AddPin(const FHeartPinGuid NewKey, const FHeartGraphPinDesc& Desc)
 {
-	PinOrder.Add(NewKey, PinOrder.Num());
-	PinDescriptions.Add(NewKey, Desc);
+	FHeartNodePin& Pin = Pins.AddDefaulted_GetRef();
+	Pin.Guid = NewKey;
+	Pin.Desc = FHeartPinDescHandle(Desc);
 }
 
-bool FHeartNodePinData::RemovePin(const FHeartPinGuid Key)
+FHeartPinGuid FHeartNodePinData::MakeCompactPinGuid(const FName Name) const
 {
-	PinDescriptions.Remove(Key);
-	PinConnections.Remove(Key);
-
-	if (const int32* Order = PinOrder.Find(Key))
+	TBitArray<> UsedSlots(false, Pins.Num() + 1);
+	for (const FHeartNodePin& Pin : Pins)
 	{
-		// @todo this is horrid
-		for (auto&& Element : PinOrder)
+		if (Pin.Guid.IsCompact() && Pin.Guid.GetCompactSlot() <= Pins.Num())
 		{
-			if (Element.Value > *Order)
-			{
-				Element.Value--;
-			}
+			UsedSlots[Pin.Guid.GetCompactSlot()] = true;
 		}
 	}
 
-	return !!PinOrder.Remove(Key);
+	// There are more bits than pins, so there is always a free one.
+	const int32 Slot = UsedSlots.Find(false);
+	if (Slot > MAX_uint16)
+	{
+		return FHeartPinGuid::New();
+	}
+
+	return FHeartPinGuid::NewCompact(static_cast<uint16>(Slot), GetTypeHash(Name));
+}
+
+bool FHeartNodePinData::RemovePin(const FHeartPinGuid Key)
+{
+	const int32 Index = GetPinIndex(Key);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Not a swap, to keep the order of the remaining pins.
+	Pins.RemoveAt(Index);
+	return true;
 }
 
 int32 FHeartNodePinData::Num() const
 {
-	return PinDescriptions.Num();
+	return Pins.Num();
 }
 
 bool FHeartNodePinData::Contains(const FHeartPinGuid Key) const
 {
-	return PinDescriptions.Contains(Key);
+	return GetPinIndex(Key) != INDEX_NONE;
 }
 
 int32 FHeartNodePinData::GetPinIndex(const FHeartPinGuid Key) const
 {
-	return PinOrder[Key];
+	return Pins.IndexOfByPredicate([Key](const FHeartNodePin& Pin) { return Pin.Guid == Key; });
 }
 
 bool FHeartNodePinData::HasConnections(const FHeartPinGuid Key) const
 {
-	return PinConnections.Contains(Key);
+	const int32 Index = GetPinIndex(Key);
+	return Index != INDEX_NONE && !Pins[Index].Connections.Connections.IsEmpty();
 }
 
 TOptional<FHeartGraphPinDesc> FHeartNodePinData::GetPinDesc(const FHeartPinGuid Key) const
 {
-	if (const FHeartGraphPinDesc* Descriptions = PinDescriptions.Find(Key))
+	if (const int32 Index = GetPinIndex(Key);
+		Index != INDEX_NONE)
 	{
-		return *Descriptions;
+		return *Pins[Index].Desc;
 	}
 	return NullOpt;
 }
 
 TConstStructView<FHeartGraphPinDesc> FHeartNodePinData::ViewPin(const FHeartPinGuid Key) const
 {
-	if (const FHeartGraphPinDesc* Descriptions = PinDescriptions.Find(Key))
+	if (const int32 Index = GetPinIndex(Key);
+		Index != INDEX_NONE)
 	{
-		return *Descriptions;
+		return *Pins[Index].Desc;
 	}
 	return TConstStructView<FHeartGraphPinDesc>();
 }
 
-FHeartGraphPinDesc& FHeartNodePinData::GetPinChecked(const FHeartPinGuid Key)
+FHeartGraphPinDesc& FHeartNodePinData::GetPinChecked(const FHeartPinGuid Key, UObject* Outer)
 {
-	return PinDescriptions.FindChecked(Key);
+	const int32 Index = GetPinIndex(Key);
+	check(Index != INDEX_NONE);
+	return Pins[Index].Desc.GetMutable(Outer);
 }
 
 TConstStructView<FHeartGraphPinConnections> FHeartNodePinData::ViewConnections(const FHeartPinGuid Key) const
 {
-	if (const FHeartGraphPinConnections* Connections = PinConnections.Find(Key))
+	// Pins without links report no connections, to match HasConnections.
+	if (const int32 Index = GetPinIndex(Key);
+		Index != INDEX_NONE && !Pins[Index].Connections.Connections.IsEmpty())
 	{
-		return *Connections;
+		return Pins[Index].Connections;
 	}
 	return TConstStructView<FHeartGraphPinConnections>{};
 }
 
-FHeartGraphPinConnections& FHeartNodePinData::GetConnectionsMutable(const FHeartPinGuid Key)
+FHeartGraphPinConnections* FHeartNodePinData::FindConnectionsMutable(const FHeartPinGuid Key)
 {
-	return PinConnections.FindOrAdd(Key);
+	if (const int32 Index = GetPinIndex(Key);
+		Index != INDEX_NONE)
+	{
+		return &Pins[Index].Connections;
+	}
+	return nullptr;
 }
 
-void FHeartNodePinData::AddConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin)
+bool FHeartNodePinData::AddConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin)
 {
-	PinConnections.FindOrAdd(Key).Connections.AddUnique(Pin);
+	FHeartGraphPinConnections* Connections = FindConnectionsMutable(Key);
+	if (!ensureMsgf(Connections, TEXT("Cannot connect to a pin that doesn't exist on this node")))
+	{
+		return false;
+	}
+
+	Connections->Connections.AddUnique(Pin);
+	return true;
 }
 
 bool FHeartNodePinData::RemoveConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin)
 {
-	if (FHeartGraphPinConnections* Connections = PinConnections.Find(Key))
+	if (FHeartGraphPinConnections* Connections = FindConnectionsMutable(Key))
 	{
-		const int32 Removed = Connections->Connections.RemoveSingleSwap(Pin);
+		return !!Connections->Connections.RemoveSingleSwap(Pin);
+	}
+
+	return false;
+}
 
-		// Remove Connections element, if empty.
-		if (Connections->Connections.IsEmpty())
+TMap<FHeartPinGuid, FHeartGraphPinConnections> FHeartNodePinData::CopyConnections() const
+{
+	TMap<FHeartPinGuid, FHeartGraphPinConnections> Out;
+	for (const FHeartNodePin& Pin : Pins)
+	{
+		if (!Pin.Connections.Connections.IsEmpty())
 		{
-			PinConnections.Remove(Key);
+			Out.Add(Pin.Guid, Pin.Connections);
 		}
+	}
+	return Out;
+}
 
-		return !!Removed;
+void FHeartNodePinData::SetConnections(const TMap<FHeartPinGuid, FHeartGraphPinConnections>& NewConnections)
+{
+	for (FHeartNodePin& Pin : Pins)
+	{
+		if (const FHeartGraphPinConnections* Connections = NewConnections.Find(Pin.Guid))
+		{
+			Pin.Connections = *Connections;
+		}
+		else
+		{
+			Pin.Connections.Connections.Reset();
+		}
 	}
+}
 
-	return false;
-}
\ No newline at end of file
+void FHeartNodePinData::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading() && !PinDescriptions_DEPRECATED.IsEmpty())
+	{
+		Pins.Reset(PinDescriptions_DEPRECATED.Num());
+		for (auto&& Element : PinDescriptions_DEPRECATED)
+		{
+			FHeartNodePin& Pin = Pins.AddDefaulted_GetRef();
+			Pin.Guid = Element.Key;
+			Pin.Desc = FHeartPinDescHandle(Element.Value);
+			if (const FHeartGraphPinConnections* Connections = PinConnections_DEPRECATED.Find(Element.Key))
+			{
+				Pin.Connections = *Connections;
+			}
+		}
+
+		Algo::SortBy(Pins, [this](const FHeartNodePin& Pin)
+			{
+				const int32* Order = PinOrder_DEPRECATED.Find(Pin.Guid);
+				return Order ? *Order : MAX_int32;
+			});
+
+		PinDescriptions_DEPRECATED.Empty();
+		PinConnections_DEPRECATED.Empty();
+		PinOrder_DEPRECATED.Empty();
+	}
+}
@@ -0,0 +1,201 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartPinDescHandle.h"
+#include "Model/HeartGraphPinMetadata.h"
+#include "Misc/ScopeLock.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartPinDescHandle)
+
+FHeartPinDescHandle::FHeartPinDescHandle(const FHeartGraphPinDesc& InDesc)
+{
+	Desc = Heart::Graph::FPinDescTable::Get().Intern(InDesc);
+	Interned = true;
+}
+
+FHeartGraphPinDesc& FHeartPinDescHandle::GetMutable(UObject* Outer)
+{
+	check(::IsValid(Outer));
+
+	if (!Desc.IsValid())
+	{
+		Desc = MakeShared<FHeartGraphPinDesc>();
+	}
+	else if (Interned || !Desc.IsUnique())
+	{
+		Desc = MakeShared<FHeartGraphPinDesc>(*Desc);
+	}
+
+	// Metadata may still belong to the defaults or the pin this was copied from, which must not see the changes.
+	DuplicateMetadata(*Desc, Outer);
+
+	Interned = false;
+	return *Desc;
+}
+
+void FHeartPinDescHandle::DuplicateMetadata(FHeartGraphPinDesc& InDesc, UObject* Outer)
+{
+	for (TObjectPtr<UHeartGraphPinMetadata>& Metadata : InDesc.Metadata)
+	{
+		if (!::IsValid(Metadata) || Metadata->GetOuter() == Outer)
+		{
+			continue;
+		}
+
+		Metadata = DuplicateObject(Metadata.Get(), Outer);
+	}
+}
+
+bool FHeartPinDescHandle::IsOwnedByOtherInstance(const UHeartGraphPinMetadata* Metadata, const UObject* Parent)
+{
+	return ::IsValid(Metadata) && !Metadata->IsIn(Parent) && !Metadata->IsTemplate() && !Metadata->GetTypedOuter<UClass>();
+}
+
+bool FHeartPinDescHandle::Serialize(FArchive& Ar)
+{
+	UScriptStruct* DescStruct = FHeartGraphPinDesc::StaticStruct();
+
+	if (Ar.IsLoading())
+	{
+		FHeartGraphPinDesc Loaded;
+		DescStruct->SerializeItem(Ar, &Loaded, nullptr);
+		*this = FHeartPinDescHandle(Loaded);
+	}
+	else if (Desc.IsValid())
+	{
+		DescStruct->SerializeItem(Ar, Desc.Get(), nullptr);
+	}
+	else
+	{
+		FHeartGraphPinDesc Empty;
+		DescStruct->SerializeItem(Ar, &Empty, nullptr);
+	}
+
+	return true;
+}
+
+bool FHeartPinDescHandle::Identical(const FHeartPinDescHandle* Other, const uint32 PortFlags) const
+{
+	if (Desc == Other->Desc)
+	{
+		return true;
+	}
+
+	return FHeartGraphPinDesc::StaticStruct()->CompareScriptStruct(&Get(), &Other->Get(), PortFlags);
+}
+
+bool FHeartPinDescHandle::ExportTextItem(FString& ValueStr, const FHeartPinDescHandle& DefaultValue, UObject* Parent,
+										 const int32 PortFlags, UObject* ExportRootScope) const
+{
+	FHeartGraphPinDesc::StaticStruct()->ExportText(ValueStr, &Get(), &DefaultValue.Get(), Parent, PortFlags, ExportRootScope);
+	return true;
+}
+
+bool FHeartPinDescHandle::ImportTextItem(const TCHAR*& Buffer, const int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
+{
+	UScriptStruct* DescStruct = FHeartGraphPinDesc::StaticStruct();
+
+	FHeartGraphPinDesc Imported;
+	const TCHAR* Result = DescStruct->ImportText(Buffer, &Imported, Parent, PortFlags, ErrorText, DescStruct->GetName());
+	if (!Result)
+	{
+		return false;
+	}
+
+	Buffer = Result;
+
+	// Pasting a single description references the metadata of the pin it was copied from, so take ownership of it.
+	if (::IsValid(Parent))
+	{
+		for (TObjectPtr<UHeartGraphPinMetadata>& Metadata : Imported.Metadata)
+		{
+			if (IsOwnedByOtherInstance(Metadata, Parent))
+			{
+				Metadata = DuplicateObject(Metadata.Get(), Parent);
+			}
+		}
+	}
+
+	*this = FHeartPinDescHandle(Imported);
+	return true;
+}
+
+void FHeartPinDescHandle::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	// The table holds entries weakly, so every handle reports the metadata of the description it points to.
+	if (Desc.IsValid())
+	{
+		Collector.AddStableReferenceArray(&Desc->Metadata);
+	}
+}
+
+namespace Heart::Graph
+{
+	// How many descriptions to add between sweeps for released entries.
+	static constexpr int32 AddsBetweenPurges = 1024;
+
+	FPinDescTable& FPinDescTable::Get()
+	{
+		static FPinDescTable Table;
+		return Table;
+	}
+
+	TSharedPtr<FHeartGraphPinDesc> FPinDescTable::Intern(const FHeartGraphPinDesc& Desc)
+	{
+		// Metadata is compared by identity, so descriptions only share an entry when they share metadata objects.
+		const uint32 Hash = HashDesc(Desc);
+		const UScriptStruct* DescStruct = FHeartGraphPinDesc::StaticStruct();
+
+		FScopeLock ScopeLock(&Lock);
+
+		for (auto It = Entries.CreateKeyIterator(Hash); It; ++It)
+		{
+			if (TSharedPtr<FHeartGraphPinDesc> Existing = It.Value().Pin();
+				Existing.IsValid() && DescStruct->CompareScriptStruct(Existing.Get(), &Desc, PPF_None))
+			{
+				return Existing;
+			}
+		}
+
+		if (++AddsSincePurge >= AddsBetweenPurges)
+		{
+			PurgeStale();
+		}
+
+		TSharedPtr<FHeartGraphPinDesc> NewEntry = MakeShared<FHeartGraphPinDesc>(Desc);
+		Entries.Add(Hash, NewEntry);
+		return NewEntry;
+	}
+
+	int32 FPinDescTable::Num() const
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		int32 Count = 0;
+		for (auto&& Element : Entries)
+		{
+			Count += Element.Value.IsValid();
+		}
+		return Count;
+	}
+
+	uint32 FPinDescTable::HashDesc(const FHeartGraphPinDesc& Desc)
+	{
+		uint32 Hash = GetTypeHash(Desc.Name);
+		Hash = HashCombineFast(Hash, GetTypeHash(Desc.Tag));
+		Hash = HashCombineFast(Hash, GetTypeHash(Desc.Direction));
+		return Hash;
+	}
+
+	void FPinDescTable::PurgeStale()
+	{
+		AddsSincePurge = 0;
+
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
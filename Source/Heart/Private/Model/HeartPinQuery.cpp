@@ -12,12 +12,14 @@ namespace Heart::Query
 	{
 		return SortBy([this](const FHeartPinGuid& Key)
 			{
-				return Reference.PinOrder[Key];
+				return Reference.GetPinIndex(Key);
 			});
 	}
 
-	const TMap<FHeartPinGuid, FHeartGraphPinDesc>& FPinQueryResult::SimpleData() const
+	const FHeartGraphPinDesc& FPinQueryResult::operator[](const FHeartPinGuid Key) const
 	{
-		return Reference.PinDescriptions;
+		const int32 Index = Reference.GetPinIndex(Key);
+		check(Index != INDEX_NONE);
+		return Reference.Pins[Index].Desc.Get();
 	}
 }
\ No newline at end of file
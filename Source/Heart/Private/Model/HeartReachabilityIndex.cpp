@@ -0,0 +1,345 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartReachabilityIndex.h"
+#include "Model/HeartAdjacencyIndex.h"
+#include "Model/HeartTopologicalOrder.h"
+#include "Algo/Reverse.h"
+#include "Algo/Sort.h"
+
+namespace Heart::Graph
+{
+	static bool IsLive(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex Node)
+	{
+		return Node.IsValid() && Node.Index < Adjacency.GetMaxIndex() && Adjacency.GetNodeAt(Node.Index) == Node;
+	}
+
+	void FReachabilityIndex::Rebuild(const FAdjacencyIndex& Adjacency, const FTopologicalOrder& Order)
+	{
+		Reset();
+
+		const int32 MaxIndex = Adjacency.GetMaxIndex();
+
+		TArray<FHeartNodeIndex> Nodes;
+		Nodes.Reserve(MaxIndex);
+		for (int32 Slot = 0; Slot < MaxIndex; ++Slot)
+		{
+			if (const FHeartNodeIndex Node = Adjacency.GetNodeAt(Slot);
+				Node.IsValid())
+			{
+				Nodes.Add(Node);
+			}
+		}
+
+		Algo::Sort(Nodes, [&Order](const FHeartNodeIndex A, const FHeartNodeIndex B) { return Order.GetRank(A) < Order.GetRank(B); });
+
+		if (MaxIndex <= MaxBitsetSlots)
+		{
+			// Successors first, so each row can be assembled from rows that are already complete.
+			Algo::Reverse(Nodes);
+			BuildBitset(Adjacency, Nodes);
+		}
+		else
+		{
+			BuildIntervals(Adjacency, Nodes);
+		}
+
+		Built = true;
+	}
+
+	void FReachabilityIndex::Reset()
+	{
+		Built = false;
+		Closure.Reset();
+		RowWords = 0;
+		Pre.Reset();
+		Post.Reset();
+		Low.Reset();
+		Clock = 0;
+	}
+
+	void FReachabilityIndex::AddNode(const FHeartNodeIndex Node)
+	{
+		if (!Built || !Node.IsValid())
+		{
+			return;
+		}
+
+		if (UsesBitset())
+		{
+			if (Node.Index >= RowWords * 64)
+			{
+				// Out of room; rebuild wider on the next query.
+				Reset();
+				return;
+			}
+
+			// The slot may be recycled, so clear what the last node here could reach. Nothing can reach it, as its edges
+			// were removed with it.
+			FMemory::Memzero(GetRow(Node.Index), RowWords * sizeof(uint64));
+			return;
+		}
+
+		// A node without edges is a tree of its own, labelled after everything else.
+		if (Pre.Num() <= Node.Index)
+		{
+			Pre.SetNum(Node.Index + 1);
+			Post.SetNum(Node.Index + 1);
+			Low.SetNum(Node.Index + 1);
+		}
+
+		Pre[Node.Index] = Clock++;
+		Post[Node.Index] = Clock++;
+		Low[Node.Index] = Post[Node.Index];
+	}
+
+	void FReachabilityIndex::EdgesAdded(const TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges)
+	{
+		if (!Built)
+		{
+			return;
+		}
+
+		if (!UsesBitset())
+		{
+			Reset();
+			return;
+		}
+
+		const int32 NumRows = Closure.Num() / RowWords;
+
+		for (const TPair<FHeartNodeIndex, FHeartNodeIndex>& Edge : Edges)
+		{
+			const int32 From = Edge.Key.Index;
+			const int32 To = Edge.Value.Index;
+
+			if (From >= NumRows || To >= NumRows || From == To || TestBit(GetRow(To), From))
+			{
+				// Unknown node, or the edge closed a cycle.
+				Reset();
+				return;
+			}
+
+			if (TestBit(GetRow(From), To))
+			{
+				continue;
+			}
+
+			// Everything that reaches From, and From itself, now also reaches To and all it reaches.
+			const uint64* ToRow = GetRow(To);
+			for (int32 Slot = 0; Slot < NumRows; ++Slot)
+			{
+				uint64* Row = GetRow(Slot);
+				if (Slot != From && !TestBit(Row, From))
+				{
+					continue;
+				}
+
+				for (int32 Word = 0; Word < RowWords; ++Word)
+				{
+					Row[Word] |= ToRow[Word];
+				}
+				Row[To >> 6] |= 1ull << (To & 63);
+			}
+		}
+	}
+
+	bool FReachabilityIndex::IsReachable(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex From, const FHeartNodeIndex To) const
+	{
+		if (!ensure(Built) || !IsLive(Adjacency, From) || !IsLive(Adjacency, To))
+		{
+			return false;
+		}
+
+		if (UsesBitset())
+		{
+			return TestBit(GetRow(From.Index), To.Index);
+		}
+
+		if (From == To || !Pre.IsValidIndex(From.Index) || !Pre.IsValidIndex(To.Index) || !LabelContains(From.Index, To.Index))
+		{
+			return false;
+		}
+
+		if (TreeContains(From.Index, To.Index))
+		{
+			return true;
+		}
+
+		// Search, only descending into nodes whose labels may still contain the target.
+		Visited.Init(false, Adjacency.GetMaxIndex());
+		Stack.Reset();
+		Stack.Add(From);
+		Visited[From.Index] = true;
+
+		while (!Stack.IsEmpty())
+		{
+			const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Edge.Node == To)
+				{
+					return true;
+				}
+
+				if (!IsLive(Adjacency, Edge.Node) || Visited[Edge.Node.Index])
+				{
+					continue;
+				}
+
+				Visited[Edge.Node.Index] = true;
+
+				if (TreeContains(Edge.Node.Index, To.Index))
+				{
+					return true;
+				}
+
+				if (LabelContains(Edge.Node.Index, To.Index))
+				{
+					Stack.Add(Edge.Node);
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void FReachabilityIndex::GetReachable(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex From, TBitArray<>& OutSlots) const
+	{
+		const int32 MaxIndex = Adjacency.GetMaxIndex();
+		OutSlots.Init(false, MaxIndex);
+
+		if (!ensure(Built) || !IsLive(Adjacency, From))
+		{
+			return;
+		}
+
+		if (UsesBitset())
+		{
+			const uint64* Row = GetRow(From.Index);
+			for (int32 Word = 0; Word < RowWords; ++Word)
+			{
+				for (uint64 Bits = Row[Word]; Bits; Bits &= Bits - 1)
+				{
+					if (const int32 Slot = Word * 64 + FMath::CountTrailingZeros64(Bits);
+						Slot < MaxIndex)
+					{
+						OutSlots[Slot] = true;
+					}
+				}
+			}
+			return;
+		}
+
+		Stack.Reset();
+		Stack.Add(From);
+
+		while (!Stack.IsEmpty())
+		{
+			const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (IsLive(Adjacency, Edge.Node) && !OutSlots[Edge.Node.Index])
+				{
+					OutSlots[Edge.Node.Index] = true;
+					Stack.Add(Edge.Node);
+				}
+			}
+		}
+	}
+
+	void FReachabilityIndex::BuildBitset(const FAdjacencyIndex& Adjacency, const TConstArrayView<FHeartNodeIndex> ReverseOrder)
+	{
+		RowWords = FMath::DivideAndRoundUp(FMath::Max(Adjacency.GetMaxIndex(), 1), 64);
+
+		// Every slot that fits in a row gets one, so nodes can be added without a rebuild.
+		Closure.SetNumZeroed(RowWords * 64 * RowWords);
+
+		for (const FHeartNodeIndex Node : ReverseOrder)
+		{
+			uint64* Row = GetRow(Node.Index);
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (!IsLive(Adjacency, Edge.Node))
+				{
+					continue;
+				}
+
+				const uint64* Successor = GetRow(Edge.Node.Index);
+				for (int32 Word = 0; Word < RowWords; ++Word)
+				{
+					Row[Word] |= Successor[Word];
+				}
+				Row[Edge.Node.Index >> 6] |= 1ull << (Edge.Node.Index & 63);
+			}
+		}
+	}
+
+	void FReachabilityIndex::BuildIntervals(const FAdjacencyIndex& Adjacency, const TConstArrayView<FHeartNodeIndex> Order)
+	{
+		const int32 MaxIndex = Adjacency.GetMaxIndex();
+		Pre.Init(INDEX_NONE, MaxIndex);
+		Post.Init(INDEX_NONE, MaxIndex);
+		Low.Init(INDEX_NONE, MaxIndex);
+
+		// Position in the out-edges of each node on the stack.
+		TArray<int32> Cursor;
+		Cursor.SetNumZeroed(MaxIndex);
+
+		// Roots are taken in topological order, so every tree starts as high as it can.
+		for (const FHeartNodeIndex Root : Order)
+		{
+			if (Pre[Root.Index] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			Pre[Root.Index] = Clock++;
+			Stack.Reset();
+			Stack.Add(Root);
+
+			while (!Stack.IsEmpty())
+			{
+				const FHeartNodeIndex Node = Stack.Last();
+				const TConstArrayView<FAdjacencyEdge> Edges = Adjacency.GetOutEdges(Node);
+
+				if (Cursor[Node.Index] < Edges.Num())
+				{
+					const FHeartNodeIndex Next = Edges[Cursor[Node.Index]++].Node;
+					if (IsLive(Adjacency, Next) && Pre[Next.Index] == INDEX_NONE)
+					{
+						Pre[Next.Index] = Clock++;
+						Stack.Add(Next);
+					}
+					continue;
+				}
+
+				// Every successor has been finished, as the graph has no back edges.
+				Stack.Pop(EAllowShrinking::No);
+				Post[Node.Index] = Clock++;
+
+				int32 Lowest = Post[Node.Index];
+				for (const FAdjacencyEdge& Edge : Edges)
+				{
+					if (IsLive(Adjacency, Edge.Node))
+					{
+						Lowest = FMath::Min(Lowest, Low[Edge.Node.Index]);
+					}
+				}
+				Low[Node.Index] = Lowest;
+			}
+		}
+	}
+
+	bool FReachabilityIndex::TreeContains(const int32 Ancestor, const int32 Descendant) const
+	{
+		return Pre[Ancestor] < Pre[Descendant] && Post[Descendant] < Post[Ancestor];
+	}
+
+	bool FReachabilityIndex::LabelContains(const int32 Ancestor, const int32 Descendant) const
+	{
+		return Low[Ancestor] <= Low[Descendant] && Post[Descendant] <= Post[Ancestor];
+	}
+}
@@ -0,0 +1,415 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Model/HeartTopologicalOrder.h"
+#include "Model/HeartAdjacencyIndex.h"
+#include "Algo/Sort.h"
+
+namespace Heart::Graph
+{
+	void FTopologicalOrder::Rebuild(const FAdjacencyIndex& Adjacency)
+	{
+		NeedsRevalidation = true;
+		Revalidate(Adjacency);
+	}
+
+	void FTopologicalOrder::Reset()
+	{
+		Ranks.Reset();
+		NextRank = 0;
+		Acyclic = true;
+		NeedsRevalidation = false;
+		HasUnmirroredEdges = false;
+		VisitMarks.Reset();
+		VisitEpoch = 0;
+	}
+
+	void FTopologicalOrder::Reserve(const int32 MaxSlot)
+	{
+		Ranks.Reserve(MaxSlot);
+	}
+
+	void FTopologicalOrder::AddNode(const FHeartNodeIndex Node)
+	{
+		if (!Node.IsValid())
+		{
+			return;
+		}
+
+		if (Ranks.Num() <= Node.Index)
+		{
+			Ranks.SetNum(Node.Index + 1);
+			for (int32 i = Node.Index; i < Ranks.Num(); ++i)
+			{
+				Ranks[i] = INDEX_NONE;
+			}
+		}
+
+		Ranks[Node.Index] = NextRank++;
+	}
+
+	bool FTopologicalOrder::AddEdge(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex From, const FHeartNodeIndex To,
+									TArray<FHeartNodeIndex>* OutReranked)
+	{
+		if (!Acyclic)
+		{
+			// The order is suspended until edges are removed, so there is nothing to maintain.
+			return false;
+		}
+
+		if (From == To)
+		{
+			Acyclic = false;
+			return false;
+		}
+
+		if (!Adjacency.HasEdge(To, From, EHeartPinDirection::Input))
+		{
+			HasUnmirroredEdges = true;
+		}
+
+		const int32 LowerBound = GetRank(To);
+		const int32 UpperBound = GetRank(From);
+
+		if (HasUnmirroredEdges || LowerBound == INDEX_NONE || UpperBound == INDEX_NONE)
+		{
+			Rebuild(Adjacency);
+			return Acyclic;
+		}
+
+		if (LowerBound > UpperBound)
+		{
+			// Already ordered correctly.
+			return true;
+		}
+
+		BeginSearch(Adjacency);
+
+		// Find everything reachable from To that is ranked no later than From. If From itself is reached, the edge closed a cycle.
+		TArray<FHeartNodeIndex> Forward;
+		if (SearchForward(Adjacency, To, From, UpperBound, &Forward))
+		{
+			Acyclic = false;
+			return false;
+		}
+
+		// Find everything that reaches From that is ranked no earlier than To.
+		TArray<FHeartNodeIndex> Backward;
+		SearchBackward(Adjacency, From, LowerBound, Backward);
+
+		// Reassign the ranks of both sets between themselves, placing the backward set first. The relative order within each set is kept.
+		auto ByRank = [this](const FHeartNodeIndex& A, const FHeartNodeIndex& B) { return Ranks[A.Index] < Ranks[B.Index]; };
+		Algo::Sort(Backward, ByRank);
+		Algo::Sort(Forward, ByRank);
+
+		TArray<int32> Pool;
+		Pool.Reserve(Backward.Num() + Forward.Num());
+		for (const FHeartNodeIndex Node : Backward) Pool.Add(Ranks[Node.Index]);
+		for (const FHeartNodeIndex Node : Forward) Pool.Add(Ranks[Node.Index]);
+		Algo::Sort(Pool);
+
+		int32 Next = 0;
+		for (const FHeartNodeIndex Node : Backward) Ranks[Node.Index] = Pool[Next++];
+		for (const FHeartNodeIndex Node : Forward) Ranks[Node.Index] = Pool[Next++];
+
+		if (OutReranked)
+		{
+			OutReranked->Append(Backward);
+			OutReranked->Append(Forward);
+		}
+
+		return true;
+	}
+
+	void FTopologicalOrder::AddEdges(const FAdjacencyIndex& Adjacency, const TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges)
+	{
+		TArray<FHeartNodeIndex> Reranked;
+		for (const TPair<FHeartNodeIndex, FHeartNodeIndex>& Edge : Edges)
+		{
+			if (!AddEdge(Adjacency, Edge.Key, Edge.Value, &Reranked))
+			{
+				return;
+			}
+
+			if (HasUnmirroredEdges)
+			{
+				// The order was rebuilt from the whole index, which already contains the rest of the batch.
+				return;
+			}
+		}
+
+		// Pearce-Kelly assumes every edge but the inserted one is already ordered, which doesn't hold for the edges later in
+		// the batch. A search may then miss a path through them, so a cycle closed only by new edges can go unnoticed, and
+		// reranking for one edge can break another. Either leaves a new edge, or an edge of a reranked node, out of order.
+		if (!IsOrderedAround(Adjacency, Edges, Reranked))
+		{
+			Rebuild(Adjacency);
+		}
+	}
+
+	void FTopologicalOrder::EdgesRemoved()
+	{
+		if (!Acyclic || HasUnmirroredEdges)
+		{
+			NeedsRevalidation = true;
+		}
+	}
+
+	bool FTopologicalOrder::WouldCreateCycle(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex From, const FHeartNodeIndex To) const
+	{
+		if (!From.IsValid() || !To.IsValid())
+		{
+			return false;
+		}
+
+		if (From == To)
+		{
+			return true;
+		}
+
+		Revalidate(Adjacency);
+
+		BeginSearch(Adjacency);
+
+		if (Acyclic)
+		{
+			const int32 FromRank = GetRank(From);
+			const int32 ToRank = GetRank(To);
+
+			if (FromRank != INDEX_NONE && ToRank != INDEX_NONE)
+			{
+				if (FromRank < ToRank)
+				{
+					return false;
+				}
+
+				// Only nodes ranked between the two can lie on a path from To back to From.
+				return SearchForward(Adjacency, To, From, FromRank, nullptr);
+			}
+		}
+
+		return SearchForward(Adjacency, To, From, INDEX_NONE, nullptr);
+	}
+
+	bool FTopologicalOrder::IsAcyclic(const FAdjacencyIndex& Adjacency) const
+	{
+		Revalidate(Adjacency);
+		return Acyclic;
+	}
+
+	int32 FTopologicalOrder::GetRank(const FHeartNodeIndex Node) const
+	{
+		return Ranks.IsValidIndex(Node.Index) ? Ranks[Node.Index] : INDEX_NONE;
+	}
+
+	void FTopologicalOrder::Revalidate(const FAdjacencyIndex& Adjacency) const
+	{
+		if (!NeedsRevalidation)
+		{
+			return;
+		}
+
+		NeedsRevalidation = false;
+		HasUnmirroredEdges = false;
+
+		const int32 MaxIndex = Adjacency.GetMaxIndex();
+
+		TArray<int32> InDegree;
+		InDegree.SetNumZeroed(MaxIndex);
+
+		int32 NumNodes = 0;
+		for (int32 Slot = 0; Slot < MaxIndex; ++Slot)
+		{
+			const FHeartNodeIndex Node = Adjacency.GetNodeAt(Slot);
+			if (!Node.IsValid())
+			{
+				continue;
+			}
+
+			NumNodes++;
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Adjacency.GetNodeAt(Edge.Node.Index) == Edge.Node)
+				{
+					InDegree[Edge.Node.Index]++;
+					HasUnmirroredEdges |= !Adjacency.HasEdge(Edge.Node, Node, EHeartPinDirection::Input);
+				}
+			}
+		}
+
+		Ranks.Init(INDEX_NONE, MaxIndex);
+		NextRank = 0;
+
+		Stack.Reset();
+		for (int32 Slot = 0; Slot < MaxIndex; ++Slot)
+		{
+			const FHeartNodeIndex Node = Adjacency.GetNodeAt(Slot);
+			if (Node.IsValid() && InDegree[Slot] == 0)
+			{
+				Stack.Add(Node);
+			}
+		}
+
+		while (!Stack.IsEmpty())
+		{
+			const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+			Ranks[Node.Index] = NextRank++;
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Adjacency.GetNodeAt(Edge.Node.Index) == Edge.Node && --InDegree[Edge.Node.Index] == 0)
+				{
+					Stack.Add(Edge.Node);
+				}
+			}
+		}
+
+		Acyclic = NextRank == NumNodes;
+
+		if (!Acyclic)
+		{
+			// Nodes on or downstream of a cycle were never released. Rank them last, so every node keeps a unique rank.
+			for (int32 Slot = 0; Slot < MaxIndex; ++Slot)
+			{
+				if (Adjacency.GetNodeAt(Slot).IsValid() && Ranks[Slot] == INDEX_NONE)
+				{
+					Ranks[Slot] = NextRank++;
+				}
+			}
+		}
+	}
+
+	void FTopologicalOrder::BeginSearch(const FAdjacencyIndex& Adjacency) const
+	{
+		if (VisitMarks.Num() < Adjacency.GetMaxIndex())
+		{
+			VisitMarks.SetNumZeroed(Adjacency.GetMaxIndex());
+		}
+
+		if (++VisitEpoch == 0)
+		{
+			// The epoch wrapped around, so old marks could alias the new one.
+			FMemory::Memzero(VisitMarks.GetData(), VisitMarks.Num() * sizeof(uint32));
+			VisitEpoch = 1;
+		}
+	}
+
+	bool FTopologicalOrder::MarkVisited(const int32 Slot) const
+	{
+		if (!VisitMarks.IsValidIndex(Slot) || VisitMarks[Slot] == VisitEpoch)
+		{
+			return false;
+		}
+
+		VisitMarks[Slot] = VisitEpoch;
+		return true;
+	}
+
+	bool FTopologicalOrder::IsOrderedAround(const FAdjacencyIndex& Adjacency, const TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges,
+											const TConstArrayView<FHeartNodeIndex> Nodes) const
+	{
+		for (const TPair<FHeartNodeIndex, FHeartNodeIndex>& Edge : Edges)
+		{
+			if (GetRank(Edge.Key) >= GetRank(Edge.Value))
+			{
+				return false;
+			}
+		}
+
+		for (const FHeartNodeIndex Node : Nodes)
+		{
+			const int32 Rank = GetRank(Node);
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Adjacency.GetNodeAt(Edge.Node.Index) == Edge.Node && GetRank(Edge.Node) <= Rank)
+				{
+					return false;
+				}
+			}
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetInEdges(Node))
+			{
+				if (GetRank(Edge.Node) >= Rank && Adjacency.HasEdge(Edge.Node, Node, EHeartPinDirection::Output))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool FTopologicalOrder::SearchForward(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex Start, const FHeartNodeIndex Target,
+										  const int32 MaxRank, TArray<FHeartNodeIndex>* OutVisited) const
+	{
+		Stack.Reset();
+		if (MarkVisited(Start.Index))
+		{
+			Stack.Add(Start);
+		}
+
+		while (!Stack.IsEmpty())
+		{
+			const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+			if (OutVisited)
+			{
+				OutVisited->Add(Node);
+			}
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Edge.Node == Target)
+				{
+					return true;
+				}
+
+				if (MaxRank != INDEX_NONE && GetRank(Edge.Node) > MaxRank)
+				{
+					continue;
+				}
+
+				if (MarkVisited(Edge.Node.Index))
+				{
+					Stack.Add(Edge.Node);
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void FTopologicalOrder::SearchBackward(const FAdjacencyIndex& Adjacency, const FHeartNodeIndex Start, const int32 MinRank,
+										   TArray<FHeartNodeIndex>& OutVisited) const
+	{
+		Stack.Reset();
+		if (MarkVisited(Start.Index))
+		{
+			Stack.Add(Start);
+		}
+
+		while (!Stack.IsEmpty())
+		{
+			const FHeartNodeIndex Node = Stack.Pop(EAllowShrinking::No);
+			OutVisited.Add(Node);
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetInEdges(Node))
+			{
+				if (GetRank(Edge.Node) < MinRank)
+				{
+					continue;
+				}
+
+				// Only follow in-edges that are real out-edges of the predecessor.
+				if (!Adjacency.HasEdge(Edge.Node, Node, EHeartPinDirection::Output))
+				{
+					continue;
+				}
+
+				if (MarkVisited(Edge.Node.Index))
+				{
+					Stack.Add(Edge.Node);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,210 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "ModelView/HeartGraphAlgorithmsLibrary.h"
+
+#include "Model/HeartAlgorithmGraph.h"
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HeartGraphAlgorithmsLibrary)
+
+namespace Heart::Algorithms
+{
+	static const UHeartGraph* GetGraph(const TScriptInterface<IHeartGraphInterface>& Graph)
+	{
+		if (!Graph.GetObject())
+		{
+			return nullptr;
+		}
+		return IHeartGraphInterface::Execute_GetHeartGraph(Graph.GetObject());
+	}
+
+	// Replace the default weights with the ones returned by a delegate, if it's bound.
+	static void ApplyWeights(Graph::FAlgorithmGraph& AlgorithmGraph, const FHeartNodeEdgeWeight& Weight)
+	{
+		if (!Weight.IsBound())
+		{
+			return;
+		}
+
+		FCsrGraph& Csr = AlgorithmGraph.GetCsr();
+		Csr.Weights.SetNumUninitialized(Csr.NumEdges());
+		for (int32 Vertex = 0; Vertex < Csr.NumVertices(); ++Vertex)
+		{
+			for (int32 Edge = Csr.Offsets[Vertex]; Edge < Csr.Offsets[Vertex + 1]; ++Edge)
+			{
+				Csr.Weights[Edge] = Weight.Execute(AlgorithmGraph.GetNode(Vertex), AlgorithmGraph.GetNode(Csr.Targets[Edge]));
+			}
+		}
+	}
+
+	static TArray<FHeartNodeSet> GroupComponents(const Graph::FAlgorithmGraph& AlgorithmGraph,
+												 const TConstArrayView<int32> Components, const int32 NumComponents)
+	{
+		TArray<FHeartNodeSet> Groups;
+		Groups.SetNum(NumComponents);
+		for (int32 Vertex = 0; Vertex < Components.Num(); ++Vertex)
+		{
+			Groups[Components[Vertex]].Nodes.Add(AlgorithmGraph.GetNode(Vertex));
+		}
+		return Groups;
+	}
+}
+
+TArray<FHeartNodeGuid> UHeartGraphAlgorithmsLibrary::BreadthFirstSearch(const TScriptInterface<IHeartGraphInterface> Graph,
+																		 const FHeartNodeGuid& Start, const EHeartPinDirection Direction)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return {};
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph, Direction);
+	const int32 Source = AlgorithmGraph.FindVertex(Start);
+	if (Source == INDEX_NONE)
+	{
+		return {};
+	}
+
+	TArray<int32> Order;
+	Heart::Algorithms::BreadthFirst(AlgorithmGraph.GetCsr(), {Source}, Order);
+	return AlgorithmGraph.ToNodes(Order);
+}
+
+TArray<FHeartNodeGuid> UHeartGraphAlgorithmsLibrary::DepthFirstSearch(const TScriptInterface<IHeartGraphInterface> Graph,
+																	   const FHeartNodeGuid& Start, const EHeartPinDirection Direction)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return {};
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph, Direction);
+	const int32 Source = AlgorithmGraph.FindVertex(Start);
+	if (Source == INDEX_NONE)
+	{
+		return {};
+	}
+
+	TArray<int32> Order;
+	Heart::Algorithms::DepthFirst(AlgorithmGraph.GetCsr(), {Source}, Order);
+	return AlgorithmGraph.ToNodes(Order);
+}
+
+bool UHeartGraphAlgorithmsLibrary::TopologicalSort(const TScriptInterface<IHeartGraphInterface> Graph,
+												   TArray<FHeartNodeGuid>& Sorted, TArray<FHeartNodeGuid>& Cycle)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return false;
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+
+	TArray<int32> Order;
+	TArray<int32> CycleVertices;
+	const bool Success = Heart::Algorithms::TopologicalSort(AlgorithmGraph.GetCsr(), Order, &CycleVertices);
+
+	Sorted = AlgorithmGraph.ToNodes(Order);
+	Cycle = AlgorithmGraph.ToNodes(CycleVertices);
+	return Success;
+}
+
+TArray<FHeartNodeSet> UHeartGraphAlgorithmsLibrary::StronglyConnectedComponents(const TScriptInterface<IHeartGraphInterface> Graph)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return {};
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+
+	TArray<int32> Components;
+	const int32 NumComponents = Heart::Algorithms::StronglyConnectedComponents(AlgorithmGraph.GetCsr(), Components);
+	return Heart::Algorithms::GroupComponents(AlgorithmGraph, Components, NumComponents);
+}
+
+TArray<FHeartNodeSet> UHeartGraphAlgorithmsLibrary::ConnectedComponents(const TScriptInterface<IHeartGraphInterface> Graph)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return {};
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+
+	TArray<int32> Components;
+	const int32 NumComponents = Heart::Algorithms::ConnectedComponents(AlgorithmGraph.GetCsr(), Components);
+	return Heart::Algorithms::GroupComponents(AlgorithmGraph, Components, NumComponents);
+}
+
+bool UHeartGraphAlgorithmsLibrary::FindShortestPath(const TScriptInterface<IHeartGraphInterface> Graph,
+													const FHeartNodeGuid& From, const FHeartNodeGuid& To,
+													TArray<FHeartNodeGuid>& Path)
+{
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return false;
+	}
+
+	const Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+
+	TArray<int32> Vertices;
+	const bool Found = Heart::Algorithms::ShortestPath(AlgorithmGraph.GetCsr(),
+		AlgorithmGraph.FindVertex(From), AlgorithmGraph.FindVertex(To), Vertices);
+
+	Path = AlgorithmGraph.ToNodes(Vertices);
+	return Found;
+}
+
+bool UHeartGraphAlgorithmsLibrary::FindShortestPathWeighted(const TScriptInterface<IHeartGraphInterface> Graph,
+															const FHeartNodeGuid& From, const FHeartNodeGuid& To,
+															const FHeartNodeEdgeWeight& Weight,
+															TArray<FHeartNodeGuid>& Path, double& Cost)
+{
+	Cost = 0.0;
+
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return false;
+	}
+
+	Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+	Heart::Algorithms::ApplyWeights(AlgorithmGraph, Weight);
+
+	TArray<int32> Vertices;
+	const bool Found = Heart::Algorithms::ShortestPathWeighted(AlgorithmGraph.GetCsr(),
+		AlgorithmGraph.FindVertex(From), AlgorithmGraph.FindVertex(To), Vertices, &Cost);
+
+	Path = AlgorithmGraph.ToNodes(Vertices);
+	return Found;
+}
+
+bool UHeartGraphAlgorithmsLibrary::FindLongestPath(const TScriptInterface<IHeartGraphInterface> Graph,
+												   const FHeartNodeEdgeWeight& Weight, TArray<FHeartNodeGuid>& Path,
+												   double& Length)
+{
+	Length = 0.0;
+
+	const UHeartGraph* HeartGraph = Heart::Algorithms::GetGraph(Graph);
+	if (!IsValid(HeartGraph))
+	{
+		return false;
+	}
+
+	Heart::Graph::FAlgorithmGraph AlgorithmGraph(HeartGraph);
+	Heart::Algorithms::ApplyWeights(AlgorithmGraph, Weight);
+
+	TArray<int32> Vertices;
+	const bool Found = Heart::Algorithms::LongestPath(AlgorithmGraph.GetCsr(), Vertices, &Length);
+
+	Path = AlgorithmGraph.ToNodes(Vertices);
+	return Found;
+}
@@ -180,6 +180,15 @@ bool UHeartGraphSchema::TryConnectPins_Implementation(UHeartGraph* Graph, const
 }
 FHeartConnectPinsResponse UHeartGraphSchema::CanPinsConnect_Implementation(const UHeartGraph* Graph, FHeartGraphPinReference PinA, FHeartGraphPinReference PinB) const
 {
+	if (DisallowCycles && IsValid(Graph) && Graph->WouldConnectionCreateCycle(PinA, PinB))
+	{
+#if !UE_BUILD_SHIPPING
+		return FHeartConnectPinsResponse{EHeartCanConnectPinsResponse::Disallow, FText::FromString("Connection would create a cycle")};
+#else
+		return FHeartConnectPinsResponse{EHeartCanConnectPinsResponse::Disallow};
+#endif
+	}
+
 #if !UE_BUILD_SHIPPING
 	return FHeartConnectPinsResponse{EHeartCanConnectPinsResponse::Allow, FText::FromString("Allowed by base implementation")};
 #else
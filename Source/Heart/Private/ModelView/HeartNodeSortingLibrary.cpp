@@ -9,6 +9,32 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(HeartNodeSortingLibrary)
 
+namespace Heart::Sorting
+{
+	// Gather every node of any of the classes from the graph's lookup index. Returns false if the graph has no index.
+	static bool GatherNodesOfClasses(const UHeartGraph* HeartGraph, const TSet<TSubclassOf<UHeartGraphNode>>& Classes,
+									 TSet<FHeartNodeGuid>& OutNodes)
+	{
+		const Graph::FNodeLookupIndex* Index = HeartGraph->GetNodeLookupIndex();
+		if (!Index)
+		{
+			return false;
+		}
+
+		for (const TSubclassOf<UHeartGraphNode>& Class : Classes)
+		{
+			Index->ForEachNodeOfClass(Class,
+				[&OutNodes](const FHeartNodeGuid& Node)
+				{
+					OutNodes.Add(Node);
+					return true;
+				});
+		}
+
+		return true;
+	}
+}
+
 TArray<UHeartGraphNode*> UHeartNodeSortingLibrary::ResolveNodes(const UHeartGraph* Graph, const TArray<FHeartNodeGuid>& Nodes)
 {
 	TArray<UHeartGraphNode*> Out;
@@ -87,11 +113,20 @@ TArray<FHeartNodeGuid> UHeartNodeSortingLibrary::FilterNodesByClass(const TScrip
 	}
 
 	const UHeartGraph* HeartGraph = IHeartGraphInterface::Execute_GetHeartGraph(Graph.GetObject());
-	if (IsValid(HeartGraph))
+	if (!IsValid(HeartGraph))
 	{
 		return TArray<FHeartNodeGuid>();
 	}
 
+	if (TSet<FHeartNodeGuid> OfClasses;
+		Heart::Sorting::GatherNodesOfClasses(HeartGraph, Classes, OfClasses))
+	{
+		return Nodes.FilterByPredicate([&OfClasses](const FHeartNodeGuid& Node)
+			{
+				return OfClasses.Contains(Node);
+			});
+	}
+
 	return Nodes.FilterByPredicate([&Classes, HeartGraph](const FHeartNodeGuid& Node)
 	{
 		const UHeartGraphNode* NodePtr = HeartGraph->GetNode(Node);
@@ -121,11 +156,20 @@ TArray<FHeartNodeGuid> UHeartNodeSortingLibrary::FilterNodesByClass_Exclusive(co
 	}
 
 	const UHeartGraph* HeartGraph = IHeartGraphInterface::Execute_GetHeartGraph(Graph.GetObject());
-	if (IsValid(HeartGraph))
+	if (!IsValid(HeartGraph))
 	{
 		return TArray<FHeartNodeGuid>();
 	}
 
+	if (TSet<FHeartNodeGuid> OfClasses;
+		Heart::Sorting::GatherNodesOfClasses(HeartGraph, Classes, OfClasses))
+	{
+		return Nodes.FilterByPredicate([&OfClasses, HeartGraph](const FHeartNodeGuid& Node)
+			{
+				return !OfClasses.Contains(Node) && IsValid(HeartGraph->GetNode(Node));
+			});
+	}
+
 	return Nodes.FilterByPredicate([&Classes, HeartGraph](const FHeartNodeGuid& Node)
 		{
 			const UHeartGraphNode* NodePtr = HeartGraph->GetNode(Node);
@@ -148,7 +192,7 @@ TArray<FHeartNodeGuid> UHeartNodeSortingLibrary::FilterNodesByClass_Exclusive(co
 void UHeartNodeSortingLibrary::SortLooseNodesIntoTrees(const TScriptInterface<IHeartGraphInterface> Graph, const TArray<FHeartNodeGuid>& Nodes, const FNodeLooseToTreeArgs& Args, TArray<FHeartTree>& Trees)
 {
 	UHeartGraph* HeartGraph = IHeartGraphInterface::Execute_GetHeartGraph(Graph.GetObject());
-	if (IsValid(HeartGraph))
+	if (!IsValid(HeartGraph))
 	{
 		return;
 	}
@@ -157,18 +201,45 @@ void UHeartNodeSortingLibrary::SortLooseNodesIntoTrees(const TScriptInterface<IH
 
 	TSet<const UHeartGraphNode*> TrackedNodes;
 
-	// Recursive function for building tree nodes
-	TFunction<FHeartTreeNode(const UHeartGraphNode*)> BuildTreeNode;
-	BuildTreeNode = [HeartGraph, InverseDirection, &BuildTreeNode, &TrackedNodes, AllowDuplicates = Args.AllowDuplicates](const UHeartGraphNode* Node)
+	// Tree nodes in pre-order, with the index of their parent, their links, and how many links have been walked.
+	TArray<FHeartTreeNode> TreeNodes;
+	TArray<int32> Parents;
+	TArray<TArray<FHeartNodeGuid>> Links;
+	TArray<int32> Cursors;
+	TArray<int32> Stack;
+
+	// Trees are walked with an explicit stack, so deep graphs cannot overflow it. A tree node must be complete before it
+	// is moved into its parent, so they are assembled afterward, in reverse.
+	auto BuildTreeNode = [&, AllowDuplicates = Args.AllowDuplicates](const UHeartGraphNode* Root)
 		{
-			FHeartTreeNode OutTreeNode;
-			OutTreeNode.Node = Node->GetGuid();
+			TreeNodes.Reset();
+			Parents.Reset();
+			Links.Reset();
+			Cursors.Reset();
+			Stack.Reset();
 
-			const TArray<FHeartNodeGuid> OutputLinks = Heart::Utils::GetConnectedNodes(HeartGraph, OutTreeNode.Node, InverseDirection);
+			auto Enter = [&](const FHeartNodeGuid& Node, const int32 Parent)
+				{
+					Stack.Add(TreeNodes.Num());
+					TreeNodes.AddDefaulted_GetRef().Node = Node;
+					Parents.Add(Parent);
+					Links.Add(Heart::Utils::GetConnectedNodes(HeartGraph, Node, InverseDirection));
+					Cursors.Add(0);
+				};
 
-			for (auto&& OutputLink : OutputLinks)
+			Enter(Root->GetGuid(), INDEX_NONE);
+
+			while (!Stack.IsEmpty())
 			{
-				if (auto&& ConnectedNode = HeartGraph->GetNode(OutputLink))
+				const int32 Current = Stack.Last();
+				if (Cursors[Current] == Links[Current].Num())
+				{
+					Stack.Pop(EAllowShrinking::No);
+					continue;
+				}
+
+				const FHeartNodeGuid Link = Links[Current][Cursors[Current]++];
+				if (auto&& ConnectedNode = HeartGraph->GetNode(Link))
 				{
 					if (TrackedNodes.Contains(ConnectedNode))
 					{
@@ -176,19 +247,43 @@ void UHeartNodeSortingLibrary::SortLooseNodesIntoTrees(const TScriptInterface<IH
 						{
 							continue;
 						}
+
+						// Duplicating an ancestor would repeat the same branch forever.
+						if (Stack.ContainsByPredicate([&](const int32 Ancestor) { return TreeNodes[Ancestor].Node == Link; }))
+						{
+							continue;
+						}
 					}
 					else
 					{
 						TrackedNodes.Add(ConnectedNode);
 					}
 
-					OutTreeNode.Children.Add(TInstancedStruct<FHeartTreeNode>::Make(BuildTreeNode(ConnectedNode)));
+					Enter(Link, Current);
 				}
 			}
 
-			return OutTreeNode;
-		};
+			// Children always come after their parent in pre-order, so walking backward completes each node before its
+			// parent takes it. Children are filled from the back to keep their order.
+			TArray<int32> Remaining;
+			Remaining.Init(0, TreeNodes.Num());
+			for (int32 i = 1; i < TreeNodes.Num(); ++i)
+			{
+				Remaining[Parents[i]]++;
+			}
+			for (int32 i = 0; i < TreeNodes.Num(); ++i)
+			{
+				TreeNodes[i].Children.SetNum(Remaining[i]);
+			}
 
+			for (int32 i = TreeNodes.Num() - 1; i > 0; --i)
+			{
+				const int32 Parent = Parents[i];
+				TreeNodes[Parent].Children[--Remaining[Parent]] = TInstancedStruct<FHeartTreeNode>::Make(MoveTemp(TreeNodes[i]));
+			}
+
+			return MoveTemp(TreeNodes[0]);
+		};
 
 	for (const FHeartNodeGuid& NodeGuid : Nodes)
 	{
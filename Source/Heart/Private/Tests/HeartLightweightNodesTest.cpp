@@ -0,0 +1,97 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "HeartTestTypes.h"
+#include "Input/HeartActionBase.h"
+#include "Misc/AutomationTest.h"
+#include "Model/HeartLightweightNodes.h"
+#include "Model/HeartNodeEdit.h"
+#include "Model/HeartPinConnectionEdit.h"
+#include "ModelView/HeartActionHistory.h"
+#include "ModelView/Actions/HeartAction_DeleteNode.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HeartLightweightNodesPromoteUndoTest,
+								 "Heart.LightweightNodes.PromoteDeleteUndo",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Heart::LightweightNodes::Tests
+{
+	static bool IsLinked(const TConstStructView<FHeartGraphPinConnections> Connections, const FHeartGraphPinReference& Pin)
+	{
+		return Connections.IsValid() && Connections.Get().GetLinks().Contains(Pin);
+	}
+}
+
+bool HeartLightweightNodesPromoteUndoTest::RunTest(const FString& Parameters)
+{
+	using namespace Heart::LightweightNodes::Tests;
+
+	UHeartGraph* Graph = NewObject<UHeartTestGraph>(GetTransientPackage());
+	UHeartLightweightNodeExtension* Lightweight = Graph->AddExtension<UHeartLightweightNodeExtension>();
+	UHeartActionHistory* History = Graph->AddExtension<UHeartActionHistory>();
+
+	if (!TestNotNull(TEXT("Lightweight extension"), Lightweight) ||
+		!TestNotNull(TEXT("History extension"), History))
+	{
+		return false;
+	}
+
+	const FHeartNodeArchetype Archetype(UHeartTestGraphNode::StaticClass(), FHeartNodeSource(UObject::StaticClass()));
+
+	// A -> B, both lightweight, then A is promoted to a graph node.
+	const FHeartNodeGuid A = Lightweight->AddNode(Archetype, FInstancedStruct(), FVector2D::ZeroVector);
+	const FHeartNodeGuid B = Lightweight->AddNode(Archetype, FInstancedStruct(), FVector2D(200.0, 0.0));
+	const FHeartGraphPinReference BIn{B, Lightweight->GetPinByName(B, TEXT("In"))};
+
+	TestTrue(TEXT("Connect lightweight nodes"),
+		Lightweight->Connect({A, Lightweight->GetPinByName(A, TEXT("Out"))}, BIn));
+
+	UHeartGraphNode* Promoted = Lightweight->Promote(A);
+	if (!TestNotNull(TEXT("Promoted node"), Promoted))
+	{
+		return false;
+	}
+
+	TestFalse(TEXT("Promoted node left the lightweight rows"), Lightweight->Contains(A));
+
+	const FHeartGraphPinReference AIn{A, Promoted->GetPinByName(TEXT("In"))};
+	const FHeartGraphPinReference AOut{A, Promoted->GetPinByName(TEXT("Out"))};
+	TestTrue(TEXT("Promoted node kept its link to B"), IsLinked(Promoted->ViewConnections(AOut.PinGuid), BIn));
+	TestTrue(TEXT("B was re-pointed at the promoted node"), IsLinked(Lightweight->ViewConnections(B, BIn.PinGuid), AOut));
+
+	// C -> A, both graph nodes.
+	UHeartGraphNode* C = Heart::API::FNodeCreator::CreateNode_Instanced(Graph, UHeartTestGraphNode::StaticClass(), UObject::StaticClass());
+	if (!TestTrue(TEXT("Add graph node"), Heart::API::FNodeEdit::AddNode(Graph, C)))
+	{
+		return false;
+	}
+
+	const FHeartGraphPinReference COut{C->GetGuid(), C->GetPinByName(TEXT("Out"))};
+	Heart::API::FPinEdit(Graph).Connect(COut, AIn);
+
+	// Deleting the promoted node must clear the back-links on both of its neighbours.
+	Heart::Action::Execute(UHeartAction_DeleteNode::StaticClass(), Promoted, FHeartManualEvent(1.0));
+
+	TestNull(TEXT("Promoted node was deleted"), Graph->GetNode(A));
+	TestFalse(TEXT("Graph neighbour unlinked"), IsLinked(C->ViewConnections(COut.PinGuid), AIn));
+	TestFalse(TEXT("Lightweight neighbour unlinked"), IsLinked(Lightweight->ViewConnections(B, BIn.PinGuid), AOut));
+
+	// Undoing the delete must restore both.
+	TestTrue(TEXT("Undo delete"), History->Undo());
+
+	const UHeartGraphNode* Restored = Graph->GetNode(A);
+	if (!TestNotNull(TEXT("Restored node"), Restored))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Graph neighbour relinked"), IsLinked(C->ViewConnections(COut.PinGuid), AIn));
+	TestTrue(TEXT("Restored node relinked to C"), IsLinked(Restored->ViewConnections(AIn.PinGuid), COut));
+	TestTrue(TEXT("Lightweight neighbour relinked"), IsLinked(Lightweight->ViewConnections(B, BIn.PinGuid), AOut));
+	TestTrue(TEXT("Restored node relinked to B"), IsLinked(Restored->ViewConnections(AOut.PinGuid), BIn));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "HeartTestTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Model/HeartNodeEdit.h"
+#include "Model/HeartNodeSlotMap.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HeartNodeSlotMapTest,
+								 "Heart.NodeSlotMap.LoadMigrate",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Heart::NodeSlotMap::Tests
+{
+	using FNodeMap = TMap<FHeartNodeGuid, TObjectPtr<UHeartGraphNode>>;
+
+	static TMap<FHeartNodeGuid, FHeartNodeIndex> GetHandles(const FHeartNodeSlotMap& Slots)
+	{
+		TMap<FHeartNodeGuid, FHeartNodeIndex> Handles;
+		for (int32 i = 0; i < Slots.Num(); i++)
+		{
+			const FHeartNodeIndex Index = Slots.GetIndexAt(i);
+			Handles.Add(Slots.GetGuid(Index), Index);
+		}
+		return Handles;
+	}
+}
+
+bool HeartNodeSlotMapTest::RunTest(const FString& Parameters)
+{
+	using namespace Heart::NodeSlotMap::Tests;
+
+	UHeartGraph* Graph = NewObject<UHeartTestGraph>(GetTransientPackage());
+
+	TArray<UHeartGraphNode*> Created;
+	for (int32 i = 0; i < 6; i++)
+	{
+		Created.Add(Heart::API::FNodeCreator::CreateNode_Instanced(Graph, UHeartTestGraphNode::StaticClass(), UObject::StaticClass()));
+	}
+
+	// The same nodes, added to the map in opposite orders.
+	FNodeMap Forward;
+	FNodeMap Backward;
+	for (int32 i = 0; i < Created.Num(); i++)
+	{
+		Forward.Add(Created[i]->GetGuid(), Created[i]);
+		Backward.Add(Created.Last(i)->GetGuid(), Created.Last(i));
+	}
+
+	// A graph saved before nodes had slots has none to restore, so every node is migrated.
+	FHeartNodeSlotMap LegacyA;
+	LegacyA.Rebuild(Forward);
+	FHeartNodeSlotMap LegacyB;
+	LegacyB.Rebuild(Backward);
+
+	const TMap<FHeartNodeGuid, FHeartNodeIndex> Migrated = GetHandles(LegacyA);
+	TestEqual(TEXT("Every node is migrated"), Migrated.Num(), Created.Num());
+	TestTrue(TEXT("Migration doesn't depend on map order"), Migrated.OrderIndependentCompareEqual(GetHandles(LegacyB)));
+
+	TArray<FHeartNodeGuid> Sorted;
+	Forward.GenerateKeyArray(Sorted);
+	Sorted.Sort();
+	for (int32 i = 0; i < Sorted.Num(); i++)
+	{
+		TestEqual(TEXT("Migrated slots follow guid order"), Migrated[Sorted[i]].Index, i);
+	}
+
+	// Free a slot, so its generation has to survive the round trip too.
+	const FHeartNodeGuid RemovedGuid = Sorted[2];
+	const FHeartNodeIndex RemovedIndex = Migrated[RemovedGuid];
+	TestTrue(TEXT("Remove a node"), LegacyA.Remove(RemovedIndex));
+	Forward.Remove(RemovedGuid);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FHeartNodeSlotMap::StaticStruct()->SerializeItem(Writer, &LegacyA, nullptr);
+
+	FHeartNodeSlotMap Loaded;
+	FMemoryReader Reader(Bytes);
+	FHeartNodeSlotMap::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+	Loaded.Rebuild(Forward);
+
+	TestTrue(TEXT("Handles survive save and load"), GetHandles(Loaded).OrderIndependentCompareEqual(GetHandles(LegacyA)));
+	TestFalse(TEXT("Handle to the removed node stays invalid"), Loaded.IsValidIndex(RemovedIndex));
+
+	// The freed slot is reused, under a new generation.
+	UHeartGraphNode* Replacement = Heart::API::FNodeCreator::CreateNode_Instanced(Graph, UHeartTestGraphNode::StaticClass(), UObject::StaticClass());
+	const FHeartNodeIndex ReplacementIndex = Loaded.Add(Replacement);
+	TestEqual(TEXT("Freed slot is reused"), ReplacementIndex.Index, RemovedIndex.Index);
+	TestNotEqual(TEXT("Reused slot has a new generation"), ReplacementIndex.Generation, RemovedIndex.Generation);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,62 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Model/HeartGraph.h"
+#include "Model/HeartGraphNode.h"
+#include "ModelView/HeartGraphSchema.h"
+#include "HeartTestTypes.generated.h"
+
+#if WITH_EDITOR
+
+/**
+ * Minimal graph types for automation tests.
+ */
+UCLASS(Hidden, NotBlueprintable)
+class UHeartTestGraphSchema : public UHeartGraphSchema
+{
+	GENERATED_BODY()
+};
+
+UCLASS(Hidden, NotBlueprintable)
+class UHeartTestGraph : public UHeartGraph
+{
+	GENERATED_BODY()
+
+protected:
+	virtual TSubclassOf<UHeartGraphSchema> GetSchemaClass_Implementation() const override
+	{
+		return UHeartTestGraphSchema::StaticClass();
+	}
+};
+
+// A node with one input pin, "In", and one output pin, "Out".
+UCLASS(Hidden, NotBlueprintable)
+class UHeartTestGraphNode : public UHeartGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UHeartTestGraphNode()
+	{
+		// Sparse class data is shared by the class, so only the default object sets it.
+		if (!HasAnyFlags(RF_ClassDefaultObject))
+		{
+			return;
+		}
+
+		FHeartGraphPinDesc In;
+		In.Name = TEXT("In");
+		In.Tag = FHeartGraphPinTag::GetRootTag();
+		In.Direction = EHeartPinDirection::Input;
+
+		FHeartGraphPinDesc Out;
+		Out.Name = TEXT("Out");
+		Out.Tag = FHeartGraphPinTag::GetRootTag();
+		Out.Direction = EHeartPinDirection::Output;
+
+		GetMutableHeartGraphNodeSparseClassData()->DefaultPins = { In, Out };
+	}
+};
+
+#endif
\ No newline at end of file
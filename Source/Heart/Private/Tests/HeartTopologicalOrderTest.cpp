@@ -0,0 +1,136 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "HeartTestTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Model/HeartNodeEdit.h"
+#include "Model/HeartPinConnectionEdit.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HeartTopologicalOrderTest,
+								 "Heart.TopologicalOrder.BatchEdits",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+namespace Heart::TopologicalOrder::Tests
+{
+	using namespace Heart::Graph;
+
+	static FHeartGraphPinReference Pin(const UHeartGraphNode* Node, const FName Name)
+	{
+		return { Node->GetGuid(), Node->GetPinByName(Name) };
+	}
+
+	static TArray<FHeartNodeIndex> GetOutNodes(const UHeartGraph* Graph, const UHeartGraphNode* Node)
+	{
+		TArray<FHeartNodeIndex> Out;
+		for (const FAdjacencyEdge& Edge : Graph->GetAdjacency().GetOutEdges(Node->GetNodeIndex()))
+		{
+			Out.Add(Edge.Node);
+		}
+		return Out;
+	}
+
+	// Does every out-edge of the graph lead from a lower to a higher rank?
+	static bool IsValidOrder(const FAdjacencyIndex& Adjacency, const FTopologicalOrder& Order)
+	{
+		for (int32 Slot = 0; Slot < Adjacency.GetMaxIndex(); ++Slot)
+		{
+			const FHeartNodeIndex Node = Adjacency.GetNodeAt(Slot);
+			if (!Node.IsValid())
+			{
+				continue;
+			}
+
+			for (const FAdjacencyEdge& Edge : Adjacency.GetOutEdges(Node))
+			{
+				if (Order.GetRank(Node) >= Order.GetRank(Edge.Node))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+bool HeartTopologicalOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace Heart::TopologicalOrder::Tests;
+
+	UHeartGraph* Graph = NewObject<UHeartTestGraph>(GetTransientPackage());
+
+	TArray<UHeartGraphNode*> Nodes;
+	for (int32 i = 0; i < 7; i++)
+	{
+		UHeartGraphNode* Node = Heart::API::FNodeCreator::CreateNode_Instanced(Graph, UHeartTestGraphNode::StaticClass(), UObject::StaticClass());
+		if (!TestTrue(TEXT("Add graph node"), Heart::API::FNodeEdit::AddNode(Graph, Node)))
+		{
+			return false;
+		}
+		Nodes.Add(Node);
+	}
+
+	const FAdjacencyIndex& Adjacency = Graph->GetAdjacency();
+	const FTopologicalOrder& Order = Graph->GetTopologicalOrder();
+
+	// Compare the incrementally maintained order with one built from scratch.
+	auto TestOrder = [&](const TCHAR* What, const bool bExpectAcyclic)
+	{
+		FTopologicalOrder Fresh;
+		Fresh.Rebuild(Adjacency);
+
+		TestEqual(FString::Printf(TEXT("%s: acyclic"), What), Order.IsAcyclic(Adjacency), bExpectAcyclic);
+		TestEqual(FString::Printf(TEXT("%s: agrees with a rebuild"), What), Order.IsAcyclic(Adjacency), Fresh.IsAcyclic(Adjacency));
+		if (bExpectAcyclic)
+		{
+			TestTrue(FString::Printf(TEXT("%s: order is valid"), What), IsValidOrder(Adjacency, Order));
+		}
+	};
+
+	// Chain the nodes against the order they were ranked in, in a single edit, so every edge of the batch has to be reordered.
+	{
+		Heart::API::FPinEdit Edit(Graph);
+		for (int32 i = 5; i > 0; i--)
+		{
+			Edit.Connect(Pin(Nodes[i], TEXT("Out")), Pin(Nodes[i - 1], TEXT("In")));
+		}
+		Edit.Connect(Pin(Nodes[5], TEXT("Out")), Pin(Nodes[2], TEXT("In")));
+	}
+
+	const TArray<FHeartNodeIndex> OutOf5 = GetOutNodes(Graph, Nodes[5]);
+	TestEqual(TEXT("Out-edges of the chain head"), OutOf5.Num(), 2);
+	TestTrue(TEXT("Out-edges include the next node"), OutOf5.Contains(Nodes[4]->GetNodeIndex()));
+	TestTrue(TEXT("Out-edges include the shortcut"), OutOf5.Contains(Nodes[2]->GetNodeIndex()));
+	TestTrue(TEXT("In-edge is mirrored"), Adjacency.HasEdge(Nodes[2]->GetNodeIndex(), Nodes[5]->GetNodeIndex(), EHeartPinDirection::Input));
+	TestEqual(TEXT("Out-edges of the chain tail"), GetOutNodes(Graph, Nodes[0]).Num(), 0);
+	TestOrder(TEXT("Reversed chain"), true);
+
+	// Close a cycle that only exists through edges of the same batch.
+	{
+		Heart::API::FPinEdit Edit(Graph);
+		Edit.Connect(Pin(Nodes[0], TEXT("Out")), Pin(Nodes[6], TEXT("In")));
+		Edit.Connect(Pin(Nodes[6], TEXT("Out")), Pin(Nodes[5], TEXT("In")));
+	}
+	TestOrder(TEXT("Cycle closed by a batch"), false);
+
+	// Breaking the cycle resumes the order.
+	Heart::API::FPinEdit(Graph).Disconnect(Pin(Nodes[6], TEXT("Out")), Pin(Nodes[5], TEXT("In")));
+	TestOrder(TEXT("Cycle broken"), true);
+
+	Heart::API::FPinEdit(Graph).Disconnect(Pin(Nodes[5], TEXT("Out")), Pin(Nodes[2], TEXT("In")));
+	TestTrue(TEXT("Removed edge is gone"), GetOutNodes(Graph, Nodes[5]) == TArray<FHeartNodeIndex>{ Nodes[4]->GetNodeIndex() });
+	TestFalse(TEXT("Removed in-edge is gone"), Adjacency.HasEdge(Nodes[2]->GetNodeIndex(), Nodes[5]->GetNodeIndex(), EHeartPinDirection::Input));
+	TestOrder(TEXT("Edge removed"), true);
+
+	// A batch whose edges are each acyclic alone, but close a cycle together with existing edges.
+	{
+		Heart::API::FPinEdit Edit(Graph);
+		Edit.Connect(Pin(Nodes[1], TEXT("Out")), Pin(Nodes[6], TEXT("In")));
+		Edit.Connect(Pin(Nodes[6], TEXT("Out")), Pin(Nodes[3], TEXT("In")));
+	}
+	TestOrder(TEXT("Cycle through existing edges"), false);
+
+	return true;
+}
+
+#endif
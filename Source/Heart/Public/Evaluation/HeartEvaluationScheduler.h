@@ -0,0 +1,37 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartEvaluationScheduler.generated.h"
+
+UENUM(BlueprintType)
+enum class EHeartEvaluationMode : uint8
+{
+	// Run nodes one after another in topological order.
+	Serial,
+
+	// Run independent nodes concurrently on worker threads. Nodes that aren't thread-safe run on the calling thread.
+	Parallel,
+
+	// Build the same schedule as Parallel, but run it on the calling thread in topological order. For testing.
+	Deterministic
+};
+
+namespace Heart::Evaluation
+{
+	using FDependentsFunc = TFunctionRef<TConstArrayView<int32>(int32)>;
+
+	// Run a node, returning true if its dependents must run too. Called from worker threads for thread-safe nodes.
+	using FRunNodeFunc = TFunctionRef<bool(int32)>;
+
+	/**
+	 * Run the dirty nodes of a DAG, and any dependents they dirty in turn. Nodes must be numbered in topological order.
+	 *
+	 * In Parallel mode, a UE::Tasks task is launched for every node that could be dirtied, with the tasks of its dirtiable
+	 * producers as prerequisites, so independent branches run concurrently. Tasks of nodes in GameThreadOnly are marshalled
+	 * back to the calling thread, which must be the game thread, and which works through them while waiting for the rest.
+	 * Clears Dirty. Returns the number of nodes run.
+	 */
+	HEART_API int32 RunScheduled(EHeartEvaluationMode Mode, TBitArray<>& Dirty, const TBitArray<>& GameThreadOnly,
+								 FDependentsFunc Dependents, FRunNodeFunc RunNode);
+}
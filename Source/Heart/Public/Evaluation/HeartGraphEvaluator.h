@@ -0,0 +1,70 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartEvaluationScheduler.h"
+#include "HeartGraphProgram.h"
+#include "UObject/Object.h"
+#include "HeartGraphEvaluator.generated.h"
+
+class UHeartGraph;
+
+/**
+ * Evaluates the dataflow of a graph, through nodes implementing IHeartNodeEvaluator. The graph is compiled into a
+ * Heart::Evaluation::FProgram, and output values are cached between evaluations. Evaluating only re-runs nodes that were
+ * marked dirty, and nodes downstream of an output whose value changed.
+ * The graph is recompiled automatically when its version changes. Cached outputs survive recompiling; only nodes that are
+ * new, or whose inputs were reconnected, are dirtied.
+ */
+UCLASS(BlueprintType)
+class HEART_API UHeartGraphEvaluator : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	void SetGraph(UHeartGraph* InGraph);
+
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	UHeartGraph* GetGraph() const { return Graph; }
+
+	// Evaluate every dirty node, and everything downstream of a changed output. Returns the number of nodes run.
+	// Game thread only, though in Parallel mode, thread-safe nodes are evaluated on worker threads meanwhile.
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	int32 Evaluate(EHeartEvaluationMode Mode = EHeartEvaluationMode::Serial);
+
+	// Re-evaluate a node on the next Evaluate, e.g., after changing state its outputs depend on.
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	void MarkNodeDirty(const FHeartNodeGuid& Node);
+
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	void MarkAllDirty();
+
+	// Get the last value produced by an output pin.
+	UFUNCTION(BlueprintCallable, Category = "Heart|Evaluation")
+	FBloodValue GetOutputValue(const FHeartGraphPinReference& Pin) const;
+
+	const FBloodValue* FindOutputValue(const FHeartGraphPinReference& Pin) const;
+
+	const Heart::Evaluation::FProgram& GetProgram() const { return Program; }
+
+private:
+	// Recompile if the graph changed since the last compile, carrying over cached outputs.
+	void UpdateProgram();
+
+	UPROPERTY()
+	TObjectPtr<UHeartGraph> Graph;
+
+	Heart::Evaluation::FProgram Program;
+
+	// Output value of each slot in the program.
+	TArray<FBloodValue> Slots;
+
+	// Instructions to run on the next Evaluate.
+	TBitArray<> Dirty;
+
+	bool Compiled = false;
+
+	// The graph topology version the last compile failed at, such as for a cycle.
+	TOptional<uint64> FailedVersion;
+};
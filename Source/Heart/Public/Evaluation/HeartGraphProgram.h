@@ -0,0 +1,139 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "BloodValue.h"
+#include "Model/HeartGraphPinReference.h"
+#include "UObject/WeakInterfacePtr.h"
+
+class IHeartNodeEvaluator;
+class UHeartGraph;
+class UHeartGraphNode;
+
+namespace Heart::Evaluation
+{
+	// One node in a compiled program.
+	struct FInstruction
+	{
+		TWeakObjectPtr<UHeartGraphNode> Node;
+
+		// The node itself or its node object, whichever implements IHeartNodeEvaluator. Nodes without one are skipped.
+		TWeakInterfacePtr<IHeartNodeEvaluator> Evaluator;
+
+		// May the evaluator run on a worker thread?
+		bool ThreadSafe = false;
+
+		// Input pins are [InputBegin, InputEnd) in FProgram's input arrays.
+		int32 InputBegin = 0;
+		int32 InputEnd = 0;
+
+		// Output pins own the slots [OutputBegin, OutputEnd).
+		int32 OutputBegin = 0;
+		int32 OutputEnd = 0;
+
+		// Instructions reading any of this one's outputs are [DependentBegin, DependentEnd) in FProgram's dependents.
+		int32 DependentBegin = 0;
+		int32 DependentEnd = 0;
+	};
+
+	/**
+	 * A graph compiled into a flat list of instructions in topological order along output pins. Each output pin is given
+	 * a value slot, and each input pin is resolved to the slot of the output it's connected to, so evaluating the program
+	 * is a single loop over the instructions with no pin lookups.
+	 * Input pins read their first connection only. Bidirectional pins are treated as outputs.
+	 */
+	class HEART_API FProgram
+	{
+	public:
+		// Compile a graph. Fails, leaving the program empty, if the graph has a cycle. Game thread only.
+		bool Compile(const UHeartGraph* Graph);
+
+		void Reset();
+
+		// The graph topology version this was compiled from. See UHeartGraph::GetTopologyVersion.
+		uint64 GetVersion() const { return Version; }
+
+		int32 NumInstructions() const { return Instructions.Num(); }
+		int32 NumSlots() const { return OutputPins.Num(); }
+
+		const FInstruction& GetInstruction(const int32 Index) const { return Instructions[Index]; }
+
+		// Slot read by an input pin, or INDEX_NONE if it's unconnected.
+		int32 GetInputSlot(const int32 Input) const { return InputSlots[Input]; }
+		FName GetInputName(const int32 Input) const { return InputNames[Input]; }
+
+		// Output pin that owns a slot.
+		const FHeartGraphPinReference& GetOutputPin(const int32 Slot) const { return OutputPins[Slot]; }
+		FName GetOutputName(const int32 Slot) const { return OutputNames[Slot]; }
+
+		TConstArrayView<int32> GetDependents(const FInstruction& Instruction) const
+		{
+			return TConstArrayView<int32>(Dependents.GetData() + Instruction.DependentBegin, Instruction.DependentEnd - Instruction.DependentBegin);
+		}
+
+		// Instruction index of a node, or INDEX_NONE.
+		int32 FindInstruction(const FHeartNodeGuid& Node) const;
+
+		// Slot of an output pin, or INDEX_NONE.
+		int32 FindSlot(const FHeartGraphPinReference& Pin) const;
+
+		// Does an input read the same output pin as an input of another program?
+		bool SameSource(int32 Input, const FProgram& Other, int32 OtherInput) const;
+
+	private:
+		uint64 Version = 0;
+
+		TArray<FInstruction> Instructions;
+
+		// Per input pin
+		TArray<int32> InputSlots;
+		TArray<FName> InputNames;
+
+		// Per slot
+		TArray<FHeartGraphPinReference> OutputPins;
+		TArray<FName> OutputNames;
+
+		TArray<int32> Dependents;
+
+		TMap<FHeartNodeGuid, int32> InstructionLookup;
+		TMap<FHeartGraphPinReference, int32> SlotLookup;
+	};
+
+	/**
+	 * What an IHeartNodeEvaluator sees of the program while evaluating its node. Inputs and outputs are numbered in the
+	 * order of the node's pins of that direction.
+	 */
+	class HEART_API FNodeContext
+	{
+	public:
+		FNodeContext(const FProgram& Program, int32 Instruction, TArray<FBloodValue>& Slots);
+
+		UHeartGraphNode* GetNode() const;
+
+		int32 NumInputs() const { return Instruction.InputEnd - Instruction.InputBegin; }
+		int32 NumOutputs() const { return Instruction.OutputEnd - Instruction.OutputBegin; }
+
+		// Value arriving at an input, or an invalid value if it's unconnected or its source hasn't produced one.
+		const FBloodValue& GetInput(int32 Index) const;
+		const FBloodValue& GetInput(FName PinName) const;
+
+		bool IsInputConnected(int32 Index) const;
+
+		// Index of an input or output by pin name, or INDEX_NONE.
+		int32 FindInput(FName PinName) const;
+		int32 FindOutput(FName PinName) const;
+
+		// Store an output value. Nodes reading it are only re-evaluated if the value differs from the last one.
+		void SetOutput(int32 Index, FBloodValue&& Value);
+		void SetOutput(FName PinName, FBloodValue&& Value);
+
+		// Did any call to SetOutput change a value?
+		bool HasChangedOutputs() const { return ChangedOutputs; }
+
+	private:
+		const FProgram& Program;
+		const FInstruction& Instruction;
+		TArray<FBloodValue>& Slots;
+		bool ChangedOutputs = false;
+	};
+}
@@ -0,0 +1,33 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/Interface.h"
+#include "HeartNodeEvaluator.generated.h"
+
+namespace Heart::Evaluation
+{
+	class FNodeContext;
+}
+
+UINTERFACE(NotBlueprintable)
+class UHeartNodeEvaluator : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Native evaluation of a node's outputs from its inputs, for UHeartGraphEvaluator. Implement on either a node class or
+ * a node object class.
+ */
+class HEART_API IHeartNodeEvaluator
+{
+	GENERATED_BODY()
+
+public:
+	// Read inputs from the context, and write every output. Only called when an input has changed, or the node was marked dirty.
+	virtual void EvaluateNode(Heart::Evaluation::FNodeContext& Context) const PURE_VIRTUAL(IHeartNodeEvaluator::EvaluateNode, )
+
+	// Can EvaluateNode run on a worker thread? Only return true if it touches nothing but the context and immutable data.
+	virtual bool IsEvaluationThreadSafe() const { return false; }
+};
@@ -0,0 +1,29 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Guid.h"
+
+// Custom serialization version for changes to Heart's native serialization.
+struct HEART_API FHeartCustomVersion
+{
+	enum Type
+	{
+		// Before any version changes were made.
+		BeforeCustomVersionWasAdded = 0,
+
+		// Pin connections serialize natively, with compact pin ids, instead of as tagged properties. Loading tells the
+		// formats apart from the data, so this isn't checked, but stays registered for packages that were saved with it.
+		NativePinConnections,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// The GUID for this custom version number
+	const static FGuid GUID;
+
+private:
+	FHeartCustomVersion() = delete;
+};
\ No newline at end of file
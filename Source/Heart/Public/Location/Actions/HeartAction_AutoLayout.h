@@ -2,17 +2,28 @@
 
 #pragma once
 
+#include "Model/HeartGuids.h"
 #include "ModelView/Actions/HeartGraphAction.h"
 #include "HeartAction_AutoLayout.generated.h"
 
+class UHeartLayoutHelper;
+
 /**
- *
+ * Lays out every node in the graph with the layout helper given as the context object. Layouts that support it run
+ * as a UHeartLayoutJob, which records this action in the history once it finishes, instead of when it starts.
+ * Both the original and laid out locations are recorded, so Redo restores the same result without running the layout.
  */
 UCLASS()
 class HEART_API UHeartAction_AutoLayout : public UHeartGraphAction
 {
 	GENERATED_BODY()
 
+public:
+	// Record a layout that was applied outside of this action's Execute, such as by a UHeartLayoutJob, in the graph's
+	// action history, if it has one, so that it can be undone and redone.
+	static void RecordLayout(TNotNull<UHeartGraph*> Graph, UHeartLayoutHelper* Layout,
+							 const TMap<FHeartNodeGuid, FVector2D>& OriginalLocations, const TMap<FHeartNodeGuid, FVector2D>& LayoutLocations);
+
 protected:
 	virtual bool CanExecute(const UObject* Target) const override;
 	virtual FHeartEvent ExecuteOnGraph(TNotNull<UHeartGraph*> Graph, const FHeartInputActivation& Activation, UObject* ContextObject, FBloodContainer& UndoData) const override;
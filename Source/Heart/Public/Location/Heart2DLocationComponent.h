@@ -4,6 +4,7 @@
 
 #include "HeartNodeLocationComponentBase.h"
 #include "HeartNodeLocationInterface.h"
+#include "Model/HeartNodeIndex.h"
 #include "Heart2DLocationComponent.generated.h"
 
 /**
@@ -21,6 +22,10 @@ public:
 	virtual FVector2D GetNodeLocation(const FHeartNodeGuid& Node) const override;
 	virtual void SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location, bool InProgressMove) override;
 
+	// Access by node handle, skipping the guid lookup.
+	FVector2D GetNodeLocationAtIndex(FHeartNodeIndex Index) const;
+	void SetNodeLocationAtIndex(FHeartNodeIndex Index, const FVector2D& Location);
+
 protected:
 	UPROPERTY(VisibleAnywhere, Category = "2DLocationComponent")
 	TArray<FVector2D> Locations;
@@ -4,6 +4,7 @@
 
 #include "HeartNodeLocationComponentBase.h"
 #include "HeartNodeLocationInterface.h"
+#include "Model/HeartNodeIndex.h"
 #include "Heart3DLocationComponent.generated.h"
 
 /**
@@ -24,6 +25,10 @@ public:
 	virtual FVector GetNodeLocation3D(const FHeartNodeGuid& Node) const override;
 	virtual void SetNodeLocation3D(const FHeartNodeGuid& Node, const FVector& Location, bool InProgressMove) override;
 
+	// Access by node handle, skipping the guid lookup.
+	FVector GetNodeLocationAtIndex(FHeartNodeIndex Index) const;
+	void SetNodeLocationAtIndex(FHeartNodeIndex Index, const FVector& Location);
+
 protected:
 	UPROPERTY(VisibleAnywhere, Category = "2DLocationComponent")
 	TArray<FVector> Locations;
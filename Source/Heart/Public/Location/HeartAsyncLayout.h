@@ -0,0 +1,55 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+namespace Heart::Layout
+{
+	/**
+	 * Everything a layout running on a worker thread may touch: a copy of the nodes' adjacency and locations taken when
+	 * the job started, a cancellation flag, and a mailbox for intermediate frames. Shared between the job on the game
+	 * thread, and the layout on its worker.
+	 */
+	class HEART_API FAsyncLayoutContext
+	{
+	public:
+		FAsyncLayoutContext(TArray<TArray<int32>>&& InAdjacencyList, TArray<FVector2D>&& InStartPositions);
+
+		// Adjacency of the nodes, by their index in the job's node array.
+		const TArray<TArray<int32>>& GetAdjacencyList() const { return AdjacencyList; }
+
+		// Node locations when the job started.
+		const TArray<FVector2D>& GetStartPositions() const { return StartPositions; }
+
+		int32 Num() const { return StartPositions.Num(); }
+
+		// Layouts should check this between steps, and return early once it is set.
+		bool IsCancelled() const { return Cancelled.load(std::memory_order_relaxed); }
+		void Cancel() { Cancelled.store(true, std::memory_order_relaxed); }
+
+		// Publish intermediate positions, one per node, for the game thread to move toward. Only the latest frame is
+		// kept; a frame that hasn't been consumed yet is replaced.
+		void PublishFrame(TConstArrayView<FVector2D> Positions);
+
+		// Take the latest published frame. Returns false if nothing was published since the last call.
+		bool ConsumeFrame(TArray<FVector2D>& OutPositions);
+
+	private:
+		const TArray<TArray<int32>> AdjacencyList;
+		const TArray<FVector2D> StartPositions;
+
+		std::atomic<bool> Cancelled = false;
+
+		FCriticalSection FrameLock;
+		TArray<FVector2D> Frame;
+		bool HasNewFrame = false;
+	};
+
+	// A layout to run on a worker thread. Returns the final positions, one per node, or an empty array to discard the
+	// result. Must not touch any UObject.
+	using FAsyncLayoutFunction = TUniqueFunction<TArray<FVector2D>(FAsyncLayoutContext& Context)>;
+}
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Location/HeartAsyncLayout.h"
 #include "UObject/Object.h"
 #include "HeartLayoutHelper.generated.h"
 
@@ -40,11 +41,33 @@ public:
 	bool Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface);
 	bool Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface, float DeltaTime);
 
-protected:
+	// Override to support running on a worker thread, with UHeartLayoutJob. Settings should be copied into the returned
+	// function, as it must not touch this object, or any other UObject. Returns an empty function if the layout can
+	// only run on the game thread.
+	virtual Heart::Layout::FAsyncLayoutFunction MakeAsyncLayout() const { return {}; }
+
+	// Should UHeartAction_AutoLayout run this layout as a UHeartLayoutJob, if it supports it, instead of blocking.
+	bool GetRunAsync() const { return RunAsync; }
+
 	static FHeartGraphAdjacencyList GetGraphAdjacencyList(const TNotNull<UHeartGraph*> Graph, const TArray<FHeartNodeGuid>& Nodes);
 
+protected:
+	// Is there time left in this frame's budget, since StartSeconds, as measured by FPlatformTime::Seconds.
+	bool IsWithinFrameBudget(double StartSeconds) const;
+
 	UFUNCTION(BlueprintCallable, Category = "Heart|LayoutHelper")
 	void ApplyNewPositions(const TScriptInterface<IHeartNodeLocationInterface>& Interface, const TArray<FHeartNodeGuid>& Nodes, const TArray<FVector2D>& NewPositions) const;
+
+	// Time that a layout running on tick may spend each frame. Iterative layouts run as many steps as fit, instead of
+	// a fixed number, but always at least one. Zero disables the budget.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Budget", meta = (ClampMin = 0, Units = "ms"))
+	float FrameBudget = 0.f;
+
+	// Run as a UHeartLayoutJob when laid out by UHeartAction_AutoLayout, if this layout supports it. The graph is
+	// updated once the job finishes, and the editor or game keeps running in the meantime. Off by default, so
+	// existing layouts keep applying in the same frame they are run.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Async")
+	bool RunAsync = false;
 };
 
 UCLASS(Abstract, Blueprintable, MinimalAPI)
@@ -0,0 +1,122 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Model/HeartGuids.h"
+#include "Tasks/Task.h"
+#include "UObject/Object.h"
+#include "HeartLayoutJob.generated.h"
+
+namespace Heart::Layout
+{
+	class FAsyncLayoutContext;
+}
+
+struct FHeartGraphConnectionEvent;
+struct FHeartNodeAddOrRemoveEvent;
+class UHeartGraph;
+class UHeartLayoutHelper;
+class UHeartLayoutJob;
+
+UENUM(BlueprintType)
+enum class EHeartLayoutJobState : uint8
+{
+	Running,
+
+	// The final positions were applied to the graph.
+	Committed,
+
+	// Cancelled by request, or because nodes or connections changed while running.
+	Cancelled,
+
+	// The layout returned no result, or the graph went away.
+	Failed
+};
+
+using FHeartLayoutJobFrame = TMulticastDelegate<void(UHeartLayoutJob*)>;
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FHeartLayoutJobFrame_BP, UHeartLayoutJob*, Job);
+
+using FHeartLayoutJobFinished = TMulticastDelegate<void(UHeartLayoutJob*, EHeartLayoutJobState)>;
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHeartLayoutJobFinished_BP, UHeartLayoutJob*, Job, EHeartLayoutJobState, State);
+
+/**
+ * Runs a layout helper on a worker thread, without blocking the game thread. The nodes' adjacency and locations are
+ * copied when the job starts. While running, the layout may publish intermediate frames, which are handed to OnFrame
+ * for a canvas or scene to move toward, but are not applied to the graph. Adding or removing nodes, or changing
+ * connections, cancels the job. Once the layout finishes, its final positions are applied to the graph in a single
+ * transaction, and recorded in the graph's action history, if it has one, so the layout can be undone.
+ */
+UCLASS(BlueprintType)
+class HEART_API UHeartLayoutJob : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Start laying out these nodes of the graph, or all of them if empty. Returns nullptr if the layout helper doesn't
+	// support running asynchronously.
+	static UHeartLayoutJob* Start(TNotNull<UHeartGraph*> Graph, TNotNull<UHeartLayoutHelper*> Layout, const TArray<FHeartNodeGuid>& NodesToLayout = {});
+
+	UFUNCTION(BlueprintCallable, Category = "Heart|LayoutJob", meta = (DisplayName = "Start Layout Job"))
+	static UHeartLayoutJob* StartLayoutJob(UHeartGraph* Graph, UHeartLayoutHelper* Layout, const TArray<FHeartNodeGuid>& NodesToLayout);
+
+	// Stop the job. Nothing is applied to the graph.
+	UFUNCTION(BlueprintCallable, Category = "Heart|LayoutJob")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "Heart|LayoutJob")
+	EHeartLayoutJobState GetState() const { return State; }
+
+	UFUNCTION(BlueprintPure, Category = "Heart|LayoutJob")
+	bool IsRunning() const { return State == EHeartLayoutJobState::Running; }
+
+	// The nodes being laid out. Frames and results are in the same order.
+	const TArray<FHeartNodeGuid>& GetNodes() const { return Nodes; }
+
+	// The most recent frame published by the layout, or the final positions once committed.
+	const TArray<FVector2D>& GetLatestFrame() const { return LatestFrame; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Heart|LayoutJob")
+	void GetLatestFrame(TMap<FHeartNodeGuid, FVector2D>& Positions) const;
+
+	FHeartLayoutJobFrame::RegistrationType& GetOnFrame() { return OnFrameNative; }
+	FHeartLayoutJobFinished::RegistrationType& GetOnFinished() { return OnFinishedNative; }
+
+protected:
+	virtual void BeginDestroy() override;
+
+	bool Tick(float DeltaTime);
+
+	void OnNodeAddOrRemove(const FHeartNodeAddOrRemoveEvent& Event);
+	void OnNodeConnectionsChanged(const FHeartGraphConnectionEvent& Event);
+
+	void Commit(UHeartGraph* TargetGraph, TArray<FVector2D>&& Result);
+	void Finish(EHeartLayoutJobState NewState);
+
+	/**		EVENTS		**/
+	FHeartLayoutJobFrame OnFrameNative;
+	FHeartLayoutJobFinished OnFinishedNative;
+
+	UPROPERTY(BlueprintAssignable, Transient, Category = "Events")
+	FHeartLayoutJobFrame_BP OnFrame;
+
+	UPROPERTY(BlueprintAssignable, Transient, Category = "Events")
+	FHeartLayoutJobFinished_BP OnFinished;
+
+private:
+	UPROPERTY()
+	TWeakObjectPtr<UHeartGraph> WeakGraph;
+
+	// Passed as the payload of the action history record, to show which layout produced it.
+	UPROPERTY()
+	TObjectPtr<UHeartLayoutHelper> LayoutHelper;
+
+	TArray<FHeartNodeGuid> Nodes;
+	TArray<FVector2D> LatestFrame;
+
+	TSharedPtr<Heart::Layout::FAsyncLayoutContext> Context;
+	UE::Tasks::TTask<TArray<FVector2D>> Task;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	EHeartLayoutJobState State = EHeartLayoutJobState::Running;
+};
@@ -16,17 +16,43 @@ class HEART_API UHeartLayout_FruchtermanReingold : public UHeartLayoutHelper
 
 public:
 	virtual bool Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface, const TArray<FHeartNodeGuid>& Nodes, float DeltaTime) override;
+	virtual Heart::Layout::FAsyncLayoutFunction MakeAsyncLayout() const override;
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
 	double Strength = 300.0;
 
+	// Steps to run per second, when there is no frame budget.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (UIMin = 1, UIMax = 300))
 	int32 IterationsPerSecond = 60;
 
+	// Approximate repulsion between nodes with a Barnes-Hut quadtree, which scales to thousands of nodes. When disabled,
+	// every pair of nodes is compared, and pairs further than 1000 units apart are ignored.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
+	bool UseBarnesHut = false;
+
+	// Accuracy of the Barnes-Hut approximation. Lower is more accurate, but slower.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (EditCondition = "UseBarnesHut", ClampMin = 0.1, UIMax = 2.0))
+	double Theta = 0.8;
+
+	// Steps to run when laid out by a UHeartLayoutJob.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Async", meta = (ClampMin = 1, UIMax = 1000))
+	int32 AsyncIterations = 300;
+
+	// Split each step across worker threads. The result is the same regardless of how many threads there are.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
+	bool RunInParallel = false;
+
+	// Run the force kernels one node at a time instead of four. Only useful to validate the vectorized kernels.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Config")
+	bool UseScalarKernels = false;
+
 	FHeartGraphAdjacencyList AdjacencyList;
 
 	TOptional<Nodesoup::FruchtermanReingold> Algorithm;
 
+	// Node positions while iterating, split into X and Y for the force kernels.
+	Nodesoup::FLayoutPositions LayoutPositions;
+
 	float Accum = 0;
 };
\ No newline at end of file
@@ -6,7 +6,8 @@
 #include "HeartLayout_KamadaKawai.generated.h"
 
 /**
- * A simple layout implementation for a one-shot Kamada-Kawai run.
+ * A simple layout implementation for a one-shot Kamada-Kawai run. Large graphs use the sparse stress model instead,
+ * which approximates the same layout without springs between every pair of nodes.
  */
 UCLASS(DisplayName = "Heart Layout Kamada-Kawai")
 class HEART_API UHeartLayout_KamadaKawai : public UHeartLayoutHelper
@@ -16,6 +17,9 @@ class HEART_API UHeartLayout_KamadaKawai : public UHeartLayoutHelper
 public:
 	virtual bool Layout(TNotNull<UHeartGraph*> Graph, IHeartNodeLocationInterface& Interface, const TArray<FHeartNodeGuid>& Nodes) override;
 
+	// Only the sparse stress model streams frames, and can be cancelled between steps. Kamada-Kawai only reports its result.
+	virtual Heart::Layout::FAsyncLayoutFunction MakeAsyncLayout() const override;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
 	int32 Width = 200;
@@ -28,4 +32,20 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
 	double EnergyThreshold = 0.01;
+
+	// Graphs with more nodes than this use the sparse stress model. Kamada-Kawai keeps two floats per pair of nodes, and
+	// its steps grow with the square of the node count.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Sparse Stress", meta = (ClampMin = 0))
+	int32 SparseStressThreshold = 500;
+
+	// Nodes that stand in for the rest of the graph in the sparse stress model. More is more accurate, but slower.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Sparse Stress", meta = (ClampMin = 2, UIMax = 200))
+	int32 SparseStressPivots = 50;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Sparse Stress", meta = (ClampMin = 1, UIMax = 1000))
+	int32 SparseStressIterations = 200;
+
+	// Run the force kernels one node at a time instead of four. Only useful to validate the vectorized kernels.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "Config")
+	bool UseScalarKernels = false;
 };
\ No newline at end of file
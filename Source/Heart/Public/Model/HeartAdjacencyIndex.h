@@ -0,0 +1,138 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartNodeIndex.h"
+#include "Model/HeartPinDirection.h"
+
+class UHeartGraph;
+class UHeartGraphNode;
+
+namespace Heart::Graph
+{
+	// A link from a node to one of its neighbors, through any number of pin connections.
+	struct FAdjacencyEdge
+	{
+		FHeartNodeIndex Node;
+
+		// Number of pin connections between the two nodes in this direction.
+		int32 Links = 0;
+	};
+
+	/**
+	 * Compressed-sparse-row index of node-to-node connections, maintained by FPinEdit and FNodeEdit.
+	 * Each node owns a segment of a flat edge array per direction. Segments are given slack when they grow, so updating
+	 * a node only rewrites its own segment. Once enough space has been abandoned, the array is compacted back into a
+	 * strict CSR layout.
+	 *
+	 * The edges of a node are derived only from its own pins: a neighbor linked through an Output pin is an out-edge,
+	 * one linked through an Input pin is an in-edge, and Bidirectional pins contribute both.
+	 */
+	class HEART_API FAdjacencyIndex
+	{
+	public:
+		// Out-edges that appeared or disappeared while updating nodes.
+		struct FEdgeChanges
+		{
+			TArray<TPair<FHeartNodeIndex, FHeartNodeIndex>, TInlineAllocator<4>> Added;
+			int32 NumRemoved = 0;
+		};
+
+		// Rebuild the index for every node in a graph.
+		void Rebuild(const UHeartGraph* Graph);
+
+		// Re-derive the edges of a single node from its pin data.
+		void UpdateNode(const UHeartGraph* Graph, const UHeartGraphNode* Node, FEdgeChanges* OutChanges = nullptr);
+
+		// Release the edges of a node being removed from the graph.
+		void RemoveNode(FHeartNodeIndex Node);
+
+		void Reset();
+
+		// Reserve storage for node slots up to MaxSlot.
+		void Reserve(int32 MaxSlot);
+
+		// Neighbors of a node, sorted by node slot. Direction must be either Input or Output.
+		TConstArrayView<FAdjacencyEdge> GetEdges(FHeartNodeIndex Node, EHeartPinDirection Direction) const;
+
+		TConstArrayView<FAdjacencyEdge> GetInEdges(const FHeartNodeIndex Node) const { return GetEdges(Node, EHeartPinDirection::Input); }
+		TConstArrayView<FAdjacencyEdge> GetOutEdges(const FHeartNodeIndex Node) const { return GetEdges(Node, EHeartPinDirection::Output); }
+
+		/**
+		 * Visit each unique neighbor of a node in the direction(s), without allocating. Neighbors are visited in slot order,
+		 * and nodes linked both ways are only visited once for Bidirectional.
+		 * Return true in Iter to continue iterating.
+		 */
+		template <typename Func>
+		void ForEachNeighbor(const FHeartNodeIndex Node, const EHeartPinDirection Direction, Func&& Iter) const
+		{
+			const TConstArrayView<FAdjacencyEdge> In = EnumHasAnyFlags(Direction, EHeartPinDirection::Input) ? GetInEdges(Node) : TConstArrayView<FAdjacencyEdge>();
+			const TConstArrayView<FAdjacencyEdge> Out = EnumHasAnyFlags(Direction, EHeartPinDirection::Output) ? GetOutEdges(Node) : TConstArrayView<FAdjacencyEdge>();
+
+			// Both ranges are sorted, so a merge walk visits their union.
+			int32 i = 0, o = 0;
+			while (i < In.Num() || o < Out.Num())
+			{
+				FHeartNodeIndex Next;
+				if (o >= Out.Num() || (i < In.Num() && In[i].Node.Index < Out[o].Node.Index))
+				{
+					Next = In[i++].Node;
+				}
+				else if (i >= In.Num() || Out[o].Node.Index < In[i].Node.Index)
+				{
+					Next = Out[o++].Node;
+				}
+				else
+				{
+					Next = In[i++].Node;
+					o++;
+				}
+
+				if (!Iter(Next))
+				{
+					return;
+				}
+			}
+		}
+
+		// Is Neighbor in the edges of Node for a direction (Input or Output)?
+		bool HasEdge(FHeartNodeIndex Node, FHeartNodeIndex Neighbor, EHeartPinDirection Direction) const;
+
+		// Total number of edges stored for a direction (Input or Output).
+		int32 NumEdges(EHeartPinDirection Direction) const;
+
+		// Upper bound of the node slots in the index.
+		int32 GetMaxIndex() const { return Owners.Num(); }
+
+		// Get the handle of the node occupying a slot, or an invalid handle if the slot is empty.
+		FHeartNodeIndex GetNodeAt(const int32 Slot) const { return Owners[Slot]; }
+
+	private:
+		struct FSegment
+		{
+			int32 Offset = 0;
+			int32 Num = 0;
+			int32 Capacity = 0;
+		};
+
+		struct FEdgeList
+		{
+			TArray<FSegment> Segments;
+			TArray<FAdjacencyEdge> Edges;
+			int32 NumEdges = 0;
+			int32 Abandoned = 0;
+		};
+
+		static int32 DirectionToList(EHeartPinDirection Direction);
+
+		void AddSlots(int32 MaxSlot);
+		void WriteSegment(FEdgeList& List, int32 Slot, TConstArrayView<FAdjacencyEdge> NewEdges);
+		static void Compact(FEdgeList& List);
+
+		// The node handle each slot was last written for, used to reject stale handles.
+		TArray<FHeartNodeIndex> Owners;
+
+		// Indexed by DirectionToList
+		FEdgeList Lists[2];
+	};
+}
@@ -0,0 +1,43 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Algorithms/GraphAlgorithms.h"
+#include "HeartGuids.h"
+#include "Model/HeartPinDirection.h"
+
+class UHeartGraph;
+
+namespace Heart::Graph
+{
+	/**
+	 * A snapshot of a graph's connections as a flat FCsrGraph, for running Heart::Algorithms, along with the mapping
+	 * between vertices and nodes. Vertices are numbered in node slot order. Edges follow the given direction, and weigh
+	 * the number of pin connections between the two nodes, or 1 for Bidirectional.
+	 */
+	class HEART_API FAlgorithmGraph
+	{
+	public:
+		FAlgorithmGraph(const UHeartGraph* Graph, EHeartPinDirection Direction = EHeartPinDirection::Output);
+
+		const Algorithms::FCsrGraph& GetCsr() const { return Csr; }
+		Algorithms::FCsrGraph& GetCsr() { return Csr; }
+
+		// Get the vertex of a node, or INDEX_NONE if it is not in the graph.
+		int32 FindVertex(const FHeartNodeGuid& Node) const;
+
+		const FHeartNodeGuid& GetNode(const int32 Vertex) const { return Nodes[Vertex]; }
+
+		TArray<FHeartNodeGuid> ToNodes(TConstArrayView<int32> Vertices) const;
+
+	private:
+		const UHeartGraph* Graph;
+		Algorithms::FCsrGraph Csr;
+
+		// Node of each vertex
+		TArray<FHeartNodeGuid> Nodes;
+
+		// Vertex of each node slot, or INDEX_NONE for empty slots
+		TArray<int32> SlotToVertex;
+	};
+}
@@ -7,8 +7,16 @@
 #include "HeartGraphNodeComponent.h"
 #include "HeartGuids.h"
 #include "HeartGraphTypes.h"
+#include "HeartGraphChangeSet.h"
+#include "HeartGraphSnapshot.h"
 #include "HeartGraphPinReference.h"
 #include "HeartNodeIndex.h"
+#include "HeartNodeSlotMap.h"
+#include "HeartAdjacencyIndex.h"
+#include "HeartTopologicalOrder.h"
+#include "HeartNodeComponentIndex.h"
+#include "HeartNodeLookupIndex.h"
+#include "HeartReachabilityIndex.h"
 #include "HeartNodeQuery.h"
 #include "Location/HeartNodeLocationInterface.h" // @todo temp, while refactoring node location logic
 #include "Templates/SubclassOf.h"
@@ -19,6 +27,7 @@ namespace Heart::API
 {
 	class FNodeEdit;
 	class FPinEdit;
+	class FGraphTransaction;
 }
 
 class UHeartGraph;
@@ -34,6 +43,7 @@ namespace Heart::Events
 	using FNodeAddOrRemove = TMulticastDelegate<void(const FHeartNodeAddOrRemoveEvent&)>;
 	using FNodeMoveEventHandler = TMulticastDelegate<void(const FHeartNodeMoveEvent&)>;
 	using FConnectionEventHandler = TMulticastDelegate<void(const FHeartGraphConnectionEvent&)>;
+	using FGraphChangeSetHandler = TMulticastDelegate<void(const FHeartGraphChangeSet&)>;
 
 	enum EComponentEventType
 	{
@@ -86,6 +96,8 @@ class HEART_API UHeartGraph : public UObject, public IHeartGraphInterface
 	friend UHeartGraphSchema;
 	friend Heart::API::FNodeEdit;
 	friend Heart::API::FPinEdit;
+	friend Heart::API::FGraphTransaction;
+	friend UHeartGraphNode; // Keeps the node lookup index in sync with its pins
 
 public:
 	UHeartGraph();
@@ -101,8 +113,23 @@ public:
 	virtual void PostInitProperties() override;
 	virtual void PostLoad() override;
 	virtual void PostDuplicate(EDuplicateMode::Type DuplicateMode) override;
+	virtual void BeginDestroy() override;
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+#endif
 	/* UObject */
 
+private:
+	// Rebuild all transient lookup data derived from the serialized node state.
+	void RebuildIndexes();
+
+#if WITH_EDITOR
+	// Indexes keyed by class would still list reinstanced nodes under their old classes.
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+	FDelegateHandle ObjectsReinstancedHandle;
+#endif
+
 private:
 	/* IHeartGraphInterface */
 	FORCEINLINE virtual UHeartGraph* GetHeartGraph_Implementation() const override final { return const_cast<ThisClass*>(this); }
@@ -139,6 +166,35 @@ protected:
 	// Called after a pin connection change has been made. Called by Heart::Connections::~FEdit
 	virtual void HandleGraphConnectionEvent(const FHeartGraphConnectionEvent& Event);
 
+	// Called once when the outermost FGraphTransaction closes, after the consolidated individual events.
+	virtual void HandleGraphChangeSet(const FHeartGraphChangeSet& ChangeSet);
+
+public:
+	// Is an FGraphTransaction open on this graph? Events are being collected rather than broadcast if so.
+	bool IsInTransaction() const { return TransactionDepth > 0; }
+
+	// Used by location components to hold back a node's location delegates until the transaction closes.
+	// Returns false if no transaction is open, and the caller should broadcast immediately.
+	bool DeferNodeLocationChanged(const FHeartNodeGuid& Node);
+
+private:
+	void MarkChanged() { ++Version; ++TopologyVersion; }
+
+	// Node locations don't affect the topology, so moves only bump Version.
+	void MarkMoved() { ++Version; }
+
+	// These either pass the event straight to the Handle functions, or add it to the pending change set.
+	void DispatchNodeAddOrRemoveEvent(const FHeartNodeAddOrRemoveEvent& Event);
+	void DispatchNodeMoveEvent(const FHeartNodeMoveEvent& Event);
+	void DispatchGraphConnectionEvent(const FHeartGraphConnectionEvent& Event);
+	void DispatchNodeComponentEvent(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component, Heart::Events::EComponentEventType Type);
+
+	// Deliver everything collected during a transaction.
+	void FlushChangeSet();
+
+	// Grow node storage and indexes to fit this many more nodes.
+	void ReserveNodes(int32 Number);
+
 
 	/*-----------------------
 			GETTERS
@@ -152,6 +208,7 @@ public:
 	Heart::Events::FNodeAddOrRemove::RegistrationType& GetOnNodeAddOrRemove() { return OnNodeAddOrRemove; }
 	Heart::Events::FNodeMoveEventHandler::RegistrationType& GetOnNodeMoved() { return OnNodeMoved; }
 	Heart::Events::FConnectionEventHandler::RegistrationType& GetOnNodeConnectionsChanged() { return OnNodeConnectionsChanged; }
+	Heart::Events::FGraphChangeSetHandler::RegistrationType& GetOnGraphChanged() { return OnGraphChanged; }
 
 	Heart::Events::FGraphExtensionAddOrRemove::RegistrationType& GetOnExtensionAddOrRemove() { return OnExtensionAddOrRemove; }
 	Heart::Events::FNodeComponentAddOrRemove::RegistrationType& GetOnNodeComponentAddOrRemove() { return OnComponentAddOrRemove; }
@@ -162,6 +219,50 @@ public:
 	FHeartNodeIndex GetNodeIndex(const FHeartNodeGuid& Node) const;
 	FHeartNodeGuid GetNodeGuidFromIndex(FHeartNodeIndex NodeIndex) const;
 
+	// Resolve a node handle in O(1). Returns nullptr if the node at this index has been removed.
+	UHeartGraphNode* ResolveNode(const FHeartNodeIndex NodeIndex) const { return NodeSlots.Resolve(NodeIndex); }
+	bool IsValidNodeIndex(const FHeartNodeIndex NodeIndex) const { return NodeSlots.IsValidIndex(NodeIndex); }
+
+	// Slot storage of all nodes. Prefer iterating this over GetNodes when the guid isn't needed.
+	const FHeartNodeSlotMap& GetNodeSlots() const { return NodeSlots; }
+
+	// Flat index of node-to-node connections, for traversal without walking pin data.
+	const Heart::Graph::FAdjacencyIndex& GetAdjacency() const { return Adjacency; }
+
+	// Incrementally maintained topological order of the nodes, following output pins.
+	const Heart::Graph::FTopologicalOrder& GetTopologicalOrder() const { return TopologicalOrder; }
+
+	// Incremented by every change to nodes, pins, connections, components, or locations. Not serialized.
+	uint64 GetVersion() const { return Version; }
+
+	// As GetVersion, but not incremented by node location changes. Use this for anything built from the nodes, pins,
+	// and connections alone, so dragging or laying out nodes doesn't invalidate it.
+	uint64 GetTopologyVersion() const { return TopologyVersion; }
+
+	// Get an immutable copy of the graph that can be read from other threads. Returns the same snapshot for as long as
+	// the graph is unchanged. Game thread only.
+	FHeartGraphSnapshotRef GetSnapshot() const;
+
+	// Lookup of nodes by class, node object class, and pin tag. Only available if the schema opts in, otherwise nullptr.
+	// Off the game thread, also nullptr if the index hasn't been built yet.
+	const Heart::Graph::FNodeLookupIndex* GetNodeLookupIndex() const;
+
+	// Reachability along output pins. Only available if the schema opts in and the graph is acyclic, otherwise nullptr.
+	const Heart::Graph::FReachabilityIndex* GetReachabilityIndex() const;
+
+	// Is there a path of one or more connections from the outputs of From to To? Uses the reachability index if
+	// available, otherwise searches.
+	bool IsNodeReachable(FHeartNodeIndex From, FHeartNodeIndex To) const;
+
+	// Get every node reachable from the outputs of From, as a bit per node slot (see GetNodeSlots).
+	void GetReachableNodes(FHeartNodeIndex From, TBitArray<>& OutSlots) const;
+
+	// Would a connection from an output of one node to an input of another create a cycle?
+	bool WouldEdgeCreateCycle(FHeartNodeIndex From, FHeartNodeIndex To) const;
+
+	// Would connecting these two pins create a cycle? Edges are directed away from Output pins.
+	bool WouldConnectionCreateCycle(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB) const;
+
 	template <Heart::CGraphNode T>
 	T* GetNode(const FHeartNodeGuid& NodeGuid) const
 	{
@@ -303,7 +404,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Heart|Graph", Meta = (DeterminesOutputType = "Class", DisplayName = "Get Node Component"))
 	UHeartGraphNodeComponent* GetNodeComponent(const FHeartNodeGuid& Node, TSubclassOf<UHeartGraphNodeComponent> Class) const;
 
-	/** Finds all components for a node. (Iterates over all components; may be slow if graph has many node components!) */
+	/** Finds all components for a node. */
 	UFUNCTION(BlueprintCallable, Category = "Heart|Graph")
 	TArray<UHeartGraphNodeComponent*> GetNodeComponentsForNode(const FHeartNodeGuid& Node) const;
 
@@ -335,10 +436,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Heart|Graph", Meta = (DeterminesOutputType = "Class"))
 	UHeartGraphNodeComponent* FindOrAddNodeComponent(const FHeartNodeGuid& Node, UPARAM(meta = (AllowAbstract = "false")) TSubclassOf<UHeartGraphNodeComponent> Class);
 
-	// Caution: Slow lookup of node component if all we have is the component's Node and Guid.
 	UHeartGraphNodeComponent* FindNodeComponentByGuid(const FHeartNodeGuid& Node, const FHeartExtensionGuid& ExtensionGuid) const;
 
-	// Caution: Slow lookup of node component if all we have is the component's Class and Guid.
+	// Find a component by guid among those of exactly Class. Components of subclasses of Class aren't matched.
 	void FindNodeComponentByGuid(const TSubclassOf<UHeartGraphNodeComponent>& Class, const FHeartExtensionGuid& ExtensionGuid, FHeartNodeGuid& OutNode, UHeartGraphNodeComponent*& OutNodeComponent) const;
 
 	/** Remove a node component of a class. */
@@ -355,6 +455,17 @@ public:
 	void RemoveComponentsForNode(const FHeartNodeGuid& Node);
 	void RemoveComponentsForNodes(TConstArrayView<FHeartNodeGuid> InNodes);
 
+private:
+	// Instance a node's default components into the graph.
+	void AddDefaultNodeComponents(const UHeartGraphNode* Node);
+
+	// Instance the default components of many nodes, sizing the component maps once for the whole batch.
+	void AddDefaultNodeComponents(TConstArrayView<UHeartGraphNode*> InNodes);
+
+	void AddNodeComponent(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component);
+
+public:
+
 
 	/*----------------------------
 			PIN DATA
@@ -392,9 +503,21 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Graph", DisplayName = "Schema Override")
 	TSubclassOf<UHeartGraphSchema> SchemaClass;
 
+	// Owns the nodes, and provides lookup by guid. Internally, nodes are addressed by NodeSlots instead.
 	UPROPERTY(Instanced, VisibleAnywhere, Category = "Graph")
 	TMap<FHeartNodeGuid, TObjectPtr<UHeartGraphNode>> Nodes;
 
+	UPROPERTY()
+	FHeartNodeSlotMap NodeSlots;
+
+	// Nodes put in the map without going through FNodeEdit, such as by an edit to the property, have no slot until the
+	// next RebuildIndexes. Until then, iteration falls back to the map, so they aren't skipped.
+	bool AreNodeSlotsInSync() const { return NodeSlots.Num() == Nodes.Num(); }
+
+	Heart::Graph::FAdjacencyIndex Adjacency;
+
+	Heart::Graph::FTopologicalOrder TopologicalOrder;
+
 	UPROPERTY(Instanced, VisibleAnywhere, Category = "Graph")
 	TObjectPtr<UHeartNodeLocationComponentBase> NodeLocationComponent;
 
@@ -410,9 +533,38 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Components")
 	TMap<TSubclassOf<UHeartGraphNodeComponent>, FHeartGraphNodeComponentMap> NodeComponents;
 
+	// Lookups into NodeComponents by node and by guid
+	Heart::Graph::FNodeComponentIndex NodeComponentIndex;
+
+	// Lookups of nodes by class and pin tag. Built on first use.
+	mutable Heart::Graph::FNodeLookupIndex NodeLookupIndex;
+
+	// Set by FNodeEdit while a batch of new nodes builds its pins, so the batch marks the graph changed only once.
+	bool DeferPinUpdates = false;
+
+	// Transitive closure, or labels, of the adjacency. Built on first use.
+	mutable Heart::Graph::FReachabilityIndex Reachability;
+
+	uint64 Version = 0;
+	uint64 TopologyVersion = 0;
+
+	// The last snapshot taken, handed out again until Version changes.
+	mutable TSharedPtr<const FHeartGraphSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
+	// Number of open FGraphTransactions.
+	int32 TransactionDepth = 0;
+
+	// Changes collected while a transaction is open.
+	UPROPERTY(Transient)
+	FHeartGraphChangeSet PendingChanges;
+
+	// Nodes whose location delegates are waiting for the transaction to close.
+	TSet<FHeartNodeGuid> PendingLocationBroadcasts;
+
 	Heart::Events::FNodeAddOrRemove OnNodeAddOrRemove;
 	Heart::Events::FNodeMoveEventHandler OnNodeMoved;
 	Heart::Events::FConnectionEventHandler OnNodeConnectionsChanged;
+	Heart::Events::FGraphChangeSetHandler OnGraphChanged;
 
 	Heart::Events::FGraphExtensionAddOrRemove OnExtensionAddOrRemove;
 	Heart::Events::FNodeComponentAddOrRemove OnComponentAddOrRemove;
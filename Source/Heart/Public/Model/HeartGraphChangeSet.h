@@ -0,0 +1,78 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGuids.h"
+#include "HeartGraphPinReference.h"
+#include "HeartGraphChangeSet.generated.h"
+
+class UHeartGraphNodeComponent;
+
+USTRUCT(BlueprintType)
+struct FHeartNodeComponentChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartNodeComponentChange")
+	FHeartNodeGuid Node;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartNodeComponentChange")
+	TObjectPtr<UHeartGraphNodeComponent> Component;
+
+	friend bool operator==(const FHeartNodeComponentChange& A, const FHeartNodeComponentChange& B)
+	{
+		return A.Node == B.Node && A.Component == B.Component;
+	}
+};
+
+/**
+ * Everything that changed in a graph during a transaction, with redundant entries folded together. A node that was
+ * added and removed inside the same transaction doesn't appear at all, and neither do its moves, connections, or
+ * components.
+ */
+USTRUCT(BlueprintType)
+struct HEART_API FHeartGraphChangeSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartNodeGuid> AddedNodes;
+
+	// Nodes that existed before the transaction began and were removed. A node may be both removed and (re)added.
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartNodeGuid> RemovedNodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartNodeGuid> MovedNodes;
+
+	// Did any move in the transaction finish? False if every move was "in-progress".
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	bool MoveFinished = false;
+
+	// Nodes that had pin connections change.
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartNodeGuid> ReconnectedNodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartPinGuid> AffectedPins;
+
+	// Pins that had connections change, on any of the reconnected nodes. See FHeartGraphConnectionEvent.
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TSet<FHeartGraphPinReference> AffectedPinReferences;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TArray<FHeartNodeComponentChange> AddedComponents;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphChangeSet")
+	TArray<FHeartNodeComponentChange> RemovedComponents;
+
+	void RecordNodesAdded(TConstArrayView<FHeartNodeGuid> Nodes);
+	void RecordNodesRemoved(TConstArrayView<FHeartNodeGuid> Nodes);
+	void RecordNodesMoved(const TSet<FHeartNodeGuid>& Nodes, bool Finished);
+	void RecordConnectionsChanged(TConstArrayView<FHeartNodeGuid> Nodes, const TSet<FHeartGraphPinReference>& Pins);
+	void RecordComponentAdded(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component);
+	void RecordComponentRemoved(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component);
+
+	bool IsEmpty() const;
+	void Reset();
+};
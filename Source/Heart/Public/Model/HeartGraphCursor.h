@@ -0,0 +1,182 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGraph.h"
+#include "HeartGraphNode.h"
+#include "Async/ParallelFor.h"
+#include "HeartGraphCursor.generated.h"
+
+/**
+ * A position in a graph, for walking it at runtime, e.g., playing back a dialogue or quest. Holds the current node and
+ * the pin it was entered through, and steps along the connections of output pins without allocating.
+ * Node handles survive save/load, so a cursor saves as three integers.
+ */
+USTRUCT(BlueprintType)
+struct HEART_API FHeartGraphCursor
+{
+	GENERATED_BODY()
+
+	FHeartGraphCursor() = default;
+
+	explicit FHeartGraphCursor(const FHeartNodeIndex Start)
+	  : Node(Start) {}
+
+	// Does the current node still exist in the graph?
+	bool IsValid(const UHeartGraph* Graph) const;
+
+	UHeartGraphNode* GetNode(const UHeartGraph* Graph) const;
+
+	FHeartNodeIndex GetNodeIndex() const { return Node; }
+
+	// Index of the pin on the current node the cursor arrived through, or INDEX_NONE at the start.
+	int32 GetEntryPin() const { return EntryPin; }
+
+	/**
+	 * Visit each connection out of the output pins of the current node, in pin order. Iter receives the branch number,
+	 * the index of the output pin on the node, and the pin connected to.
+	 * Return true in Iter to continue iterating.
+	 */
+	template <typename Func>
+	void ForEachBranch(const UHeartGraph* Graph, Func&& Iter) const
+	{
+		const UHeartGraphNode* Current = GetNode(Graph);
+		if (!Current)
+		{
+			return;
+		}
+
+		int32 Branch = 0;
+		const TArray<FHeartNodePin>& Pins = Current->PinData.Pins;
+		for (int32 Pin = 0; Pin < Pins.Num(); ++Pin)
+		{
+			if (!EnumHasAnyFlags(Pins[Pin].Desc->Direction, EHeartPinDirection::Output))
+			{
+				continue;
+			}
+
+			for (const FHeartGraphPinReference& Link : Pins[Pin].Connections.GetLinks())
+			{
+				if (!Iter(Branch++, Pin, Link))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	// Number of connections out of the output pins of the current node.
+	int32 NumBranches(const UHeartGraph* Graph) const;
+
+	// Move to the node at the end of a branch. Returns false, leaving the cursor in place, if there is no such branch.
+	bool Step(const UHeartGraph* Graph, int32 Branch = 0);
+
+	// Let Select choose which branch to take, given the cursor and the number of branches. Returning INDEX_NONE stays put.
+	template <typename SelectorType>
+	bool StepBy(const UHeartGraph* Graph, SelectorType&& Select)
+	{
+		const int32 Num = NumBranches(Graph);
+		if (Num == 0)
+		{
+			return false;
+		}
+
+		const int32 Branch = Select(*this, Num);
+		return Branch != INDEX_NONE && Step(Graph, Branch);
+	}
+
+	bool Serialize(FArchive& Ar);
+
+	friend bool operator==(const FHeartGraphCursor& A, const FHeartGraphCursor& B)
+	{
+		return A.Node == B.Node && A.EntryPin == B.EntryPin;
+	}
+
+private:
+	UPROPERTY(SaveGame)
+	FHeartNodeIndex Node;
+
+	UPROPERTY(SaveGame)
+	int32 EntryPin = INDEX_NONE;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHeartGraphCursor> : public TStructOpsTypeTraitsBase2<FHeartGraphCursor>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/**
+ * Storage for many cursors walking the same graph, stepped together once per tick. Cursors are addressed by stable ids,
+ * which are reused once freed.
+ */
+class HEART_API FHeartGraphCursorBatch
+{
+public:
+	explicit FHeartGraphCursorBatch(const UHeartGraph* Graph)
+	  : Graph(Graph) {}
+
+	const UHeartGraph* GetGraph() const { return Graph.Get(); }
+
+	int32 Add(const FHeartGraphCursor& Cursor);
+	void Remove(int32 Id);
+	void Reset();
+	void Reserve(int32 Number);
+
+	FHeartGraphCursor* Find(int32 Id);
+	const FHeartGraphCursor* Find(int32 Id) const;
+
+	// Number of cursors in the batch.
+	int32 Num() const { return Cursors.Num() - FreeIds.Num(); }
+
+	/**
+	 * Step every cursor. Select is called with the id of a cursor, the cursor, and its number of branches, and returns the
+	 * branch to take, or INDEX_NONE to stay. Cursors without branches are skipped.
+	 * With Parallel, cursors are stepped across worker threads, so Select must be thread-safe, and the graph must not be
+	 * modified until Tick returns. Returns the number of cursors that moved.
+	 */
+	template <typename SelectorType>
+	int32 Tick(SelectorType&& Select, const bool Parallel = false)
+	{
+		const UHeartGraph* ResolvedGraph = Graph.Get();
+		if (!::IsValid(ResolvedGraph))
+		{
+			return 0;
+		}
+
+		std::atomic<int32> NumMoved = 0;
+
+		ParallelFor(TEXT("HeartGraphCursorBatch"), Cursors.Num(), 256,
+			[&](const int32 Id)
+			{
+				if (!Active[Id])
+				{
+					return;
+				}
+
+				FHeartGraphCursor& Cursor = Cursors[Id];
+				if (Cursor.StepBy(ResolvedGraph,
+						[&Select, Id](const FHeartGraphCursor& InCursor, const int32 NumBranches)
+						{
+							return Select(Id, InCursor, NumBranches);
+						}))
+				{
+					NumMoved.fetch_add(1, std::memory_order_relaxed);
+				}
+			},
+			Parallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		return NumMoved.load();
+	}
+
+private:
+	TWeakObjectPtr<const UHeartGraph> Graph;
+
+	TArray<FHeartGraphCursor> Cursors;
+	TBitArray<> Active;
+	TArray<int32> FreeIds;
+};
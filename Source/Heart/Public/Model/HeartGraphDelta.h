@@ -0,0 +1,67 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGuids.h"
+#include "HeartGraphPinReference.h"
+#include "HeartGraphDelta.generated.h"
+
+struct FHeartGraphSnapshot;
+
+// A connection between two pins. A is always the lesser of the two, by node and then pin guid.
+USTRUCT(BlueprintType)
+struct FHeartGraphConnection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphConnection")
+	FHeartGraphPinReference A;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphConnection")
+	FHeartGraphPinReference B;
+
+	friend bool operator==(const FHeartGraphConnection& Lhs, const FHeartGraphConnection& Rhs)
+	{
+		return Lhs.A == Rhs.A && Lhs.B == Rhs.B;
+	}
+};
+
+/**
+ * The structural difference between two states of a graph. Nodes that were added or removed imply their pins, so only
+ * pin changes on nodes present in both states are listed. Every list is sorted by guid.
+ */
+USTRUCT(BlueprintType)
+struct HEART_API FHeartGraphDelta
+{
+	GENERATED_BODY()
+
+	// Compare two snapshots of the same graph with a merge over guid-sorted nodes and pins, in O(n log n).
+	static FHeartGraphDelta Compute(const FHeartGraphSnapshot& From, const FHeartGraphSnapshot& To);
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartNodeGuid> AddedNodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartNodeGuid> RemovedNodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartNodeGuid> MovedNodes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartGraphConnection> AddedConnections;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartGraphConnection> RemovedConnections;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartGraphPinReference> AddedPins;
+
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartGraphPinReference> RemovedPins;
+
+	// Pins whose name, direction, or tag changed.
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphDelta")
+	TArray<FHeartGraphPinReference> ChangedPins;
+
+	bool IsEmpty() const;
+};
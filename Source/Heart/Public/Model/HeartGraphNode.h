@@ -14,6 +14,7 @@
 #include "GraphRegistry/HeartNodeSource.h"
 #include "Model/HeartConcepts.h"
 #include "Model/HeartGuids.h"
+#include "Model/HeartNodeIndex.h"
 #include "Model/HeartPinDirection.h"
 
 #include "HeartGraphNode.generated.h"
@@ -24,6 +25,11 @@ namespace Heart::API
 	class FNodeCreator;
 }
 
+namespace Heart::Graph
+{
+	class FAdjacencyIndex;
+}
+
 struct FHeartGraphNodeMessage;
 class UHeartGraph;
 class UHeartGraphNode;
@@ -112,9 +118,15 @@ class HEART_API UHeartGraphNode : public UObject, public IHeartGraphNodeInterfac
 	friend class UHeart2DLocationComponent; // @Todo temp, until event system is added
 	friend class UHeart3DLocationComponent; // @Todo temp, until event system is added
 	friend class UHeartEdGraphNode;
+	friend class UHeartGraph; // Flushes location broadcasts deferred by a transaction
 	friend class Heart::API::FNodeCreator;
 	friend class Heart::API::FPinEdit;
 	friend class Heart::API::FNodeEdit;
+	friend struct FHeartNodeSlotMap;
+	friend class Heart::Graph::FAdjacencyIndex;
+	friend class UHeartLightweightNodeExtension;
+	friend struct FHeartGraphSnapshot;
+	friend struct FHeartGraphCursor;
 
 public:
 	UHeartGraphNode();
@@ -206,6 +218,9 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintGetter, Category = "Heart|GraphNode")
 	FHeartNodeGuid GetGuid() const { return Guid; }
 
+	// Handle to this node's slot in the owning graph. Only valid while the node is in a graph.
+	FHeartNodeIndex GetNodeIndex() const { return NodeIndex; }
+
 	UE_DEPRECATED(5.7, "Location is now managed by the Node Location Interface on the Graph")
 	UFUNCTION(BlueprintCallable, BlueprintGetter, Category = "Heart|GraphNode")
 	FVector2D GetLocation() const
@@ -319,6 +334,12 @@ protected:
 	// Returns true if pins were modified
 	bool ReconstructPins(bool IsCreation = false);
 
+	// Add a pin without re-indexing or notifying. Callers report all of their added pins with NotifyPinsRebuilt.
+	FHeartPinGuid AddPin_NoNotify(const FHeartGraphPinDesc& Desc);
+
+	// Re-index this node's pins, and notify listeners once, after a number of pins were added or changed.
+	void NotifyPinsRebuilt();
+
 	// Called by the owning graph when we are created.
 	UFUNCTION(BlueprintImplementableEvent, Category = "Heart|GraphNode", DisplayName = "On Create")
 	void BP_OnCreate(UObject* NodeSpawningContext);
@@ -350,6 +371,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "GraphNode")
 	FHeartNodeGuid Guid;
 
+	// Assigned by the graph's FHeartNodeSlotMap.
+	FHeartNodeIndex NodeIndex;
+
 	UE_DEPRECATED(5.7, "Location is now managed by the Node Location Interface on the Graph")
 	UPROPERTY(BlueprintReadOnly, Category = "GraphNode")
 	FVector2D Location;
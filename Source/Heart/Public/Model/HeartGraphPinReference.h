@@ -37,6 +37,13 @@ struct FHeartGraphPinReference
 		return Ar << V.NodeGuid << V.PinGuid;
 	}
 
+	// Serialize with a compact pin id, when the pin has one.
+	void SerializeCompact(FArchive& Ar)
+	{
+		Ar << NodeGuid;
+		PinGuid.SerializeCompact(Ar);
+	}
+
 	FORCEINLINE friend uint32 GetTypeHash(const FHeartGraphPinReference& PinReference)
 	{
 		return HashCombineFast(GetTypeHash(PinReference.NodeGuid), GetTypeHash(PinReference.PinGuid));
@@ -59,13 +66,62 @@ public:
 
 	bool Serialize(FArchive& Ar)
 	{
+		// Data saved before the native format was written as tagged properties, which start with a property name, and
+		// never with the negative header written by operator<<. Peek at it to decide, as not every archive that reaches
+		// here carries a version. Binary property serialization wrote a plain array, which operator<< reads itself.
+		if (Ar.IsLoading() && !Ar.WantBinaryPropertySerialization())
+		{
+			if (const int64 Start = Ar.Tell();
+				Start != INDEX_NONE)
+			{
+				int32 Header = 0;
+				Ar << Header;
+				Ar.Seek(Start);
+
+				if (Header >= 0)
+				{
+					return false;
+				}
+			}
+		}
+
 		Ar << *this;
 		return true;
 	}
 
 	friend FArchive& operator<<(FArchive& Ar, FHeartGraphPinConnections& V)
 	{
-		Ar << V.Connections;
+		// Legacy data was a plain array, which always starts with a non-negative count. The current format writes a
+		// negative count instead, followed by references with compact pin ids.
+		int32 Header = -(V.Connections.Num() + 1);
+		Ar << Header;
+
+		if (Ar.IsLoading())
+		{
+			const bool Legacy = Header >= 0;
+			const int32 Num = Legacy ? Header : -Header - 1;
+			V.Connections.Empty();
+			for (int32 i = 0; i < Num && !Ar.IsError(); ++i)
+			{
+				FHeartGraphPinReference& Reference = V.Connections.AddDefaulted_GetRef();
+				if (Legacy)
+				{
+					Ar << Reference;
+				}
+				else
+				{
+					Reference.SerializeCompact(Ar);
+				}
+			}
+		}
+		else
+		{
+			for (FHeartGraphPinReference& Reference : V.Connections)
+			{
+				Reference.SerializeCompact(Ar);
+			}
+		}
+
 		return Ar;
 	}
 
@@ -80,6 +136,6 @@ struct TStructOpsTypeTraits<FHeartGraphPinConnections> : public TStructOpsTypeTr
 {
 	enum
 	{
-		WithSerialize = true,
+		WithSerializer = true,
 	};
 };
\ No newline at end of file
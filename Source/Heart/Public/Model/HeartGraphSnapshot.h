@@ -0,0 +1,94 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Algorithms/GraphAlgorithms.h"
+#include "HeartGraphPinReference.h"
+#include "HeartGraphPinTag.h"
+#include "HeartGuids.h"
+#include "Model/HeartPinDirection.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/TopLevelAssetPath.h"
+
+class UHeartGraph;
+struct FHeartGraphSnapshot;
+
+using FHeartGraphSnapshotRef = TSharedRef<const FHeartGraphSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * An immutable copy of a graph's nodes, pins, connections, and locations in flat arrays. Taken on the game thread, and
+ * then safe to read from any thread while the live graph keeps changing.
+ * Get one with UHeartGraph::GetSnapshot, which hands out the same snapshot until the graph's version changes.
+ * Nodes are addressed by vertex, numbered in node slot order. Pins are addressed by a flat index across all nodes.
+ */
+struct HEART_API FHeartGraphSnapshot
+{
+	static FHeartGraphSnapshotRef Create(const UHeartGraph* Graph);
+
+	// The graph version this was taken at. See UHeartGraph::GetVersion.
+	uint64 GetVersion() const { return Version; }
+
+	// The graph topology version this was taken at. See UHeartGraph::GetTopologyVersion.
+	uint64 GetTopologyVersion() const { return TopologyVersion; }
+	const FHeartGraphGuid& GetGraphGuid() const { return GraphGuid; }
+
+	int32 NumNodes() const { return Nodes.Num(); }
+	int32 NumPins() const { return PinGuids.Num(); }
+
+	// Get the vertex of a node, or INDEX_NONE if it was not in the graph.
+	int32 FindVertex(const FHeartNodeGuid& Node) const;
+
+	const FHeartNodeGuid& GetNode(const int32 Vertex) const { return Nodes[Vertex]; }
+	TConstArrayView<FHeartNodeGuid> GetNodes() const { return Nodes; }
+
+	// Index of a node's class in GetClasses.
+	int32 GetNodeClassId(const int32 Vertex) const { return NodeClassIds[Vertex]; }
+	TConstArrayView<FTopLevelAssetPath> GetClasses() const { return Classes; }
+
+	const FVector2D& GetLocation(const int32 Vertex) const { return Locations[Vertex]; }
+	TConstArrayView<FVector2D> GetLocations() const { return Locations; }
+
+	// The pins of a node are the flat pin indices [GetPinBegin, GetPinEnd).
+	int32 GetPinBegin(const int32 Vertex) const { return PinOffsets[Vertex]; }
+	int32 GetPinEnd(const int32 Vertex) const { return PinOffsets[Vertex + 1]; }
+
+	const FHeartPinGuid& GetPinGuid(const int32 Pin) const { return PinGuids[Pin]; }
+	FName GetPinName(const int32 Pin) const { return PinNames[Pin]; }
+	EHeartPinDirection GetPinDirection(const int32 Pin) const { return PinDirections[Pin]; }
+	const FHeartGraphPinTag& GetPinTag(const int32 Pin) const { return PinTags[Pin]; }
+
+	TConstArrayView<FHeartGraphPinReference> GetPinLinks(const int32 Pin) const
+	{
+		return TConstArrayView<FHeartGraphPinReference>(Links.GetData() + LinkOffsets[Pin], LinkOffsets[Pin + 1] - LinkOffsets[Pin]);
+	}
+
+	// Node-to-node connections, following Output pins. Edges weigh the number of pin connections between two nodes.
+	const Heart::Algorithms::FCsrGraph& GetTopology() const { return Topology; }
+
+private:
+	FHeartGraphSnapshot() = default;
+
+	uint64 Version = 0;
+	uint64 TopologyVersion = 0;
+	FHeartGraphGuid GraphGuid;
+
+	// Per vertex
+	TArray<FHeartNodeGuid> Nodes;
+	TArray<int32> NodeClassIds;
+	TArray<FVector2D> Locations;
+	TArray<int32> PinOffsets;
+
+	TArray<FTopLevelAssetPath> Classes;
+	TMap<FHeartNodeGuid, int32> VertexLookup;
+
+	// Per pin
+	TArray<FHeartPinGuid> PinGuids;
+	TArray<FName> PinNames;
+	TArray<EHeartPinDirection> PinDirections;
+	TArray<FHeartGraphPinTag> PinTags;
+	TArray<int32> LinkOffsets;
+
+	TArray<FHeartGraphPinReference> Links;
+
+	Heart::Algorithms::FCsrGraph Topology;
+};
@@ -0,0 +1,28 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+class UHeartGraph;
+
+namespace Heart::API
+{
+	/*
+	 * Scoped transaction over a HeartGraph. While any transaction is open, node, move, connection and component events
+	 * are collected instead of broadcast. When the outermost transaction closes, listeners receive a single
+	 * FHeartGraphChangeSet, along with one consolidated event on each of the individual delegates.
+	 * Transactions nest; only the outermost dtor flushes.
+	 */
+	class HEART_API FGraphTransaction
+	{
+	public:
+		UE_NONCOPYABLE(FGraphTransaction)
+
+		FGraphTransaction(TNotNull<UHeartGraph*> Graph);
+
+		// Dtor delivers the change set if this is the outermost transaction.
+		~FGraphTransaction();
+
+	private:
+		TNotNull<UHeartGraph*> Graph;
+	};
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "HeartGuids.h"
+#include "HeartGraphPinReference.h"
 #include "HeartGraphTypes.generated.h"
 
 class UHeartGraphNode;
@@ -19,6 +20,11 @@ struct FHeartGraphConnectionEvent
 
 	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphConnectionEvent")
 	TSet<FHeartPinGuid> AffectedPins;
+
+	// The same pins, along with their node. Compact pin ids are only unique within a node, so use these instead of
+	// AffectedPins to tell apart pins on different nodes.
+	UPROPERTY(BlueprintReadOnly, Category = "HeartGraphConnectionEvent")
+	TSet<FHeartGraphPinReference> AffectedPinReferences;
 };
 
 /* Event broadcast after nodes are added to a graph */
@@ -42,6 +42,10 @@ namespace Heart::Utils
 
 	[[nodiscard]] HEART_API TArray<FHeartNodeGuid> GetConnectedNodes(const TNotNull<UHeartGraph*> Graph, const FHeartNodeGuid& Node, EHeartPinDirection Direction = EHeartPinDirection::Bidirectional);
 
+	[[nodiscard]] HEART_API bool IsNodeReachable(const UHeartGraph* Graph, const FHeartNodeGuid& From, const FHeartNodeGuid& To);
+
+	[[nodiscard]] HEART_API TArray<FHeartNodeGuid> GetReachableNodes(const UHeartGraph* Graph, const FHeartNodeGuid& From);
+
 	[[nodiscard]] HEART_API TConstStructView<FHeartGraphPinDesc> ResolvePinReference(const UHeartGraph* Graph, const FHeartGraphPinReference& Reference);
 }
 
@@ -101,11 +105,20 @@ public:
 
 	/**			NODE MISC UTILS			*/
 
-	// Test if connecting two nodes would cause a loop in connections. Walks backwards through the inputs of A until it
-	// finds or fails to find B.
+	// Test if connecting an output of A to an input of B would cause a loop in connections, i.e., if A is already
+	// reachable from B. Uses the graph's topological order, so only nodes ranked between the two are searched.
 	UFUNCTION(BlueprintPure, Category = "Heart|Graph")
 	static bool WouldConnectionCreateLoop(const UHeartGraphNode* A, const UHeartGraphNode* B);
 
+	// Test if To can be reached by following connections out of the output pins of From. Near constant time if the
+	// schema maintains a reachability index.
+	UFUNCTION(BlueprintPure, Category = "Heart|Graph")
+	static bool IsNodeReachable(const UHeartGraph* Graph, const FHeartNodeGuid& From, const FHeartNodeGuid& To);
+
+	// Get all nodes that can be reached by following connections out of the output pins of Node.
+	UFUNCTION(BlueprintCallable, Category = "Heart|Graph")
+	static TArray<FHeartNodeGuid> GetReachableNodes(const UHeartGraph* Graph, const FHeartNodeGuid& Node);
+
 
 	/**			TYPED GETTERS			*/
 
@@ -140,6 +153,10 @@ public:
 	static void BreakHeartActionRecord(const FHeartActionRecord& Record, TSubclassOf<UHeartActionBase>& Action, UObject*& Target,
 		FHeartInputActivation& Activation, UObject*& Payload, FBloodContainer& UndoData);
 
+	// Gets the description a pin desc handle refers to.
+	UFUNCTION(BlueprintPure, Category = "Heart|GraphPin", meta = (BlueprintAutocast))
+	static FHeartGraphPinDesc BreakPinDescHandle(const FHeartPinDescHandle& Handle);
+
 	// Makes a Node Source from a Class. Add this to a Registry to spawn nodes with instances of this class.
 	UFUNCTION(BlueprintPure, Category = "Heart|Registry")
 	static FHeartNodeSource MakeNodeSourceFromClass(UClass* Class);
@@ -78,6 +78,8 @@ public:
 
 
 // Identifier for Heart Graph Pins
+// Pins only need to be unique within their node, so they may instead be compact ids: a node-local slot and a hash of the
+// pin name, packed into the guid's fields. Compact ids serialize in 7 bytes instead of 16, see SerializeCompact.
 USTRUCT(BlueprintType)
 struct HEART_API FHeartPinGuid : public FHeartGuid
 {
@@ -88,6 +90,41 @@ private:
 	FHeartPinGuid(const FGuid Guid)
 	  : FHeartGuid(Guid) {}
 
+	// Stored in A to mark a compact id. Random guids collide with this, a zero D, and a 16-bit B with negligible odds.
+	static constexpr uint32 CompactMarker = 0x48504331; // 'HPC1'
+
 public:
 	static FHeartPinGuid New() { return NewGuid(); }
+
+	static FHeartPinGuid NewCompact(const uint16 Slot, const uint32 NameHash)
+	{
+		return FGuid(CompactMarker, Slot, NameHash, 0);
+	}
+
+	bool IsCompact() const { return A == CompactMarker && (B >> 16) == 0 && D == 0; }
+	uint16 GetCompactSlot() const { return static_cast<uint16>(B); }
+	uint32 GetCompactNameHash() const { return C; }
+
+	// Serialize compact ids as a slot and hash, and anything else as a full guid, behind a one-byte header.
+	void SerializeCompact(FArchive& Ar)
+	{
+		uint8 Compact = IsCompact();
+		Ar << Compact;
+
+		if (Compact)
+		{
+			uint16 Slot = GetCompactSlot();
+			uint32 NameHash = GetCompactNameHash();
+			Ar << Slot << NameHash;
+
+			if (Ar.IsLoading())
+			{
+				*this = NewCompact(Slot, NameHash);
+			}
+		}
+		else
+		{
+			Ar << static_cast<FGuid&>(*this);
+		}
+	}
 };
\ No newline at end of file
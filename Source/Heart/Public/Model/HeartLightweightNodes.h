@@ -0,0 +1,137 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGraphExtension.h"
+#include "HeartGraphPinReference.h"
+#include "HeartGuids.h"
+#include "HeartPinData.h"
+#include "HeartPinQuery.h"
+#include "GraphRegistry/HeartNodeSource.h"
+#include "StructUtils/InstancedStruct.h"
+#include "HeartLightweightNodes.generated.h"
+
+class UHeartGraphNode;
+
+/**
+ * Storage for nodes that don't need to be UObjects, for graphs with far more nodes than anyone will look at. Each node
+ * is a row across parallel arrays: a guid, an index into a table of shared archetypes, an instanced struct holding its
+ * state in place of a NodeObject, a location, and its pins. Pins and connections use the same data as graph nodes, so
+ * links between lightweight nodes are regular FHeartGraphPinReferences.
+ *
+ * Lightweight nodes are not in UHeartGraph::Nodes, and don't receive components. When an editor or Blueprint needs an
+ * object, Promote turns one into a regular UHeartGraphNode with the same guid. Links between a promoted node and
+ * lightweight nodes are kept on both sides, but the graph's own indexes only see links between graph nodes. FPinEdit
+ * edits and restores the lightweight side of these links through this extension, as the graph can't resolve their guids.
+ *
+ * IHeartGraphNodeInterface is a UObject interface, so lightweight nodes answer the same questions through this
+ * extension instead: pin queries, pin descriptions, and connections, by node guid.
+ */
+UCLASS()
+class HEART_API UHeartLightweightNodeExtension : public UHeartGraphExtension
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostLoad() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
+
+	// Add a lightweight node. Pins are created from the default pins of the archetype's graph node class.
+	FHeartNodeGuid AddNode(const FHeartNodeArchetype& Archetype, const FInstancedStruct& State, const FVector2D& Location);
+
+	// Remove a lightweight node, and break all links to it.
+	UFUNCTION(BlueprintCallable, Category = "Heart|LightweightNodes")
+	bool RemoveNode(const FHeartNodeGuid& Node);
+
+	// Reserve space for this many more nodes.
+	void Reserve(int32 Number);
+
+	UFUNCTION(BlueprintCallable, Category = "Heart|LightweightNodes")
+	int32 Num() const { return Guids.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Heart|LightweightNodes")
+	bool Contains(const FHeartNodeGuid& Node) const { return RowByGuid.Contains(Node); }
+
+	// Return true in Iter to continue iterating
+	void ForEachNode(const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const;
+
+	const FHeartNodeArchetype* FindArchetype(const FHeartNodeGuid& Node) const;
+	const FInstancedStruct* FindState(const FHeartNodeGuid& Node) const;
+	FInstancedStruct* FindStateMutable(const FHeartNodeGuid& Node);
+
+	FVector2D GetNodeLocation(const FHeartNodeGuid& Node) const;
+	void SetNodeLocation(const FHeartNodeGuid& Node, const FVector2D& Location);
+
+
+	/*----------------------------
+			PINS
+	----------------------------*/
+
+	Heart::Query::FPinQueryResult QueryPins(const FHeartNodeGuid& Node) const;
+
+	TConstStructView<FHeartGraphPinDesc> ViewPin(const FHeartNodeGuid& Node, const FHeartPinGuid& Pin) const;
+
+	TConstStructView<FHeartGraphPinConnections> ViewConnections(const FHeartNodeGuid& Node, const FHeartPinGuid& Pin) const;
+
+	FHeartPinGuid GetPinByName(const FHeartNodeGuid& Node, FName Name) const;
+
+	// Link two pins on lightweight nodes.
+	bool Connect(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB);
+
+	bool Disconnect(const FHeartGraphPinReference& PinA, const FHeartGraphPinReference& PinB);
+
+	// Remove the link to To from the pin From, whether From is on a lightweight or a graph node. To is left as it is.
+	bool RemoveLink(const FHeartGraphPinReference& From, const FHeartGraphPinReference& To);
+
+	// Copy the connections of every pin on a lightweight node, in the format used by undo mementos.
+	bool CopyConnections(const FHeartNodeGuid& Node, TMap<FHeartPinGuid, FHeartGraphPinConnections>& OutConnections) const;
+
+	// Replace the connections of every pin on a lightweight node, such as when restoring an undo memento.
+	bool SetConnections(const FHeartNodeGuid& Node, const TMap<FHeartPinGuid, FHeartGraphPinConnections>& Connections);
+
+
+	/*----------------------------
+			PROMOTION
+	----------------------------*/
+
+	// Turn a lightweight node into a regular graph node, keeping its guid, location, and links.
+	UFUNCTION(BlueprintCallable, Category = "Heart|LightweightNodes")
+	UHeartGraphNode* Promote(const FHeartNodeGuid& Node);
+
+	// Get the graph node for a guid, promoting it first if it is a lightweight node.
+	UFUNCTION(BlueprintCallable, Category = "Heart|LightweightNodes")
+	UHeartGraphNode* GetOrPromote(const FHeartNodeGuid& Node);
+
+protected:
+	// Copy a lightweight node's state onto a newly promoted node. By default, the state is copied into the first
+	// property of the NodeObject with the same struct type, if there is one.
+	virtual void InitializePromotedNode(UHeartGraphNode* GraphNode, const FInstancedStruct& State) const;
+
+private:
+	int32 FindOrAddArchetype(const FHeartNodeArchetype& Archetype);
+
+	void RemoveRow(int32 Row);
+	void RebuildLookup();
+
+	// Archetypes shared by the nodes
+	UPROPERTY()
+	TArray<FHeartNodeArchetype> Archetypes;
+
+	// Per-node columns, all the same length
+	UPROPERTY()
+	TArray<FHeartNodeGuid> Guids;
+
+	UPROPERTY()
+	TArray<int32> ArchetypeIndices;
+
+	UPROPERTY()
+	TArray<FInstancedStruct> States;
+
+	UPROPERTY()
+	TArray<FVector2D> Locations;
+
+	UPROPERTY()
+	TArray<FHeartNodePinData> PinData;
+
+	TMap<FHeartNodeGuid, int32> RowByGuid;
+};
@@ -0,0 +1,63 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGuids.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
+
+class UHeartGraphNodeComponent;
+struct FHeartGraphNodeComponentMap;
+
+namespace Heart::Graph
+{
+	/**
+	 * Secondary indexes over a graph's node components, which are owned by class in UHeartGraph::NodeComponents.
+	 * Provides lookup of the components on a node, of a component by guid, and of the component classes implementing
+	 * an interface, without scanning every class map. Not serialized; rebuilt on load.
+	 */
+	class HEART_API FNodeComponentIndex
+	{
+	public:
+		using FComponentMap = TMap<TSubclassOf<UHeartGraphNodeComponent>, FHeartGraphNodeComponentMap>;
+		using FNodeComponentList = TArray<UHeartGraphNodeComponent*, TInlineAllocator<4>>;
+
+		struct FGuidEntry
+		{
+			FHeartNodeGuid Node;
+			UHeartGraphNodeComponent* Component = nullptr;
+		};
+
+		void Rebuild(const FComponentMap& NodeComponents);
+		void Reset();
+
+		// Grow the index to fit this many more nodes and components.
+		void Reserve(int32 NumNodes, int32 NumComponents);
+
+		void Add(const FHeartNodeGuid& Node, UHeartGraphNodeComponent* Component);
+		void Remove(const FHeartNodeGuid& Node, const UHeartGraphNodeComponent* Component);
+
+		// Remove all components of a node from the index, returning them.
+		FNodeComponentList RemoveNode(const FHeartNodeGuid& Node);
+
+		TConstArrayView<UHeartGraphNodeComponent*> GetComponentsForNode(const FHeartNodeGuid& Node) const;
+
+		const FGuidEntry* FindByGuid(const FHeartExtensionGuid& Guid) const;
+
+		// Does a component class implement an interface? Results are cached per interface. Safe to call from any thread.
+		bool ClassImplements(const UClass* Class, const UClass* Interface) const;
+
+		// Forget cached interface results, such as after classes are reinstanced.
+		void ResetClassCache();
+
+	private:
+		TMap<FHeartNodeGuid, FNodeComponentList> ByNode;
+		TMap<FHeartExtensionGuid, FGuidEntry> ByGuid;
+
+		// Interface -> component classes seen so far, and whether they implement it. Keyed weakly, as classes may be
+		// garbage collected or reinstanced, and guarded, as it is filled in by const lookups.
+		mutable TMap<FObjectKey, TMap<FObjectKey, bool>> InterfaceClasses;
+		mutable FRWLock InterfaceClassesLock;
+	};
+}
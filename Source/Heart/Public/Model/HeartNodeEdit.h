@@ -107,6 +107,9 @@ namespace Heart::API
 		// Retrieves the most recently made pending creation.
 		[[nodiscard]] UHeartGraphNode* Get() const;
 
+		// Reserve space for a batch of creates. Worth calling before queuing a large number of nodes.
+		void Reserve(int32 NumCreates) { PendingCreates.Reserve(PendingCreates.Num() + NumCreates); }
+
 		int32 GetNumPendingCreates() const { return PendingCreates.Num(); }
 		int32 GetNumPendingDeletes() const { return PendingDeletes.Num(); }
 
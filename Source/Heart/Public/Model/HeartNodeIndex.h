@@ -5,14 +5,35 @@
 #include "HeartNodeIndex.generated.h"
 
 /**
- * A simple int wrapper to type-safely index into the Nodes map on a graph.
- * Unlike FHeartNodeGuid, this is not stable, and should only be used for communication during a single frame.
+ * A type-safe handle to a slot in the node storage of a graph. Slots are stable for the lifetime of a node, and the
+ * Generation is bumped every time a slot is recycled, so a handle to a removed node will fail to resolve instead of
+ * aliasing whatever node reuses its slot. Unlike FHeartNodeGuid, this is only meaningful within a single graph.
  */
 USTRUCT()
 struct FHeartNodeIndex
 {
 	GENERATED_BODY()
 
+	FHeartNodeIndex() = default;
+
+	FHeartNodeIndex(const int32 Index, const uint32 Generation)
+	  : Index(Index), Generation(Generation) {}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	friend bool operator==(const FHeartNodeIndex& A, const FHeartNodeIndex& B)
+	{
+		return A.Index == B.Index && A.Generation == B.Generation;
+	}
+
+	friend uint32 GetTypeHash(const FHeartNodeIndex& NodeIndex)
+	{
+		return HashCombineFast(::GetTypeHash(NodeIndex.Index), ::GetTypeHash(NodeIndex.Generation));
+	}
+
 	UPROPERTY()
 	int32 Index = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 Generation = 0;
 };
@@ -0,0 +1,85 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGuids.h"
+#include "HeartGraphPinTag.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+class UHeartGraph;
+class UHeartGraphNode;
+
+namespace Heart::Graph
+{
+	/**
+	 * Secondary indexes from node class, node object class, and pin tag to the nodes that have them, so that lookups
+	 * cost O(matches) instead of O(nodes). Class lookups are hierarchy-aware.
+	 * Opt-in per schema; built by the graph on load, or the first time it is used on the game thread, then maintained by
+	 * FNodeEdit and the node's pin edits. Not serialized.
+	 * Classes are keyed weakly, so classes that are garbage collected are skipped. The graph rebuilds the index when
+	 * Blueprint classes are reinstanced.
+	 */
+	class HEART_API FNodeLookupIndex
+	{
+	public:
+		using FNodeSet = TSet<FHeartNodeGuid>;
+
+		bool IsBuilt() const { return Built; }
+
+		void Rebuild(const UHeartGraph* Graph);
+		void Reset();
+
+		// The following do nothing until the index has been built.
+
+		void Reserve(int32 NumNodes);
+		void AddNode(const UHeartGraphNode* Node);
+		void RemoveNode(const FHeartNodeGuid& Node);
+
+		// Re-index the tags of a node's pins.
+		void UpdatePins(const UHeartGraphNode* Node);
+
+		// Visit nodes whose class is, or derives from, Class. Return true in Iter to continue iterating.
+		void ForEachNodeOfClass(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const;
+
+		// Visit nodes whose node object's class is, or derives from, Class. Return true in Iter to continue iterating.
+		void ForEachNodeWithObjectClass(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const;
+
+		// Nodes with at least one pin tagged exactly Tag.
+		const FNodeSet* FindNodesWithPinTag(const FHeartGraphPinTag& Tag) const;
+
+	private:
+		// Nodes by exact class, with a cache of the indexed classes deriving from each class that has been asked for.
+		struct FClassIndex
+		{
+			void Add(const UClass* Class, const FHeartNodeGuid& Node);
+			void Remove(const FObjectKey& Class, const FHeartNodeGuid& Node);
+			void Reset();
+			bool ForEach(const UClass* Class, const TFunctionRef<bool(const FHeartNodeGuid&)>& Iter) const;
+
+			TMap<FObjectKey, FNodeSet> ByClass;
+
+			// Filled in by lookups, which may run on any thread, so it has its own lock.
+			mutable TMap<FObjectKey, TArray<FObjectKey>> Derived;
+			mutable FRWLock DerivedLock;
+		};
+
+		// What a node was indexed under, so it can be removed without consulting the node.
+		struct FNodeEntry
+		{
+			FObjectKey NodeClass;
+			FObjectKey ObjectClass;
+			TArray<FHeartGraphPinTag, TInlineAllocator<4>> PinTags;
+		};
+
+		void AddPinTags(const FHeartNodeGuid& Node, TConstArrayView<FHeartGraphPinTag> Tags);
+		void RemovePinTags(const FHeartNodeGuid& Node, TConstArrayView<FHeartGraphPinTag> Tags);
+
+		TMap<FHeartNodeGuid, FNodeEntry> Entries;
+		FClassIndex NodeClasses;
+		FClassIndex ObjectClasses;
+		TMap<FHeartGraphPinTag, FNodeSet> ByPinTag;
+
+		bool Built = false;
+	};
+}
@@ -1,8 +1,9 @@
-// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #pragma once
 
 #include "HeartGuids.h"
+#include "HeartGraphPinTag.h"
 #include "HeartQueries.h"
 
 class UHeartGraph;
@@ -47,6 +48,18 @@ namespace Heart::Query
 
 		const FNodeMap& SimpleData() const;
 
+		// The following narrow the query using the graph's lookup index, visiting only matching nodes, if the schema
+		// maintains one. Otherwise, they fall back to filtering.
+
+		// Keep nodes of this class, or a subclass.
+		TNodeQueryResult& OfClass(const UClass* Class);
+
+		// Keep nodes whose node object is of this class, or a subclass.
+		TNodeQueryResult& WithObjectClass(const UClass* Class);
+
+		// Keep nodes with at least one pin with exactly this tag.
+		TNodeQueryResult& WithPinTag(const FHeartGraphPinTag& Tag);
+
 	private:
 		const UHeartGraph* Reference;
 	};
@@ -0,0 +1,91 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGuids.h"
+#include "HeartNodeIndex.h"
+#include "HeartNodeSlotMap.generated.h"
+
+class UHeartGraphNode;
+
+USTRUCT()
+struct FHeartNodeSlot
+{
+	GENERATED_BODY()
+
+	// The node occupying this slot, or an invalid guid if the slot is free.
+	UPROPERTY()
+	FHeartNodeGuid Guid;
+
+	// Incremented each time the slot is freed, invalidating outstanding handles to it.
+	UPROPERTY()
+	uint32 Generation = 0;
+
+	// Position of the node in the dense array. Not serialized; resolved again by Rebuild.
+	int32 DenseIndex = INDEX_NONE;
+};
+
+/**
+ * Generational slot-map storing the nodes of a graph. Nodes are kept in a dense array for contiguous iteration, while
+ * FHeartNodeIndex handles address the sparse slot array, and resolve in O(1) without hashing the node guid.
+ * Only the slots are serialized, so handles (and anything indexed by them, like node locations) survive save/load.
+ */
+USTRUCT()
+struct HEART_API FHeartNodeSlotMap
+{
+	GENERATED_BODY()
+
+	FHeartNodeIndex Add(UHeartGraphNode* Node);
+	bool Remove(FHeartNodeIndex Index);
+
+	void Reserve(int32 Number);
+	void Reset();
+
+	// Re-resolve the dense arrays from the serialized slots. Nodes in the map without a slot are given one, in guid order.
+	void Rebuild(const TMap<FHeartNodeGuid, TObjectPtr<UHeartGraphNode>>& Nodes);
+
+	bool IsValidIndex(const FHeartNodeIndex Index) const
+	{
+		return Slots.IsValidIndex(Index.Index) &&
+			Slots[Index.Index].Generation == Index.Generation &&
+			Slots[Index.Index].DenseIndex != INDEX_NONE;
+	}
+
+	UHeartGraphNode* Resolve(const FHeartNodeIndex Index) const
+	{
+		return IsValidIndex(Index) ? DenseNodes[Slots[Index.Index].DenseIndex].Get() : nullptr;
+	}
+
+	FHeartNodeGuid GetGuid(const FHeartNodeIndex Index) const
+	{
+		return IsValidIndex(Index) ? Slots[Index.Index].Guid : FHeartNodeGuid();
+	}
+
+	// Get the handle for the node at a position in the dense array.
+	FHeartNodeIndex GetIndexAt(const int32 DenseIndex) const
+	{
+		const int32 Slot = DenseToSlot[DenseIndex];
+		return FHeartNodeIndex(Slot, Slots[Slot].Generation);
+	}
+
+	// Number of nodes stored.
+	int32 Num() const { return DenseNodes.Num(); }
+
+	// Upper bound of FHeartNodeIndex::Index. Use this to size arrays that are indexed by node slot.
+	int32 GetMaxIndex() const { return Slots.Num(); }
+
+	TConstArrayView<TObjectPtr<UHeartGraphNode>> GetNodes() const { return DenseNodes; }
+
+	auto begin() const { return DenseNodes.begin(); }
+	auto end() const { return DenseNodes.end(); }
+
+private:
+	UPROPERTY()
+	TArray<FHeartNodeSlot> Slots;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UHeartGraphNode>> DenseNodes;
+
+	TArray<int32> DenseToSlot;
+	TArray<int32> FreeSlots;
+};
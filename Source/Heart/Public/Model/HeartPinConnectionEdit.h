@@ -23,7 +23,30 @@ namespace Heart::API
 
 			friend FArchive& operator<<(FArchive& Ar, FMemento& V)
 			{
-				return Ar << V.PinConnections;
+				int32 Num = V.PinConnections.Num();
+				Ar << Num;
+
+				if (Ar.IsLoading())
+				{
+					V.PinConnections.Empty(Num);
+					for (int32 i = 0; i < Num && !Ar.IsError(); ++i)
+					{
+						FHeartPinGuid Pin;
+						Pin.SerializeCompact(Ar);
+						Ar << V.PinConnections.Add(Pin);
+					}
+				}
+				else
+				{
+					for (auto&& Element : V.PinConnections)
+					{
+						FHeartPinGuid Pin = Element.Key;
+						Pin.SerializeCompact(Ar);
+						Ar << Element.Value;
+					}
+				}
+
+				return Ar;
 			}
 		};
 
@@ -58,6 +81,7 @@ namespace Heart::API
 
 	private:
 		void Internal_Disconnect(UHeartGraphNode* NodeA, const FHeartGraphPinReference& PinA, UHeartGraphNode* NodeB, const FHeartGraphPinReference& PinB);
+		void Internal_CreateMemento(const FHeartNodeGuid& NodeGuid, TMap<FHeartNodeGuid, FMemento>& OutMementos) const;
 
 		TNotNull<UHeartGraph*> Graph;
 		TMultiMap<UHeartGraphNode*, FHeartPinGuid> ChangedPins;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "HeartGraphPinDesc.h"
+#include "HeartPinDescHandle.h"
 #include "HeartGraphPinReference.h"
 #include "HeartGuids.h"
 
@@ -23,14 +24,40 @@ namespace Heart
 	{
 		class FPinEdit;
 	}
+
+	namespace Graph
+	{
+		class FAdjacencyIndex;
+	}
 }
 
+/**
+ * A single pin on a Heart Node, with its description and links to other nodes kept together.
+ */
+USTRUCT(BlueprintType)
+struct FHeartNodePin
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	FHeartPinGuid Guid;
+
+	// The Pin Description, which carries all unique instance data about this pin. Usually shared with other nodes of the same class.
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	FHeartPinDescHandle Desc;
+
+	// Links to pins in other nodes.
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	FHeartGraphPinConnections Connections;
+};
+
 // @todo this should not be BlueprintType. it only is temporarily until there is a way to view pins in the editor window without making PinData VisibleInstanceOnly
-// Long-term, it would be nice to make this type not a USTRUCT at all, and swap out the TMaps for the faster one from VoxelCore
 // This struct is *intentionally* not exported, as it should not be accessible to anything but UHeartGraphNode
 
 /**
  * Container for all pin data on a Heart Node, including links to other nodes.
+ * Pins are stored in a single array in the order they were added, as nodes rarely have more than a handful of pins, and
+ * a linear search over one allocation beats hashing into several maps.
  */
 USTRUCT(BlueprintType)
 struct FHeartNodePinData
@@ -40,9 +67,16 @@ struct FHeartNodePinData
 	friend class UHeartGraphNode;
 	friend Heart::Query::FPinQueryResult;
 	friend Heart::API::FPinEdit;
+	friend Heart::Graph::FAdjacencyIndex;
+	friend class UHeartLightweightNodeExtension;
+	friend struct FHeartGraphSnapshot;
+	friend struct FHeartGraphCursor;
 
 protected:
 	void AddPin(FHeartPinGuid NewKey, const FHeartGraphPinDesc& Desc);
+
+	// Make a compact id for a new pin, using the lowest free compact slot. Falls back to a guid if all slots are taken.
+	FHeartPinGuid MakeCompactPinGuid(FName Name) const;
 	bool RemovePin(FHeartPinGuid Key);
 
 	int32 Num() const;
@@ -54,18 +88,26 @@ protected:
 
 	TConstStructView<FHeartGraphPinDesc> ViewPin(const FHeartPinGuid Key) const;
 
-	// Gets a reference to a pin. For a safer function, use ViewPinDesc when possible.
-	FHeartGraphPinDesc& GetPinChecked(FHeartPinGuid Key);
+	// Gets a mutable reference to a pin, detaching it from shared descriptions. For a safer function, use ViewPinDesc when possible.
+	// Outer is required, and takes ownership of the pin's metadata.
+	FHeartGraphPinDesc& GetPinChecked(FHeartPinGuid Key, UObject* Outer);
 
 	TConstStructView<FHeartGraphPinConnections> ViewConnections(FHeartPinGuid Key) const;
-	FHeartGraphPinConnections& GetConnectionsMutable(FHeartPinGuid Key);
+	FHeartGraphPinConnections* FindConnectionsMutable(FHeartPinGuid Key);
 
-	void AddConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin);
+	// Link Pin to the pin with Key. Returns false, and ensures, if this node has no such pin.
+	bool AddConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin);
 	bool RemoveConnection(const FHeartPinGuid Key, const FHeartGraphPinReference& Pin);
 
+	// Copy the connections of all linked pins, in the keyed format used by undo mementos.
+	TMap<FHeartPinGuid, FHeartGraphPinConnections> CopyConnections() const;
+
+	// Replace the connections of all pins. Pins not in the map are left without connections.
+	void SetConnections(const TMap<FHeartPinGuid, FHeartGraphPinConnections>& NewConnections);
+
 	FORCEINLINE const FHeartGraphPinConnections& operator[](const FHeartPinGuid Key)
 	{
-		return PinConnections.FindChecked(Key);
+		return Pins[GetPinIndex(Key)].Connections;
 	}
 
 	/**
@@ -74,9 +116,9 @@ protected:
 	template <typename Predicate>
 	TOptional<FHeartPinGuid> Find(Predicate Pred) const
 	{
-		for (auto&& Element : PinDescriptions)
+		for (const FHeartNodePin& Pin : Pins)
 		{
-			if (auto Result = Pred(Element);
+			if (auto Result = Pred(Pin);
 				Result.IsSet())
 			{
 				return Result.GetValue();
@@ -85,15 +127,31 @@ protected:
 		return NullOpt;
 	}
 
-	// Maps pins to their Pin Description, which carries all unique instance data about
-	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	TMap<FHeartPinGuid, FHeartGraphPinDesc> PinDescriptions;
+public:
+	void PostSerialize(const FArchive& Ar);
 
-	// Maps pins to their connections in other nodes.
+protected:
+	// All pins on the node, in the order they were added.
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	TMap<FHeartPinGuid, FHeartGraphPinConnections> PinConnections;
+	TArray<FHeartNodePin> Pins;
 
-	// Maintains the original order of pins as added to the node.
-	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
-	TMap<FHeartPinGuid, int32> PinOrder;
+	// Pre-array storage, migrated into Pins on load. Not editor-only, as uncooked content and save games can be loaded
+	// by any build.
+	UPROPERTY()
+	TMap<FHeartPinGuid, FHeartGraphPinDesc> PinDescriptions_DEPRECATED;
+
+	UPROPERTY()
+	TMap<FHeartPinGuid, FHeartGraphPinConnections> PinConnections_DEPRECATED;
+
+	UPROPERTY()
+	TMap<FHeartPinGuid, int32> PinOrder_DEPRECATED;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHeartNodePinData> : public TStructOpsTypeTraitsBase2<FHeartNodePinData>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartGraphPinDesc.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+
+#include "HeartPinDescHandle.generated.h"
+
+/**
+ * Reference to a pin description that may be shared with other pins. Descriptions are interned, so every pin with an
+ * identical description points to the same copy. Metadata objects are compared by identity, so pins built from the same
+ * defaults share one copy, while pins that own their metadata do not. Mutating a description through GetMutable detaches
+ * it first, and moves its metadata into the given outer, so customizing one pin never affects another.
+ * Serializes as a full description, and re-interns when loaded. Metadata owned by the object being duplicated or
+ * imported is remapped by the archive, and text imported into a parent takes ownership of metadata left in another owner.
+ */
+USTRUCT(BlueprintType, meta = (HasNativeBreak = "/Script/Heart.HeartGraphUtils.BreakPinDescHandle"))
+struct HEART_API FHeartPinDescHandle
+{
+	GENERATED_BODY()
+
+	FHeartPinDescHandle() = default;
+	explicit FHeartPinDescHandle(const FHeartGraphPinDesc& InDesc);
+
+	bool IsValid() const { return Desc.IsValid(); }
+
+	const FHeartGraphPinDesc& Get() const { return Desc.IsValid() ? *Desc : Heart::Graph::InvalidPinDesc; }
+	const FHeartGraphPinDesc& operator*() const { return Get(); }
+	const FHeartGraphPinDesc* operator->() const { return &Get(); }
+
+	// Get a description that can be modified, copying it first if it is interned or shared. Outer is required, and
+	// takes ownership of every metadata object of the returned description.
+	FHeartGraphPinDesc& GetMutable(UObject* Outer);
+
+	// Is this description shared through the intern table?
+	bool IsInterned() const { return Interned; }
+
+	bool Serialize(FArchive& Ar);
+	bool Identical(const FHeartPinDescHandle* Other, uint32 PortFlags) const;
+	bool ExportTextItem(FString& ValueStr, const FHeartPinDescHandle& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
+	bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
+	void AddStructReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	// Replace each metadata object not owned by Outer with a duplicate that is.
+	static void DuplicateMetadata(FHeartGraphPinDesc& InDesc, UObject* Outer);
+
+	// Is this metadata object owned by an instance other than Parent, rather than by a class or its defaults?
+	static bool IsOwnedByOtherInstance(const UHeartGraphPinMetadata* Metadata, const UObject* Parent);
+
+	TSharedPtr<FHeartGraphPinDesc> Desc;
+	bool Interned = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHeartPinDescHandle> : public TStructOpsTypeTraitsBase2<FHeartPinDescHandle>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithIdentical = true,
+		WithExportTextItem = true,
+		WithImportTextItem = true,
+		WithAddStructReferencedObjects = true,
+	};
+};
+
+namespace Heart::Graph
+{
+	/**
+	 * Process-wide table of interned pin descriptions. Entries are weakly held, and are released when no pin uses them.
+	 */
+	class HEART_API FPinDescTable
+	{
+	public:
+		static FPinDescTable& Get();
+
+		// Find or add a shared copy of a description. Metadata objects are compared by identity, not by value.
+		TSharedPtr<FHeartGraphPinDesc> Intern(const FHeartGraphPinDesc& Desc);
+
+		// Number of live interned descriptions.
+		int32 Num() const;
+
+	private:
+		static uint32 HashDesc(const FHeartGraphPinDesc& Desc);
+		void PurgeStale();
+
+		mutable FCriticalSection Lock;
+		TMultiMap<uint32, TWeakPtr<FHeartGraphPinDesc>> Entries;
+		int32 AddsSincePurge = 0;
+	};
+}
@@ -4,23 +4,54 @@
 
 #include "HeartGraphPinDesc.h"
 #include "HeartGuids.h"
+#include "HeartPinData.h"
 #include "HeartQueries.h"
 
-struct FHeartNodePinData;
-
 namespace Heart::Query
 {
 	class HEART_API FPinQueryResult : public TMapQueryBase<FPinQueryResult, FHeartPinGuid, FHeartGraphPinDesc>
 	{
 		friend TMapQueryBase;
 
+		struct FPinPair
+		{
+			FHeartPinGuid Key;
+			const FHeartGraphPinDesc& Value;
+		};
+
+		class FIterator
+		{
+		public:
+			explicit FIterator(const FHeartNodePin* Pin)
+			  : Pin(Pin) {}
+
+			FIterator& operator++()
+			{
+				++Pin;
+				return *this;
+			}
+
+			FORCEINLINE bool operator==(const FIterator& Other) const { return Pin == Other.Pin; }
+			FORCEINLINE bool operator!=(const FIterator& Other) const { return Pin != Other.Pin; }
+
+			FORCEINLINE FPinPair operator*() const { return {Pin->Guid, Pin->Desc.Get()}; }
+
+		private:
+			const FHeartNodePin* Pin;
+		};
+
 	public:
 		FPinQueryResult(const FHeartNodePinData& Src);
 
 		// Sort the results by their Pin Order
 		FPinQueryResult& CustomSort();
 
-		const TMap<FHeartPinGuid, FHeartGraphPinDesc>& SimpleData() const;
+		int32 SrcNum() const { return Reference.Pins.Num(); }
+
+		const FHeartGraphPinDesc& operator[](FHeartPinGuid Key) const;
+
+		FIterator begin() const { return FIterator(Reference.Pins.GetData()); }
+		FIterator end  () const { return FIterator(Reference.Pins.GetData() + Reference.Pins.Num()); }
 
 	private:
 		const FHeartNodePinData& Reference;
@@ -2,7 +2,12 @@
 
 #pragma once
 
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
 #include "Containers/Array.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/Optional.h"
+#include "Templates/Function.h"
 #include "Templates/UnrealTypeTraits.h"
 
 namespace Heart::Query
@@ -27,11 +32,92 @@ namespace Heart::Query
 		// Instead of making redundant calls, the projection results will be cached in a map, so each key is only ran
 		// through the callback once.
 		ProjectionCache = 1 << 0,
+
+		// Run Filter, ForEach, and Sort across worker threads once there are enough results. Predicates and projections
+		// must be safe to call concurrently. Filter and Sort results are identical to the serial ones, as every sort is stable.
+		Parallel = 1 << 1,
+
+		// Defer Filter, Transform, and Invert until a result is needed, then run them as one pass over the keys.
+		// First, Any, Count, Num, and Find stop as soon as they have their answer, without storing intermediate results.
+		Lazy = 1 << 2,
 	};
 	ENUM_CLASS_FLAGS(EFlags)
 
 	enum EInvert { No, Invert };
 
+	// Below this many results, a Parallel query runs serially anyway.
+	static constexpr int32 DefaultParallelMinNum = 4096;
+
+	namespace Impl
+	{
+		// Smallest slice of results handed to a single task.
+		static constexpr int32 MinParallelChunkSize = 512;
+
+		inline int32 GetNumParallelChunks(const int32 Num)
+		{
+			const int32 MaxChunks = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads() * 4);
+			return FMath::Clamp(FMath::DivideAndRoundUp(Num, MinParallelChunkSize), 1, MaxChunks);
+		}
+
+		// Call Body(Start, End) for contiguous slices of [0, Num) across worker threads.
+		template <typename BodyType>
+		void ParallelForChunks(const int32 Num, const int32 NumChunks, BodyType Body)
+		{
+			const int32 ChunkSize = FMath::DivideAndRoundUp(Num, NumChunks);
+			ParallelFor(NumChunks,
+				[&](const int32 Chunk)
+				{
+					const int32 Start = Chunk * ChunkSize;
+					const int32 End = FMath::Min(Start + ChunkSize, Num);
+					if (Start < End)
+					{
+						Body(Chunk, Start, End);
+					}
+				});
+		}
+
+		// Merge sort with the leaf chunks and each level of merges run in parallel. Stable, so the order of equal
+		// elements doesn't depend on how the work was split.
+		template <typename T, typename PredicateType>
+		void ParallelStableSort(TArray<T>& Array, const PredicateType& Pred, const int32 NumChunks)
+		{
+			const int32 Num = Array.Num();
+			const int32 ChunkSize = FMath::DivideAndRoundUp(Num, NumChunks);
+
+			ParallelForChunks(Num, NumChunks,
+				[&](int32, const int32 Start, const int32 End)
+				{
+					TArrayView<T> Slice(Array.GetData() + Start, End - Start);
+					Algo::StableSort(Slice, Pred);
+				});
+
+			TArray<T> Scratch;
+			Scratch.SetNum(Num);
+
+			for (int32 Width = ChunkSize; Width < Num; Width *= 2)
+			{
+				ParallelFor(FMath::DivideAndRoundUp(Num, Width * 2),
+					[&](const int32 Merge)
+					{
+						const int32 Lo = Merge * Width * 2;
+						const int32 Mid = FMath::Min(Lo + Width, Num);
+						const int32 Hi = FMath::Min(Lo + Width * 2, Num);
+
+						int32 L = Lo, R = Mid, Out = Lo;
+						while (L < Mid && R < Hi)
+						{
+							// Take from the left unless the right is strictly less, to stay stable.
+							Scratch[Out++] = Pred(Array[R], Array[L]) ? Array[R++] : Array[L++];
+						}
+						while (L < Mid) Scratch[Out++] = Array[L++];
+						while (R < Hi) Scratch[Out++] = Array[R++];
+					});
+
+				Swap(Array, Scratch);
+			}
+		}
+	}
+
 	/**
 	 * Map Queries are classes that can filter/sort/iterate keys of a TMap or map-like data structure.
 	 * They *never* mutate the underlying data.
@@ -50,7 +136,7 @@ namespace Heart::Query
 			// A function that returns a TMap of the data to query. This is usually all that is required to implement for simple query types
 			GENERATE_MEMBER_FUNCTION_CHECK(SimpleData, const FSimpleData&, const, );
 
-			// Replaces the fallback Algo::Sort function with a custom one.
+			// Replaces the fallback Algo::StableSort function with a custom one.
 			GENERATE_MEMBER_FUNCTION_CHECK(CustomSort, QueryType&,, );
 
 			static constexpr bool PassKeyByRef = EnumHasAnyFlags(ClassFlags, EClassFlags::PassKeyByRef);
@@ -87,7 +173,8 @@ namespace Heart::Query
 		FORCEINLINE		  QueryType& AsType()		{ return *static_cast<		QueryType*>(this); }
 		FORCEINLINE const QueryType& AsType() const { return *static_cast<const QueryType*>(this); }
 
-		FORCEINLINE auto Lookup(KeyType Key) const
+		// Returns a reference when the source data provides one, to avoid copying values.
+		FORCEINLINE decltype(auto) Lookup(KeyType Key) const
 		{
 			if constexpr (FImplFeatures::template THasMemberFunction_SimpleData<QueryType>::Value)
 			{
@@ -158,6 +245,162 @@ namespace Heart::Query
 			}
 		};
 
+		// Evaluate a filter predicate of any supported signature against a key.
+		template <EInvert Invert, typename Predicate>
+		FORCEINLINE bool Test(Predicate& Pred, const PassedKey Key) const
+		{
+			if constexpr (TIsPredicate<Predicate, bool>::IsKeyPredicate)
+			{
+				return Eval<Invert>(Pred(Key));
+			}
+			else if constexpr (TIsPredicate<Predicate, bool>::IsValuePredicate)
+			{
+				return Eval<Invert>(Pred(Lookup(Key)));
+			}
+			else
+			{
+				return Eval<Invert>(Pred(Key, Lookup(Key)));
+			}
+		}
+
+		// Call an iteration predicate of any supported signature for a key.
+		template <typename Predicate>
+		FORCEINLINE void Visit(Predicate& Pred, const PassedKey Key) const
+		{
+			if constexpr (TIsPredicate<Predicate>::IsKeyPredicate)
+			{
+				Pred(Key);
+			}
+
+			if constexpr (TIsPredicate<Predicate>::IsValuePredicate)
+			{
+				Pred(Lookup(Key));
+			}
+
+			if constexpr (TIsPredicate<Predicate>::IsKeyValuePredicate)
+			{
+				Pred(Key, Lookup(Key));
+			}
+		}
+
+		bool ShouldRunParallel(const int32 InNum) const
+		{
+			return EnumHasAnyFlags(Flags, EFlags::Parallel) && InNum >= ParallelMinNum;
+		}
+
+		bool IsLazy() const
+		{
+			return EnumHasAnyFlags(Flags, EFlags::Lazy);
+		}
+
+		// Number of keys the pending pipeline will run over.
+		int32 CandidateNum() const
+		{
+			return Results.IsSet() ? Results->Num() : RefNum();
+		}
+
+		// A deferred stage. Returns false to drop the key, and may rewrite it.
+		using FStage = TFunction<bool(const TMapQueryBase& Query, KeyType& Key)>;
+
+		void AddStage(FStage&& Stage)
+		{
+			if (!Pipeline.IsSet())
+			{
+				Pipeline.Emplace(MoveTemp(Stage));
+				return;
+			}
+
+			FStage Fused = [Prev = MoveTemp(Pipeline.GetValue()), Next = MoveTemp(Stage)](const TMapQueryBase& Query, KeyType& Key)
+				{
+					return Prev(Query, Key) && Next(Query, Key);
+				};
+			Pipeline.Emplace(MoveTemp(Fused));
+		}
+
+		/**
+		 * Visit the keys that survive the pending pipeline, without storing them. Visitor returns false to stop early.
+		 * Returns false if stopped early.
+		 */
+		template <typename VisitorType>
+		bool VisitPipelined(VisitorType Visitor) const
+		{
+			auto Run = [&](KeyType Key)
+				{
+					if (Pipeline.IsSet() && !Pipeline.GetValue()(*this, Key))
+					{
+						return true;
+					}
+					return Visitor(static_cast<PassedKey>(Key));
+				};
+
+			if (Results.IsSet())
+			{
+				for (auto&& Key : Results.GetValue())
+				{
+					if (!Run(Key)) return false;
+				}
+			}
+			else
+			{
+				for (auto&& Element : FQueryRange(this))
+				{
+					if (!Run(Element.Key)) return false;
+				}
+			}
+
+			return true;
+		}
+
+		// Keep the keys for which Fn returns true, in order. Fn may rewrite the key it is given.
+		template <typename FnType>
+		void CompactResults(FnType&& Fn)
+		{
+			FStorage& Keys = Results.GetValue();
+
+			if (ShouldRunParallel(Keys.Num()))
+			{
+				// Each chunk keeps its survivors in its own buffer, and the buffers are joined in chunk order.
+				const int32 NumChunks = Impl::GetNumParallelChunks(Keys.Num());
+				TArray<FStorage> Kept;
+				Kept.SetNum(NumChunks);
+
+				Impl::ParallelForChunks(Keys.Num(), NumChunks,
+					[&](const int32 Chunk, const int32 Start, const int32 End)
+					{
+						FStorage& Out = Kept[Chunk];
+						Out.Reserve(End - Start);
+						for (int32 i = Start; i < End; ++i)
+						{
+							KeyType Key = Keys[i];
+							if (Fn(Key))
+							{
+								Out.Add(MoveTemp(Key));
+							}
+						}
+					});
+
+				Keys.Reset();
+				for (FStorage& Chunk : Kept)
+				{
+					Keys.Append(MoveTemp(Chunk));
+				}
+			}
+			else
+			{
+				// Compact in place, preserving order.
+				int32 NumKept = 0;
+				for (int32 i = 0; i < Keys.Num(); ++i)
+				{
+					KeyType Key = Keys[i];
+					if (Fn(Key))
+					{
+						Keys[NumKept++] = MoveTemp(Key);
+					}
+				}
+				Keys.SetNum(NumKept, EAllowShrinking::No);
+			}
+		}
+
 	public:
 		// Enable query features
 		QueryType& Enable(const EFlags InFlags)
@@ -173,6 +416,19 @@ namespace Heart::Query
 			return AsType();
 		}
 
+		// Opt in to deferred, fused execution of filters. See EFlags::Lazy.
+		QueryType& Lazy()
+		{
+			return Enable(EFlags::Lazy);
+		}
+
+		// Opt in to parallel execution for queries with at least MinNum results. See EFlags::Parallel.
+		QueryType& InParallel(const int32 MinNum = DefaultParallelMinNum)
+		{
+			ParallelMinNum = MinNum;
+			return Enable(EFlags::Parallel);
+		}
+
 		/**
 		 * Removes all results from the query that fail a predicate.
 		 */
@@ -183,33 +439,50 @@ namespace Heart::Query
 		>
 		QueryType& Filter(Predicate Pred)
 		{
-			InitResults();
-
-			for (auto It = Results.GetValue().CreateIterator(); It; ++It)
+			if (IsLazy())
 			{
-				if constexpr (TIsPredicate<Predicate, bool>::IsKeyPredicate)
-				{
-					if (!Eval<Invert>(Pred(*It)))
+				AddStage([Pred](const TMapQueryBase& Query, KeyType& Key) mutable
 					{
-						It.RemoveCurrentSwap();
-					}
-				}
+						return Query.template Test<Invert>(Pred, Key);
+					});
+				return AsType();
+			}
 
-				if constexpr (TIsPredicate<Predicate, bool>::IsValuePredicate)
-				{
-					if (!Eval<Invert>(Pred(Lookup(*It))))
-					{
-						It.RemoveCurrentSwap();
-					}
-				}
+			InitResults();
 
-				if constexpr (TIsPredicate<Predicate, bool>::IsKeyValuePredicate)
+			CompactResults([&Pred, this](const KeyType& Key)
 				{
-					if (!Eval<Invert>(Pred(*It, Lookup(*It))))
+					return Test<Invert>(Pred, Key);
+				});
+
+			return AsType();
+		}
+
+		/**
+		 * Replace each result with the key returned by Func. Values are looked up by the new keys, so Func must only
+		 * return keys that exist in the source data if later stages use values.
+		 */
+		template <
+			typename TransformType
+			UE_REQUIRES(std::is_invocable_r_v<KeyType, TransformType, PassedKey>)
+		>
+		QueryType& Transform(TransformType Func)
+		{
+			if (IsLazy())
+			{
+				AddStage([Func](const TMapQueryBase&, KeyType& Key) mutable
 					{
-						It.RemoveCurrentSwap();
-					}
-				}
+						Key = Func(Key);
+						return true;
+					});
+				PipelineTransforms = true;
+				return AsType();
+			}
+
+			InitResults();
+			for (KeyType& Key : Results.GetValue())
+			{
+				Key = Func(Key);
 			}
 
 			return AsType();
@@ -231,13 +504,11 @@ namespace Heart::Query
 
 			InitResults();
 
-			for (auto It = Results.GetValue().CreateIterator(); It; ++It)
-			{
-				if (!Eval<Invert>(Delegate.Execute(Lookup(*It))))
+			// Delegates may call into script, so this always runs serially, and keeps the survivors in order.
+			Results.GetValue().RemoveAll([&Delegate, this](const KeyType& Key)
 				{
-					It.RemoveCurrentSwap();
-				}
-			}
+					return !Eval<Invert>(Delegate.Execute(Lookup(Key)));
+				});
 
 			return AsType();
 		}
@@ -256,13 +527,11 @@ namespace Heart::Query
 
 			InitResults();
 
-			for (auto It = Results.GetValue().CreateIterator(); It; ++It)
-			{
-				if (!Eval<Invert>(Delegate.Execute(Lookup(*It))))
+			// Delegates may call into script, so this always runs serially, and keeps the survivors in order.
+			Results.GetValue().RemoveAll([&Delegate, this](const KeyType& Key)
 				{
-					It.RemoveCurrentSwap();
-				}
-			}
+					return !Eval<Invert>(Delegate.Execute(Lookup(Key)));
+				});
 
 			return AsType();
 		}
@@ -276,6 +545,25 @@ namespace Heart::Query
 		{
 			if (InInvert == EInvert::Invert)
 			{
+				// Over the whole dataset, inverting the pending stages is just negating them. Once transformed, or
+				// narrowed by stored results, the stages have to run first.
+				if (IsLazy() && !Results.IsSet() && !PipelineTransforms)
+				{
+					if (Pipeline.IsSet())
+					{
+						FStage Negated = [Prev = MoveTemp(Pipeline.GetValue())](const TMapQueryBase& Query, KeyType& Key)
+							{
+								return !Prev(Query, Key);
+							};
+						Pipeline.Emplace(MoveTemp(Negated));
+						return AsType();
+					}
+				}
+				else if (Pipeline.IsSet())
+				{
+					InitResults();
+				}
+
 				// Results not being set is implicitly equal to the entire dataset, so the inversion is empty.
 				// Likewise, if the Num in both arrays match, then they contain the same data as well.
 				if (!Results.IsSet() || Results->Num() == RefNum())
@@ -302,10 +590,10 @@ namespace Heart::Query
 				}
 
 				// ... remove all elements currently in the result...
-				ForEach([&NewResults](const PassedKey Key)
-					{
-						NewResults.RemoveSingleSwap(Key);
-					});
+				for (auto&& Key : Results.GetValue())
+				{
+					NewResults.RemoveSingleSwap(Key);
+				}
 				NewResults.Shrink();
 
 				// ...and assign.
@@ -317,6 +605,7 @@ namespace Heart::Query
 
 		/**
 		 * Iterate over all results currently in the query.
+		 * When running in parallel, Pred is called concurrently, and in no particular order.
 		 */
 		template <
 			typename Predicate
@@ -324,24 +613,33 @@ namespace Heart::Query
 		>
 		QueryType& ForEach(Predicate Pred)
 		{
-			if (Results.IsSet())
+			if (Pipeline.IsSet() && !ShouldRunParallel(CandidateNum()))
 			{
-				for (auto&& Key : Results.GetValue())
-				{
-					if constexpr (TIsPredicate<Predicate>::IsKeyPredicate)
-					{
-						Pred(Key);
-					}
-
-					if constexpr (TIsPredicate<Predicate>::IsValuePredicate)
+				VisitPipelined([&](const PassedKey Key)
 					{
-						Pred(Lookup(Key));
-					}
+						Visit(Pred, Key);
+						return true;
+					});
+			}
+			else if (ShouldRunParallel(CandidateNum()))
+			{
+				InitResults();
 
-					if constexpr (TIsPredicate<Predicate>::IsKeyValuePredicate)
+				const FStorage& Keys = Results.GetValue();
+				Impl::ParallelForChunks(Keys.Num(), Impl::GetNumParallelChunks(Keys.Num()),
+					[&](int32, const int32 Start, const int32 End)
 					{
-						Pred(Key, Lookup(Key));
-					}
+						for (int32 i = Start; i < End; ++i)
+						{
+							Visit(Pred, Keys[i]);
+						}
+					});
+			}
+			else if (Results.IsSet())
+			{
+				for (auto&& Key : Results.GetValue())
+				{
+					Visit(Pred, Key);
 				}
 			}
 			else
@@ -379,7 +677,15 @@ namespace Heart::Query
 		{
 			FCallback Delegate = FCallback::CreateUObject(InUserObject, InFunc, Forward<VarTypes>(Vars)...);
 
-			if (Results.IsSet())
+			if (Pipeline.IsSet())
+			{
+				VisitPipelined([&](const PassedKey Key)
+					{
+						Delegate.Execute(Lookup(Key));
+						return true;
+					});
+			}
+			else if (Results.IsSet())
 			{
 				for (auto&& Key : Results.GetValue())
 				{
@@ -406,7 +712,15 @@ namespace Heart::Query
 		{
 			FCallback Delegate = FCallback::CreateUObject(InUserObject, InFunc, Forward<VarTypes>(Vars)...);
 
-			if (Results.IsSet())
+			if (Pipeline.IsSet())
+			{
+				VisitPipelined([&](const PassedKey Key)
+					{
+						Delegate.Execute(Lookup(Key));
+						return true;
+					});
+			}
+			else if (Results.IsSet())
 			{
 				for (auto&& Key : Results.GetValue())
 				{
@@ -427,6 +741,21 @@ namespace Heart::Query
 		template <typename Predicate>
 		TOptional<KeyType> Find(Predicate Pred) const
 		{
+			if (Pipeline.IsSet())
+			{
+				TOptional<KeyType> Found;
+				VisitPipelined([&](const PassedKey Key)
+					{
+						if (Pred(Lookup(Key)))
+						{
+							Found = Key;
+							return false;
+						}
+						return true;
+					});
+				return Found;
+			}
+
 			if (Results.IsSet())
 			{
 				for (auto&& Key : Results.GetValue())
@@ -460,8 +789,7 @@ namespace Heart::Query
 			}
 			else
 			{
-				InitResults();
-				Algo::Sort(Results.GetValue());
+				return Sort(TLess<>());
 			}
 
 			return AsType();
@@ -474,7 +802,16 @@ namespace Heart::Query
 		QueryType& Sort(Predicate Pred)
 		{
 			InitResults();
-			Algo::Sort(Results.GetValue(), Pred);
+
+			if (ShouldRunParallel(Results->Num()))
+			{
+				Impl::ParallelStableSort(Results.GetValue(), Pred, Impl::GetNumParallelChunks(Results->Num()));
+			}
+			else
+			{
+				Algo::StableSort(Results.GetValue(), Pred);
+			}
+
 			return AsType();
 		}
 
@@ -495,7 +832,53 @@ namespace Heart::Query
 
 			InitResults();
 
-			if (EnumHasAnyFlags(Flags, ProjectionCache))
+			if (ShouldRunParallel(Results->Num()))
+			{
+				// Project every key once across the workers, then sort indices by the projections. This also
+				// makes ProjectionCache redundant.
+				FStorage& Keys = Results.GetValue();
+				const int32 NumChunks = Impl::GetNumParallelChunks(Keys.Num());
+				const int32 ChunkSize = FMath::DivideAndRoundUp(Keys.Num(), NumChunks);
+
+				TArray<TArray<RetType>> Scores;
+				Scores.SetNum(NumChunks);
+				Impl::ParallelForChunks(Keys.Num(), NumChunks,
+					[&](const int32 Chunk, const int32 Start, const int32 End)
+					{
+						Scores[Chunk].Reserve(End - Start);
+						for (int32 i = Start; i < End; ++i)
+						{
+							Scores[Chunk].Emplace(Proj(Keys[i]));
+						}
+					});
+
+				auto ScoreOf = [&](const int32 Index) -> const RetType&
+					{
+						return Scores[Index / ChunkSize][Index % ChunkSize];
+					};
+
+				TArray<int32> Order;
+				Order.Reserve(Keys.Num());
+				for (int32 i = 0; i < Keys.Num(); ++i)
+				{
+					Order.Add(i);
+				}
+
+				Impl::ParallelStableSort(Order,
+					[&](const int32 A, const int32 B)
+					{
+						return Pred(ScoreOf(A), ScoreOf(B));
+					}, NumChunks);
+
+				FStorage Sorted;
+				Sorted.Reserve(Keys.Num());
+				for (const int32 Index : Order)
+				{
+					Sorted.Add(Keys[Index]);
+				}
+				Keys = MoveTemp(Sorted);
+			}
+			else if (EnumHasAnyFlags(Flags, ProjectionCache))
 			{
 				TMap<KeyType, RetType> Scores;
 
@@ -512,14 +895,14 @@ namespace Heart::Query
 						return RetVal;
 					};
 
-				Algo::SortBy(Results.GetValue(), CachingProjection, Pred);
+				Algo::StableSortBy(Results.GetValue(), CachingProjection, Pred);
 			}
 			else
 			{
-				Algo::SortBy(Results.GetValue(), Proj, Pred);
+				Algo::StableSortBy(Results.GetValue(), Proj, Pred);
 			}
 
-            return AsType();
+			return AsType();
 		}
 
 		// Inline sort by predicate if boolean is true
@@ -541,8 +924,48 @@ namespace Heart::Query
 			return Results.GetValue();
 		}
 
+		// The first result, if there are any.
+		TOptional<KeyType> First() const
+		{
+			TOptional<KeyType> Found;
+			VisitPipelined([&](const PassedKey Key)
+				{
+					Found = Key;
+					return false;
+				});
+			return Found;
+		}
+
+		// Are there any results?
+		bool Any() const
+		{
+			return First().IsSet();
+		}
+
+		// Count the results, running any pending stages without storing their output.
+		int32 Count() const
+		{
+			if (!Pipeline.IsSet())
+			{
+				return Num();
+			}
+
+			int32 Count = 0;
+			VisitPipelined([&Count](const PassedKey)
+				{
+					Count++;
+					return true;
+				});
+			return Count;
+		}
+
 		int32 Num() const
 		{
+			if (Pipeline.IsSet())
+			{
+				return Count();
+			}
+
 			// If results has been initialized return that num
 			if (Results.IsSet())
 			{
@@ -555,9 +978,41 @@ namespace Heart::Query
 
 		FORCEINLINE bool IsEmpty() const
 		{
+			if (Pipeline.IsSet())
+			{
+				return !Any();
+			}
 			return Num() == 0;
 		}
 
+	protected:
+		// Narrow the results to Keys, which must all exist in the source data. Lets implementations answer a filter from
+		// their own indexes: when nothing has been stored yet, Keys become the results as-is, without a pass over the
+		// source data.
+		QueryType& Restrict(FStorage&& Keys)
+		{
+			// Pending filters still apply to the narrowed keys, but transforms change which keys narrowing applies to.
+			if (PipelineTransforms)
+			{
+				InitResults();
+			}
+
+			if (!Results.IsSet())
+			{
+				Results = MoveTemp(Keys);
+				return AsType();
+			}
+
+			TSet<KeyType> Allowed;
+			Allowed.Append(Keys);
+			CompactResults([&Allowed](const KeyType& Key)
+				{
+					return Allowed.Contains(Key);
+				});
+
+			return AsType();
+		}
+
 	private:
 		// This function makes a copy of the reference data, and stores it in Results, where it can be pruned down by
 		// filters, or re-ordered by sorting.
@@ -573,9 +1028,28 @@ namespace Heart::Query
 				}
 				checkSlow(Results->Num() == RefNum())
 			}
+
+			// Run pending stages over the stored results.
+			if (Pipeline.IsSet())
+			{
+				FStage Stages = MoveTemp(Pipeline.GetValue());
+				Pipeline.Reset();
+				PipelineTransforms = false;
+
+				CompactResults([&Stages, this](KeyType& Key)
+					{
+						return Stages(*this, Key);
+					});
+			}
 		}
 
 		TOptional<FStorage> Results;
-		EFlags Flags;
+
+		// Stages deferred while Lazy
+		TOptional<FStage> Pipeline;
+		bool PipelineTransforms = false;
+
+		EFlags Flags = NoFlags;
+		int32 ParallelMinNum = DefaultParallelMinNum;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartNodeIndex.h"
+
+namespace Heart::Graph
+{
+	class FAdjacencyIndex;
+	class FTopologicalOrder;
+
+	/**
+	 * Answers "is there a path from A to B" along the out-edges of an FAdjacencyIndex, for acyclic graphs.
+	 *
+	 * Graphs of up to MaxBitsetSlots node slots store their full transitive closure as one bit row per node, so queries
+	 * are O(1) and reachable sets are copied straight out of the row. Inserted edges are folded into the closure in
+	 * O(n²/64) without a rebuild.
+	 *
+	 * Larger graphs store interval labels from a depth-first spanning forest instead, which take O(n) memory. A label
+	 * proves reachability along tree edges, and a second, GRAIL-style label proves unreachability for most other pairs;
+	 * the remaining queries search only the nodes whose labels could still contain the target. Inserted edges invalidate
+	 * the labels.
+	 *
+	 * Removing edges always invalidates the index, and it is rebuilt in a single pass on the next query.
+	 * Opt-in per schema; maintained by FNodeEdit and FPinEdit. Not serialized.
+	 */
+	class HEART_API FReachabilityIndex
+	{
+	public:
+		// Above this many node slots, intervals are used instead of a bitset closure, which would take over 2MB.
+		static constexpr int32 MaxBitsetSlots = 4096;
+
+		bool IsBuilt() const { return Built; }
+
+		// Build the index from scratch. The topological order must be acyclic.
+		void Rebuild(const FAdjacencyIndex& Adjacency, const FTopologicalOrder& Order);
+
+		void Reset();
+
+		// The following do nothing until the index has been built.
+
+		// Make room for a new node. It must not have any edges yet.
+		void AddNode(FHeartNodeIndex Node);
+
+		// Update the index for out-edges that have already been added to the adjacency index.
+		void EdgesAdded(TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges);
+
+		// Notify that out-edges were removed from the adjacency index.
+		void EdgesRemoved() { Reset(); }
+
+		// Is there a path of one or more out-edges from From to To? The index must be built.
+		bool IsReachable(const FAdjacencyIndex& Adjacency, FHeartNodeIndex From, FHeartNodeIndex To) const;
+
+		// Get every node reachable from From, as a bit per node slot. The index must be built.
+		void GetReachable(const FAdjacencyIndex& Adjacency, FHeartNodeIndex From, TBitArray<>& OutSlots) const;
+
+		// Is the transitive closure stored directly, or are interval labels used?
+		bool UsesBitset() const { return RowWords > 0; }
+
+	private:
+		void BuildBitset(const FAdjacencyIndex& Adjacency, TConstArrayView<FHeartNodeIndex> ReverseOrder);
+		void BuildIntervals(const FAdjacencyIndex& Adjacency, TConstArrayView<FHeartNodeIndex> Order);
+
+		uint64* GetRow(const int32 Slot) { return Closure.GetData() + Slot * RowWords; }
+		const uint64* GetRow(const int32 Slot) const { return Closure.GetData() + Slot * RowWords; }
+
+		static bool TestBit(const uint64* Row, const int32 Slot) { return (Row[Slot >> 6] & (1ull << (Slot & 63))) != 0; }
+
+		// Is Descendant below Ancestor in the spanning forest?
+		bool TreeContains(int32 Ancestor, int32 Descendant) const;
+
+		// Could Descendant be reachable from Ancestor? False is certain, true is not.
+		bool LabelContains(int32 Ancestor, int32 Descendant) const;
+
+		bool Built = false;
+
+		// Bitset closure: a row of RowWords words per slot, for slots up to RowWords * 64. Zero when intervals are used.
+		TArray<uint64> Closure;
+		int32 RowWords = 0;
+
+		// Interval labels, by slot. Pre and Post are entry and exit times of the spanning forest, and Low is the lowest
+		// Post of any node reachable from the slot.
+		TArray<int32> Pre;
+		TArray<int32> Post;
+		TArray<int32> Low;
+		int32 Clock = 0;
+
+		// Search scratch, kept between queries to avoid allocations.
+		mutable TBitArray<> Visited;
+		mutable TArray<FHeartNodeIndex> Stack;
+	};
+}
@@ -0,0 +1,93 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "HeartNodeIndex.h"
+
+namespace Heart::Graph
+{
+	class FAdjacencyIndex;
+
+	/**
+	 * Topological order of the nodes in a graph along the out-edges of its FAdjacencyIndex, maintained incrementally with
+	 * the Pearce-Kelly algorithm. Inserting an edge only reorders the nodes ranked between its endpoints, and cycle checks
+	 * are bounded by the same range, so validating a connection on a large DAG rarely touches more than a few nodes.
+	 *
+	 * While the graph contains a cycle the order is suspended, and checks fall back to an unbounded search. Once edges are
+	 * removed again, the order is rebuilt on the next query.
+	 * Bidirectional pins produce edges both ways, so any connection between them is a cycle.
+	 */
+	class HEART_API FTopologicalOrder
+	{
+	public:
+		// Rank every node in the adjacency index from scratch.
+		void Rebuild(const FAdjacencyIndex& Adjacency);
+
+		void Reset();
+
+		// Reserve storage for node slots up to MaxSlot.
+		void Reserve(int32 MaxSlot);
+
+		// Rank a new node after all existing ones. It must not have any edges yet.
+		void AddNode(FHeartNodeIndex Node);
+
+		// Update the order for an out-edge that has already been added to the adjacency index. Returns false if the order is
+		// suspended because the graph contains a cycle. Nodes that were reranked are added to OutReranked, if provided.
+		bool AddEdge(const FAdjacencyIndex& Adjacency, FHeartNodeIndex From, FHeartNodeIndex To, TArray<FHeartNodeIndex>* OutReranked = nullptr);
+
+		// Update the order for several out-edges that have all been added to the adjacency index already.
+		void AddEdges(const FAdjacencyIndex& Adjacency, TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges);
+
+		// Notify that out-edges were removed from the adjacency index. Removal never invalidates an order, but may break a cycle.
+		void EdgesRemoved();
+
+		// Would adding an out-edge between these nodes create a cycle?
+		bool WouldCreateCycle(const FAdjacencyIndex& Adjacency, FHeartNodeIndex From, FHeartNodeIndex To) const;
+
+		// Is the graph currently free of cycles?
+		bool IsAcyclic(const FAdjacencyIndex& Adjacency) const;
+
+		// Position of a node in the order, or INDEX_NONE if unknown. Only meaningful while the graph is acyclic.
+		int32 GetRank(FHeartNodeIndex Node) const;
+
+	private:
+		// Rebuild the order with Kahn's algorithm, if it was suspended and edges have since been removed.
+		void Revalidate(const FAdjacencyIndex& Adjacency) const;
+
+		// Start a new search, clearing all visit marks.
+		void BeginSearch(const FAdjacencyIndex& Adjacency) const;
+
+		// Depth-first search from Start along out-edges, visiting nodes ranked at most MaxRank, or all nodes if MaxRank is INDEX_NONE.
+		// Returns true if Target was reached. Visited nodes are added to OutVisited, if provided.
+		bool SearchForward(const FAdjacencyIndex& Adjacency, FHeartNodeIndex Start, FHeartNodeIndex Target, int32 MaxRank,
+						   TArray<FHeartNodeIndex>* OutVisited) const;
+
+		// Depth-first search from Start against out-edges, visiting nodes ranked at least MinRank.
+		void SearchBackward(const FAdjacencyIndex& Adjacency, FHeartNodeIndex Start, int32 MinRank, TArray<FHeartNodeIndex>& OutVisited) const;
+
+		bool MarkVisited(int32 Slot) const;
+
+		// Are the given edges, and every edge touching one of the given nodes, ordered from lower to higher rank?
+		bool IsOrderedAround(const FAdjacencyIndex& Adjacency, TConstArrayView<TPair<FHeartNodeIndex, FHeartNodeIndex>> Edges,
+							 TConstArrayView<FHeartNodeIndex> Nodes) const;
+
+		// Rank of each node slot. Ranks are unique but not contiguous after nodes are removed.
+		mutable TArray<int32> Ranks;
+		mutable int32 NextRank = 0;
+
+		// False while the graph contains a cycle.
+		mutable bool Acyclic = true;
+
+		// Set when edges are removed from a cyclic graph, and the order should be rebuilt when next needed.
+		mutable bool NeedsRevalidation = false;
+
+		// Set when an out-edge is not mirrored by an in-edge on the other node, which happens when pins of the same direction
+		// are connected. Predecessors cannot be found through in-edges then, so edge insertions rebuild the whole order instead.
+		mutable bool HasUnmirroredEdges = false;
+
+		// Search scratch, kept between queries to avoid allocations. A slot is visited when its mark equals the current epoch.
+		mutable TArray<uint32> VisitMarks;
+		mutable uint32 VisitEpoch = 0;
+		mutable TArray<FHeartNodeIndex> Stack;
+	};
+}
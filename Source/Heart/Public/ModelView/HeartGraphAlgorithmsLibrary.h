@@ -0,0 +1,66 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Model/HeartGuids.h"
+#include "Model/HeartPinDirection.h"
+#include "ModelView/HeartNodeSortingLibrary.h"
+#include "HeartGraphAlgorithmsLibrary.generated.h"
+
+class IHeartGraphInterface;
+
+DECLARE_DYNAMIC_DELEGATE_RetVal_TwoParams(double, FHeartNodeEdgeWeight, const FHeartNodeGuid&, From, const FHeartNodeGuid&, To);
+
+/**
+ * Blueprint access to Heart::Algorithms over the connections of a graph. Connections are followed from Output pins to
+ * Input pins, unless a function takes a Direction.
+ */
+UCLASS()
+class HEART_API UHeartGraphAlgorithmsLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Find all nodes reachable from Start, nearest first.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static TArray<FHeartNodeGuid> BreadthFirstSearch(const TScriptInterface<IHeartGraphInterface> Graph,
+		const FHeartNodeGuid& Start, EHeartPinDirection Direction = EHeartPinDirection::Output);
+
+	// Find all nodes reachable from Start, following each branch to its end before the next.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static TArray<FHeartNodeGuid> DepthFirstSearch(const TScriptInterface<IHeartGraphInterface> Graph,
+		const FHeartNodeGuid& Start, EHeartPinDirection Direction = EHeartPinDirection::Output);
+
+	// Order all nodes so that connections only point forward. Returns false if the graph has a cycle, in which case
+	// Cycle is filled with the nodes of one.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static bool TopologicalSort(const TScriptInterface<IHeartGraphInterface> Graph,
+		TArray<FHeartNodeGuid>& Sorted, TArray<FHeartNodeGuid>& Cycle);
+
+	// Group nodes that can all reach each other.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static TArray<FHeartNodeSet> StronglyConnectedComponents(const TScriptInterface<IHeartGraphInterface> Graph);
+
+	// Group nodes that are connected in any way.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static TArray<FHeartNodeSet> ConnectedComponents(const TScriptInterface<IHeartGraphInterface> Graph);
+
+	// Find the path from one node to another through the fewest connections.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms")
+	static bool FindShortestPath(const TScriptInterface<IHeartGraphInterface> Graph,
+		const FHeartNodeGuid& From, const FHeartNodeGuid& To, TArray<FHeartNodeGuid>& Path);
+
+	// Find the lowest cost path from one node to another. If Weight is not bound, each connection between two nodes
+	// costs the number of pins connecting them. Weights must not be negative.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms", meta = (AutoCreateRefTerm = "Weight"))
+	static bool FindShortestPathWeighted(const TScriptInterface<IHeartGraphInterface> Graph,
+		const FHeartNodeGuid& From, const FHeartNodeGuid& To, const FHeartNodeEdgeWeight& Weight,
+		TArray<FHeartNodeGuid>& Path, double& Cost);
+
+	// Find the highest weight path in a graph without cycles. If Weight is not bound, each connection between two nodes
+	// weighs the number of pins connecting them. Returns false if the graph has a cycle.
+	UFUNCTION(BlueprintCallable, Category = "Heart|GraphAlgorithms", meta = (AutoCreateRefTerm = "Weight"))
+	static bool FindLongestPath(const TScriptInterface<IHeartGraphInterface> Graph,
+		const FHeartNodeEdgeWeight& Weight, TArray<FHeartNodeGuid>& Path, double& Length);
+};
@@ -105,6 +105,10 @@ protected:
 	void RefreshGraphExtensions(UHeartGraph* HeartGraph) const;
 
 public:
+	bool GetUseCompactPinIds() const { return UseCompactPinIds; }
+	bool GetUseNodeLookupIndex() const { return UseNodeLookupIndex; }
+	bool GetUseReachabilityIndex() const { return UseReachabilityIndex; }
+
 #if WITH_EDITOR
 	bool GetRunCanPinsConnectInEdGraph() const { return RunCanPinsConnectInEdGraph; }
 	auto GetEditorLinkerClass() const { return EditorLinkerClass; }
@@ -146,6 +150,26 @@ protected:
 	UPROPERTY(EditAnywhere, Instanced, Category = "Extensions")
 	TArray<TObjectPtr<UHeartGraphExtension>> DefaultExtensions;
 
+	// Disallow connections that would create a cycle, for graphs that must stay directed and acyclic. Connections are
+	// directed away from Output pins, so two Bidirectional pins can never be connected when this is enabled.
+	UPROPERTY(EditAnywhere, Category = "Connections")
+	bool DisallowCycles = false;
+
+	// Give new pins compact, node-local ids instead of guids. Compact ids serialize in less than half the space, which
+	// shrinks saved connections, undo history, and replicated pin references. Existing pins keep their ids.
+	UPROPERTY(EditAnywhere, Category = "Connections")
+	bool UseCompactPinIds = false;
+
+	// Maintain a reachability index of the graph while it is acyclic, so that asking whether one node can be reached
+	// from another, or for everything downstream of a node, doesn't walk connections. Best paired with DisallowCycles.
+	UPROPERTY(EditAnywhere, Category = "Connections")
+	bool UseReachabilityIndex = false;
+
+	// Maintain indexes of nodes by class, node object class, and pin tag, so that node queries by those only visit
+	// matching nodes. Costs some memory and time when nodes and pins are added or removed.
+	UPROPERTY(EditAnywhere, Category = "Nodes")
+	bool UseNodeLookupIndex = false;
+
 #if WITH_EDITORONLY_DATA
 	// Enable to have the runtime function CanPinsConnect called by the EdGraphSchema for this graph.
 	UPROPERTY(EditAnywhere, Category = "Editor")
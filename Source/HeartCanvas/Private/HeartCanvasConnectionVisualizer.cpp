@@ -114,9 +114,9 @@ void UHeartCanvasConnectionVisualizer::PaintTimeDrawPreviewConnection_Implementa
 	DrawConnectionSpline(Context, Start, End, SplineParams);
 }
 
-void UHeartCanvasConnectionVisualizer::PaintTimeDrawPinConnections(FPaintContext& Context, const FGeometry& GraphDesktopGeometry, TMap<FHeartPinGuid, TPair<UHeartGraphCanvasPin*, FGeometry>> Pins)
+void UHeartCanvasConnectionVisualizer::PaintTimeDrawPinConnections(FPaintContext& Context, const FGeometry& GraphDesktopGeometry, TMap<FHeartGraphPinReference, TPair<UHeartGraphCanvasPin*, FGeometry>> Pins)
 {
-	for (const TTuple<FHeartPinGuid, TTuple<UHeartGraphCanvasPin*, FGeometry>>& PinPair : Pins)
+	for (const TTuple<FHeartGraphPinReference, TTuple<UHeartGraphCanvasPin*, FGeometry>>& PinPair : Pins)
 	{
 		if (!ensureMsgf(PinPair.Key.IsValid(),
 			TEXT("PaintTimeDrawPinConnections was given invalid UHeartGraphPin!")))
@@ -156,7 +156,7 @@ void UHeartCanvasConnectionVisualizer::PaintTimeDrawPinConnections(FPaintContext
 		}
 
 		auto ConnectedPins =
-			PinPair.Value.Key->GetCanvasNode()->GetGraphNode()->ViewConnections(PinPair.Key);
+			PinPair.Value.Key->GetCanvasNode()->GetGraphNode()->ViewConnections(PinPair.Key.PinGuid);
 		if (!ConnectedPins.IsValid())
 		{
 			continue;
@@ -164,7 +164,7 @@ void UHeartCanvasConnectionVisualizer::PaintTimeDrawPinConnections(FPaintContext
 
 		for (const FHeartGraphPinReference& ConnectedPin : ConnectedPins.Get())
 		{
-			auto&& ConnectedPinAndGeo = Pins.Find(ConnectedPin.PinGuid);
+			auto&& ConnectedPinAndGeo = Pins.Find(ConnectedPin);
 			if (!ConnectedPinAndGeo) continue;
 
 			auto&& EndGeom = ConnectedPinAndGeo->Value;
@@ -140,7 +140,8 @@ int32 UHeartGraphCanvas::NativePaint(const FPaintArgs& Args, const FGeometry& Al
 	}
 
 	// Get the set of pins for all children and synthesize geometry for culled out pins so lines can be drawn to them.
-	TMap<FHeartPinGuid, TPair<UHeartGraphCanvasPin*, FGeometry>> PinGeometries;
+	// Keyed by full reference, as compact pin ids are only unique within their node.
+	TMap<FHeartGraphPinReference, TPair<UHeartGraphCanvasPin*, FGeometry>> PinGeometries;
 	TSet<UHeartGraphCanvasPin*> VisiblePins;
 	auto LocationInterface = DisplayedGraph->GetNodeLocationInterface();
 
@@ -157,13 +158,13 @@ int32 UHeartGraphCanvas::NativePaint(const FPaintArgs& Args, const FGeometry& Al
 
 			for (UHeartGraphCanvasPin* PinWidget : PinWidgets)
 			{
-				FHeartPinGuid WidgetGuid = PinWidget->GetPinGuid();
-				if (WidgetGuid.IsValid())
+				const FHeartGraphPinReference WidgetPin = PinWidget->GetPinReference();
+				if (WidgetPin.IsValid())
 				{
 					FVector2f PinLoc = NodeLoc; // + PinWidget->GetNodeOffset(); TODO
 
 					const FGeometry SynthesizedPinGeometry(ScalePositionToCanvasZoom_2f(PinLoc) * AllottedGeometry.Scale, AllottedGeometry.AbsolutePosition, FVector2f::ZeroVector, 1.f);
-					PinGeometries.Add(WidgetGuid, {PinWidget, SynthesizedPinGeometry});
+					PinGeometries.Add(WidgetPin, {PinWidget, SynthesizedPinGeometry});
 				}
 			}
 		}
@@ -175,7 +176,7 @@ int32 UHeartGraphCanvas::NativePaint(const FPaintArgs& Args, const FGeometry& Al
 
 	for (auto&& VisiblePin : VisiblePins)
 	{
-		PinGeometries.Add(VisiblePin->GetPinGuid(), {VisiblePin, VisiblePin->GetTickSpaceGeometry() });
+		PinGeometries.Add(VisiblePin->GetPinReference(), {VisiblePin, VisiblePin->GetTickSpaceGeometry() });
 	}
 
 	/*
@@ -195,7 +196,7 @@ int32 UHeartGraphCanvas::NativePaint(const FPaintArgs& Args, const FGeometry& Al
 		if (IsValid(PreviewPin))
 		{
 			auto&& GraphGeo = GetTickSpaceGeometry();
-			FGeometry PinGeo = PinGeometries.Find(PreviewPin->GetPinGuid())->Value;
+			FGeometry PinGeo = PinGeometries.Find(PreviewPin->GetPinReference())->Value;
 
 			FVector2f StartPoint;
 			FVector2f EndPoint;
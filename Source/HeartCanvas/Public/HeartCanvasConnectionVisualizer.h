@@ -55,7 +55,7 @@ public:
 									const FHeartCanvasConnectionPinParams& GeneralParams) const;
 
 	// @todo  GraphDesktopGeometry is a hack because I don't know how to use the Context.AllocatedGeometry correctly
-	void PaintTimeDrawPinConnections(UPARAM(ref) FPaintContext& Context, const FGeometry& GraphDesktopGeometry, TMap<FHeartPinGuid, TPair<UHeartGraphCanvasPin*, FGeometry>> Pins);
+	void PaintTimeDrawPinConnections(UPARAM(ref) FPaintContext& Context, const FGeometry& GraphDesktopGeometry, TMap<FHeartGraphPinReference, TPair<UHeartGraphCanvasPin*, FGeometry>> Pins);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, BlueprintNativeEvent, Category = "Heart|CanvasConnectionVisualizer")
 	void PaintTimeDrawPreviewConnection(UPARAM(ref) FPaintContext& Context, const FVector2f& Start, const FVector2f& End, UHeartGraphCanvasPin* FromPin) const;
@@ -0,0 +1,412 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Algorithms/ForceKernels.h"
+#include "Math/VectorRegister.h"
+
+namespace Nodesoup
+{
+    // Vertices closer than this (squared) are treated as coincident, and exert no force on each other.
+    static constexpr float CoincidentDistanceSqr = 1e-8f;
+
+    void FLayoutPositions::SetNumZeroed(const int32 Num)
+    {
+        X.SetNumZeroed(Num);
+        Y.SetNumZeroed(Num);
+    }
+
+    void FLayoutPositions::Zero(const int32 Num)
+    {
+        X.Reset();
+        Y.Reset();
+        SetNumZeroed(Num);
+    }
+
+    void FLayoutPositions::Set(const TConstArrayView<FVector2D> Positions)
+    {
+        X.SetNumUninitialized(Positions.Num());
+        Y.SetNumUninitialized(Positions.Num());
+        for (int32 i = 0; i < Positions.Num(); i++)
+        {
+            X[i] = static_cast<float>(Positions[i].X);
+            Y[i] = static_cast<float>(Positions[i].Y);
+        }
+    }
+
+    void FLayoutPositions::Get(TArray<FVector2D>& Positions) const
+    {
+        Positions.SetNumUninitialized(Num());
+        for (int32 i = 0; i < Num(); i++)
+        {
+            Positions[i] = FVector2D(X[i], Y[i]);
+        }
+    }
+
+    namespace ForceKernels
+    {
+        static FORCEINLINE float HorizontalSum(const VectorRegister4Float& Vector)
+        {
+            alignas(16) float Lanes[4];
+            VectorStoreAligned(Vector, Lanes);
+            return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+        }
+
+        static void Repulsion_Scalar(const FLayoutPositions& Positions, const float StrengthSqr, const float CutoffSqr,
+            FLayoutPositions& Movements)
+        {
+            const int32 Num = Positions.Num();
+            for (int32 Node = 0; Node < Num; Node++)
+            {
+                for (int32 Other = Node + 1; Other < Num; Other++)
+                {
+                    const float DeltaX = Positions.X[Node] - Positions.X[Other];
+                    const float DeltaY = Positions.Y[Node] - Positions.Y[Other];
+                    const float DistanceSqr = DeltaX * DeltaX + DeltaY * DeltaY;
+                    if (DistanceSqr < CoincidentDistanceSqr || DistanceSqr > CutoffSqr)
+                    {
+                        continue;
+                    }
+
+                    // StrengthSqr / Distance, along Delta / Distance
+                    const float Scale = StrengthSqr / DistanceSqr;
+                    Movements.X[Node] += DeltaX * Scale;
+                    Movements.Y[Node] += DeltaY * Scale;
+                    Movements.X[Other] -= DeltaX * Scale;
+                    Movements.Y[Other] -= DeltaY * Scale;
+                }
+            }
+        }
+
+        static void RepulsionRows_Scalar(const FLayoutPositions& Positions, const float StrengthSqr, const float CutoffSqr,
+            const int32 Begin, const int32 End, FLayoutPositions& Movements)
+        {
+            const int32 Num = Positions.Num();
+            for (int32 Node = Begin; Node < End; Node++)
+            {
+                float SumX = 0.f;
+                float SumY = 0.f;
+
+                for (int32 Other = 0; Other < Num; Other++)
+                {
+                    const float DeltaX = Positions.X[Node] - Positions.X[Other];
+                    const float DeltaY = Positions.Y[Node] - Positions.Y[Other];
+                    const float DistanceSqr = DeltaX * DeltaX + DeltaY * DeltaY;
+                    if (DistanceSqr < CoincidentDistanceSqr || DistanceSqr > CutoffSqr)
+                    {
+                        continue;
+                    }
+
+                    const float Scale = StrengthSqr / DistanceSqr;
+                    SumX += DeltaX * Scale;
+                    SumY += DeltaY * Scale;
+                }
+
+                Movements.X[Node] += SumX;
+                Movements.Y[Node] += SumY;
+            }
+        }
+
+        static void RepulsionRows_Vector(const FLayoutPositions& Positions, const float StrengthSqr, const float CutoffSqr,
+            const int32 Begin, const int32 End, FLayoutPositions& Movements)
+        {
+            const int32 Num = Positions.Num();
+            const int32 NumVector = Num & ~3;
+            const float* RESTRICT X = Positions.X.GetData();
+            const float* RESTRICT Y = Positions.Y.GetData();
+
+            const VectorRegister4Float VStrengthSqr = VectorSetFloat1(StrengthSqr);
+            const VectorRegister4Float VCutoffSqr = VectorSetFloat1(CutoffSqr);
+            const VectorRegister4Float VCoincident = VectorSetFloat1(CoincidentDistanceSqr);
+
+            // Unlike Repulsion_Scalar, every vertex sums the forces from all the others, instead of applying each
+            // pair to both ends. That computes each pair twice, but never has to scatter results to four vertices.
+            for (int32 Node = Begin; Node < End; Node++)
+            {
+                const VectorRegister4Float NodeX = VectorSetFloat1(X[Node]);
+                const VectorRegister4Float NodeY = VectorSetFloat1(Y[Node]);
+                VectorRegister4Float ForceX = VectorZeroFloat();
+                VectorRegister4Float ForceY = VectorZeroFloat();
+
+                for (int32 Other = 0; Other < NumVector; Other += 4)
+                {
+                    const VectorRegister4Float DeltaX = VectorSubtract(NodeX, VectorLoad(X + Other));
+                    const VectorRegister4Float DeltaY = VectorSubtract(NodeY, VectorLoad(Y + Other));
+                    const VectorRegister4Float DistanceSqr = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+
+                    // This also masks out the vertex itself.
+                    const VectorRegister4Float InRange = VectorBitwiseAnd(
+                        VectorCompareGE(DistanceSqr, VCoincident),
+                        VectorCompareLE(DistanceSqr, VCutoffSqr));
+                    const VectorRegister4Float Scale = VectorSelect(InRange, VectorDivide(VStrengthSqr, DistanceSqr), VectorZeroFloat());
+
+                    ForceX = VectorMultiplyAdd(DeltaX, Scale, ForceX);
+                    ForceY = VectorMultiplyAdd(DeltaY, Scale, ForceY);
+                }
+
+                float SumX = HorizontalSum(ForceX);
+                float SumY = HorizontalSum(ForceY);
+
+                for (int32 Other = NumVector; Other < Num; Other++)
+                {
+                    const float DeltaX = X[Node] - X[Other];
+                    const float DeltaY = Y[Node] - Y[Other];
+                    const float DistanceSqr = DeltaX * DeltaX + DeltaY * DeltaY;
+                    if (DistanceSqr < CoincidentDistanceSqr || DistanceSqr > CutoffSqr)
+                    {
+                        continue;
+                    }
+
+                    const float Scale = StrengthSqr / DistanceSqr;
+                    SumX += DeltaX * Scale;
+                    SumY += DeltaY * Scale;
+                }
+
+                Movements.X[Node] += SumX;
+                Movements.Y[Node] += SumY;
+            }
+        }
+
+        void Repulsion(const EForceKernelPath Path, const FLayoutPositions& Positions, const float StrengthSqr,
+            const float Cutoff, FLayoutPositions& Movements)
+        {
+            check(Movements.Num() == Positions.Num());
+
+            if (Path == EForceKernelPath::Vector)
+            {
+                RepulsionRows_Vector(Positions, StrengthSqr, Cutoff * Cutoff, 0, Positions.Num(), Movements);
+            }
+            else
+            {
+                Repulsion_Scalar(Positions, StrengthSqr, Cutoff * Cutoff, Movements);
+            }
+        }
+
+        void RepulsionRows(const EForceKernelPath Path, const FLayoutPositions& Positions, const float StrengthSqr,
+            const float Cutoff, const int32 Begin, const int32 End, FLayoutPositions& Movements)
+        {
+            check(Movements.Num() == Positions.Num());
+            check(0 <= Begin && Begin <= End && End <= Positions.Num());
+
+            if (Path == EForceKernelPath::Vector)
+            {
+                RepulsionRows_Vector(Positions, StrengthSqr, Cutoff * Cutoff, Begin, End, Movements);
+            }
+            else
+            {
+                RepulsionRows_Scalar(Positions, StrengthSqr, Cutoff * Cutoff, Begin, End, Movements);
+            }
+        }
+
+        static FORCEINLINE void AttractEdge(const FLayoutPositions& Positions, const int32 A, const int32 B,
+            const float InvStrength, FLayoutPositions& Movements)
+        {
+            const float DeltaX = Positions.X[A] - Positions.X[B];
+            const float DeltaY = Positions.Y[A] - Positions.Y[B];
+            const float DistanceSqr = DeltaX * DeltaX + DeltaY * DeltaY;
+            if (DistanceSqr < CoincidentDistanceSqr)
+            {
+                return;
+            }
+
+            // Distance^2 / Strength, along Delta / Distance
+            const float Scale = FMath::Sqrt(DistanceSqr) * InvStrength;
+            Movements.X[A] -= DeltaX * Scale;
+            Movements.Y[A] -= DeltaY * Scale;
+            Movements.X[B] += DeltaX * Scale;
+            Movements.Y[B] += DeltaY * Scale;
+        }
+
+        void Attraction(const EForceKernelPath Path, const FLayoutPositions& Positions,
+            const TConstArrayView<int32> EdgesA, const TConstArrayView<int32> EdgesB, const float InvStrength,
+            FLayoutPositions& Movements)
+        {
+            check(EdgesA.Num() == EdgesB.Num());
+            check(Movements.Num() == Positions.Num());
+
+            int32 Edge = 0;
+
+            if (Path == EForceKernelPath::Vector)
+            {
+                const int32 NumVector = EdgesA.Num() & ~3;
+                const float* RESTRICT X = Positions.X.GetData();
+                const float* RESTRICT Y = Positions.Y.GetData();
+
+                const VectorRegister4Float VInvStrength = VectorSetFloat1(InvStrength);
+                const VectorRegister4Float VCoincident = VectorSetFloat1(CoincidentDistanceSqr);
+
+                // Edges are sparse, so their ends are gathered into registers, and only the force math is vectorized.
+                for (; Edge < NumVector; Edge += 4)
+                {
+                    const int32* A = EdgesA.GetData() + Edge;
+                    const int32* B = EdgesB.GetData() + Edge;
+
+                    const VectorRegister4Float DeltaX = VectorSubtract(
+                        MakeVectorRegisterFloat(X[A[0]], X[A[1]], X[A[2]], X[A[3]]),
+                        MakeVectorRegisterFloat(X[B[0]], X[B[1]], X[B[2]], X[B[3]]));
+                    const VectorRegister4Float DeltaY = VectorSubtract(
+                        MakeVectorRegisterFloat(Y[A[0]], Y[A[1]], Y[A[2]], Y[A[3]]),
+                        MakeVectorRegisterFloat(Y[B[0]], Y[B[1]], Y[B[2]], Y[B[3]]));
+                    const VectorRegister4Float DistanceSqr = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+
+                    const VectorRegister4Float Scale = VectorSelect(
+                        VectorCompareGE(DistanceSqr, VCoincident),
+                        VectorMultiply(VectorSqrt(DistanceSqr), VInvStrength),
+                        VectorZeroFloat());
+
+                    alignas(16) float MoveX[4];
+                    alignas(16) float MoveY[4];
+                    VectorStoreAligned(VectorMultiply(DeltaX, Scale), MoveX);
+                    VectorStoreAligned(VectorMultiply(DeltaY, Scale), MoveY);
+
+                    // Scattered one lane at a time, as edges in the same batch may share a vertex.
+                    for (int32 Lane = 0; Lane < 4; Lane++)
+                    {
+                        Movements.X[A[Lane]] -= MoveX[Lane];
+                        Movements.Y[A[Lane]] -= MoveY[Lane];
+                        Movements.X[B[Lane]] += MoveX[Lane];
+                        Movements.Y[B[Lane]] += MoveY[Lane];
+                    }
+                }
+            }
+
+            for (; Edge < EdgesA.Num(); Edge++)
+            {
+                AttractEdge(Positions, EdgesA[Edge], EdgesB[Edge], InvStrength, Movements);
+            }
+        }
+
+        void ApplyMovements(const EForceKernelPath Path, FLayoutPositions& Positions, const FLayoutPositions& Movements,
+            const float MaxDistance)
+        {
+            ApplyMovements(Path, Positions, Movements, MaxDistance, 0, Positions.Num());
+        }
+
+        void ApplyMovements(const EForceKernelPath Path, FLayoutPositions& Positions, const FLayoutPositions& Movements,
+            const float MaxDistance, const int32 Begin, const int32 End)
+        {
+            check(Movements.Num() == Positions.Num());
+            check(0 <= Begin && Begin <= End && End <= Positions.Num());
+
+            int32 Node = Begin;
+
+            if (Path == EForceKernelPath::Vector)
+            {
+                const int32 EndVector = Begin + ((End - Begin) & ~3);
+                const VectorRegister4Float VMaxDistance = VectorSetFloat1(MaxDistance);
+
+                for (; Node < EndVector; Node += 4)
+                {
+                    const VectorRegister4Float MoveX = VectorLoad(Movements.X.GetData() + Node);
+                    const VectorRegister4Float MoveY = VectorLoad(Movements.Y.GetData() + Node);
+                    const VectorRegister4Float Size = VectorSqrt(VectorMultiplyAdd(MoveX, MoveX, VectorMultiply(MoveY, MoveY)));
+
+                    const VectorRegister4Float Scale = VectorSelect(
+                        VectorCompareGE(Size, GlobalVectorConstants::FloatOne),
+                        VectorDivide(VectorMin(Size, VMaxDistance), Size),
+                        VectorZeroFloat());
+
+                    VectorStore(VectorMultiplyAdd(MoveX, Scale, VectorLoad(Positions.X.GetData() + Node)), Positions.X.GetData() + Node);
+                    VectorStore(VectorMultiplyAdd(MoveY, Scale, VectorLoad(Positions.Y.GetData() + Node)), Positions.Y.GetData() + Node);
+                }
+            }
+
+            for (; Node < End; Node++)
+            {
+                const float Size = FMath::Sqrt(Movements.X[Node] * Movements.X[Node] + Movements.Y[Node] * Movements.Y[Node]);
+                // < 1.0: not worth computing
+                if (Size < 1.f)
+                {
+                    continue;
+                }
+
+                const float Scale = FMath::Min(Size, MaxDistance) / Size;
+                Positions.X[Node] += Movements.X[Node] * Scale;
+                Positions.Y[Node] += Movements.Y[Node] * Scale;
+            }
+        }
+
+        FSpringTerms SpringTerms(const EForceKernelPath Path, const FLayoutPositions& Positions, const int32 Vertex,
+            const TConstArrayView<float> Lengths, const TConstArrayView<float> Strengths)
+        {
+            check(Lengths.Num() == Positions.Num() && Strengths.Num() == Positions.Num());
+
+            const int32 Num = Positions.Num();
+            const float* RESTRICT X = Positions.X.GetData();
+            const float* RESTRICT Y = Positions.Y.GetData();
+
+            FSpringTerms Terms;
+            int32 Other = 0;
+
+            if (Path == EForceKernelPath::Vector)
+            {
+                const int32 NumVector = Num & ~3;
+                const VectorRegister4Float VertexX = VectorSetFloat1(X[Vertex]);
+                const VectorRegister4Float VertexY = VectorSetFloat1(Y[Vertex]);
+                const VectorRegister4Float VCoincident = VectorSetFloat1(CoincidentDistanceSqr);
+                const VectorRegister4Float One = GlobalVectorConstants::FloatOne;
+
+                VectorRegister4Float EnergyX = VectorZeroFloat();
+                VectorRegister4Float EnergyY = VectorZeroFloat();
+                VectorRegister4Float XX = VectorZeroFloat();
+                VectorRegister4Float XY = VectorZeroFloat();
+                VectorRegister4Float YY = VectorZeroFloat();
+
+                for (; Other < NumVector; Other += 4)
+                {
+                    const VectorRegister4Float DeltaX = VectorSubtract(VertexX, VectorLoad(X + Other));
+                    const VectorRegister4Float DeltaY = VectorSubtract(VertexY, VectorLoad(Y + Other));
+                    const VectorRegister4Float DistanceSqr = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+
+                    // Zeroing the strength and inverse distance of the vertex itself (and of coincident vertices)
+                    // zeroes every term they contribute.
+                    const VectorRegister4Float Valid = VectorCompareGE(DistanceSqr, VCoincident);
+                    const VectorRegister4Float Strength = VectorSelect(Valid, VectorLoad(Strengths.GetData() + Other), VectorZeroFloat());
+                    const VectorRegister4Float InvDistance = VectorSelect(Valid, VectorDivide(One, VectorSqrt(DistanceSqr)), VectorZeroFloat());
+                    const VectorRegister4Float InvDistanceCubed = VectorMultiply(InvDistance, VectorMultiply(InvDistance, InvDistance));
+                    const VectorRegister4Float Length = VectorLoad(Lengths.GetData() + Other);
+
+                    // Strength * (1 - Length / Distance), along Delta
+                    const VectorRegister4Float Pull = VectorMultiply(Strength, VectorSubtract(One, VectorMultiply(Length, InvDistance)));
+                    EnergyX = VectorMultiplyAdd(DeltaX, Pull, EnergyX);
+                    EnergyY = VectorMultiplyAdd(DeltaY, Pull, EnergyY);
+
+                    const VectorRegister4Float Curve = VectorMultiply(Length, InvDistanceCubed);
+                    XY = VectorMultiplyAdd(VectorMultiply(Strength, Curve), VectorMultiply(DeltaX, DeltaY), XY);
+                    XX = VectorMultiplyAdd(Strength, VectorSubtract(One, VectorMultiply(Curve, VectorMultiply(DeltaY, DeltaY))), XX);
+                    YY = VectorMultiplyAdd(Strength, VectorSubtract(One, VectorMultiply(Curve, VectorMultiply(DeltaX, DeltaX))), YY);
+                }
+
+                Terms.EnergyX = HorizontalSum(EnergyX);
+                Terms.EnergyY = HorizontalSum(EnergyY);
+                Terms.XX = HorizontalSum(XX);
+                Terms.XY = HorizontalSum(XY);
+                Terms.YY = HorizontalSum(YY);
+            }
+
+            for (; Other < Num; Other++)
+            {
+                const float DeltaX = X[Vertex] - X[Other];
+                const float DeltaY = Y[Vertex] - Y[Other];
+                const float DistanceSqr = DeltaX * DeltaX + DeltaY * DeltaY;
+                if (DistanceSqr < CoincidentDistanceSqr)
+                {
+                    continue;
+                }
+
+                const float InvDistance = 1.f / FMath::Sqrt(DistanceSqr);
+                const float Strength = Strengths[Other];
+                const float Length = Lengths[Other];
+
+                const float Pull = Strength * (1.f - Length * InvDistance);
+                Terms.EnergyX += DeltaX * Pull;
+                Terms.EnergyY += DeltaY * Pull;
+
+                const float Curve = Length * InvDistance * InvDistance * InvDistance;
+                Terms.XY += Strength * Curve * DeltaX * DeltaY;
+                Terms.XX += Strength * (1.f - Curve * DeltaY * DeltaY);
+                Terms.YY += Strength * (1.f - Curve * DeltaX * DeltaX);
+            }
+
+            return Terms;
+        }
+    }
+}
@@ -1,94 +1,308 @@
 // Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Algorithms/FruchtermanReingold.h"
+#include "Async/ParallelFor.h"
 #include "Math/Vector2D.h"
 
 namespace Nodesoup
 {
-    FruchtermanReingold::FruchtermanReingold(FGraphView InGraph, const double InStrength)
+    // Cells stop subdividing past this depth, so bodies at (nearly) the same position share a leaf.
+    static constexpr int32 MaxQuadTreeDepth = 32;
+
+    // Graphs smaller than this aren't worth the overhead of a parallel step.
+    static constexpr int32 MinParallelVertices = 256;
+
+    // Parallel steps split work into chunks of these sizes. They are fixed, rather than derived from the number of
+    // worker threads, so that the order forces are summed in, and therefore the result, is always the same.
+    static constexpr int32 VerticesPerChunk = 64;
+    static constexpr int32 EdgesPerChunk = 1024;
+
+    FruchtermanReingold::FruchtermanReingold(FGraphView InGraph, const double InStrength, const double InTheta,
+                                             const EForceKernelPath InKernelPath, const bool InParallel)
         : Graph(InGraph)
         , Strength(InStrength)
         , StrengthSqr(Strength * Strength)
+        , Theta(InTheta)
+        , KernelPath(InKernelPath)
+        , Parallel(InParallel)
         , Temperature(10 * FMath::Sqrt(static_cast<double>(Graph.Num())))
     {
         Movements.SetNumZeroed(Graph.Num());
+
+        for (int32 Node = 0; Node < Graph.Num(); Node++)
+        {
+            for (const int32 Adj : Graph[Node])
+            {
+                // Edges are listed from both ends; self-loops exert no force.
+                if (Adj < Node)
+                {
+                    EdgesA.Add(Node);
+                    EdgesB.Add(Adj);
+                }
+            }
+        }
     }
 
     void FruchtermanReingold::operator()(TArray<FVector2D>& Positions)
     {
-        for (int32 Node = 0; Node < Graph.Num(); Node++)
+        Converted.Set(Positions);
+        (*this)(Converted);
+        Converted.Get(Positions);
+    }
+
+    void FruchtermanReingold::operator()(FLayoutPositions& Positions)
+    {
+        // Forces only apply to the step they were computed in.
+        Movements.Zero(Graph.Num());
+
+        if (Parallel && Graph.Num() >= MinParallelVertices)
+        {
+            ParallelStep(Positions);
+        }
+        else
         {
-            // Repulsion force between vertex pairs
-            for (int32 Adj = Node + 1; Adj < Graph.Num(); Adj++)
+            SerialStep(Positions);
+        }
+
+        // Cool down fast until we reach 1.5, then stay at low temperature
+        if (Temperature > 1.5)
+        {
+            Temperature *= 0.85;
+        }
+        else
+        {
+            Temperature = 1.5;
+        }
+    }
+
+    void FruchtermanReingold::SerialStep(FLayoutPositions& Positions)
+    {
+        // Repulsion force between vertex pairs
+        if (Theta > 0.0)
+        {
+            ApplyBarnesHutRepulsion(Positions);
+        }
+        else
+        {
+            // > 1000.0: not worth computing
+            ForceKernels::Repulsion(KernelPath, Positions, static_cast<float>(StrengthSqr), 1000.f, Movements);
+        }
+
+        // Attraction force between edges
+        ForceKernels::Attraction(KernelPath, Positions, EdgesA, EdgesB, static_cast<float>(1.0 / Strength), Movements);
+
+        // Max movement capped by current temperature
+        ForceKernels::ApplyMovements(KernelPath, Positions, Movements, static_cast<float>(Temperature));
+    }
+
+    void FruchtermanReingold::ParallelStep(FLayoutPositions& Positions)
+    {
+        const int32 Num = Graph.Num();
+        const int32 NumVertexChunks = FMath::DivideAndRoundUp(Num, VerticesPerChunk);
+
+        // Repulsion force between vertex pairs. Every vertex only writes its own movement.
+        if (Theta > 0.0)
+        {
+            BuildQuadTree(Positions);
+
+            ParallelForWithTaskContext(TEXT("FruchtermanReingold.Repulsion"), WorkerStacks, Num, VerticesPerChunk,
+                [this, &Positions](TArray<int32>& WorkerStack, const int32 Node)
+                {
+                    const FVector2D Force = ComputeBarnesHutForce(Node, Positions, WorkerStack);
+                    Movements.X[Node] += Force.X;
+                    Movements.Y[Node] += Force.Y;
+                });
+        }
+        else
+        {
+            ParallelFor(TEXT("FruchtermanReingold.Repulsion"), NumVertexChunks, 1,
+                [this, &Positions, Num](const int32 Chunk)
+                {
+                    const int32 Begin = Chunk * VerticesPerChunk;
+                    ForceKernels::RepulsionRows(KernelPath, Positions, static_cast<float>(StrengthSqr), 1000.f,
+                        Begin, FMath::Min(Begin + VerticesPerChunk, Num), Movements);
+                });
+        }
+
+        // Attraction force between edges. Edges scatter to both ends, so each chunk accumulates into its own buffer.
+        const int32 NumEdgeChunks = FMath::DivideAndRoundUp(EdgesA.Num(), EdgesPerChunk);
+        EdgeChunkMovements.SetNum(NumEdgeChunks);
+
+        ParallelFor(TEXT("FruchtermanReingold.Attraction"), NumEdgeChunks, 1,
+            [this, &Positions, Num](const int32 Chunk)
             {
-                if (Node == Adj)
+                const int32 Begin = Chunk * EdgesPerChunk;
+                const int32 Count = FMath::Min(EdgesPerChunk, EdgesA.Num() - Begin);
+
+                FLayoutPositions& ChunkMovements = EdgeChunkMovements[Chunk];
+                ChunkMovements.Zero(Num);
+                ForceKernels::Attraction(KernelPath, Positions,
+                    MakeArrayView(EdgesA).Slice(Begin, Count), MakeArrayView(EdgesB).Slice(Begin, Count),
+                    static_cast<float>(1.0 / Strength), ChunkMovements);
+            });
+
+        // Sum the edge buffers in chunk order, then apply the max movement capped by current temperature.
+        ParallelFor(TEXT("FruchtermanReingold.Apply"), NumVertexChunks, 1,
+            [this, &Positions, Num](const int32 Chunk)
+            {
+                const int32 Begin = Chunk * VerticesPerChunk;
+                const int32 End = FMath::Min(Begin + VerticesPerChunk, Num);
+
+                for (const FLayoutPositions& ChunkMovements : EdgeChunkMovements)
                 {
-                    continue;
+                    for (int32 Node = Begin; Node < End; Node++)
+                    {
+                        Movements.X[Node] += ChunkMovements.X[Node];
+                        Movements.Y[Node] += ChunkMovements.Y[Node];
+                    }
                 }
 
-                FVector2D Delta = Positions[Node] - Positions[Adj];
-                const double Distance = Delta.Size();
-                // TODO: handle distance == 0.0
+                ForceKernels::ApplyMovements(KernelPath, Positions, Movements, static_cast<float>(Temperature), Begin, End);
+            });
+    }
+
+    void FruchtermanReingold::ApplyBarnesHutRepulsion(const FLayoutPositions& Positions)
+    {
+        BuildQuadTree(Positions);
+
+        for (int32 Node = 0; Node < Graph.Num(); Node++)
+        {
+            const FVector2D Force = ComputeBarnesHutForce(Node, Positions, Stack);
+            Movements.X[Node] += Force.X;
+            Movements.Y[Node] += Force.Y;
+        }
+    }
+
+    FVector2D FruchtermanReingold::ComputeBarnesHutForce(const int32 Node, const FLayoutPositions& Positions,
+                                                         TArray<int32>& NodeStack) const
+    {
+        const double ThetaSqr = Theta * Theta;
+        const FVector2D Position = Positions[Node];
+        FVector2D Force = FVector2D::ZeroVector;
+
+        NodeStack.Reset();
+        NodeStack.Add(0);
+
+        while (!NodeStack.IsEmpty())
+        {
+            const FQuadCell& Cell = Cells[NodeStack.Pop(EAllowShrinking::No)];
+            if (Cell.Mass == 0 || Cell.Body == Node)
+            {
+                continue;
+            }
 
-                // > 1000.0: not worth computing
-                if (Distance > 1000.0)
+            const FVector2D Delta = Position - Cell.MassCenter;
+            const double DistanceSqr = Delta.SizeSquared();
+
+            // A cell far enough away, relative to its size, acts as a single body at its center of mass.
+            const double Size = Cell.HalfSize * 2.0;
+            if (Cell.FirstChild == INDEX_NONE || Size * Size < ThetaSqr * DistanceSqr)
+            {
+                if (FMath::IsNearlyZero(DistanceSqr))
                 {
                     continue;
                 }
 
-                const double Repulsion = StrengthSqr / Distance;
+                // StrengthSqr / Distance per body, along Delta / Distance
+                Force += Delta * (StrengthSqr * Cell.Mass / DistanceSqr);
+                continue;
+            }
 
-                const FVector2D Movement = Delta / Distance * Repulsion;
-                Movements[Node] += Movement;
-                Movements[Adj] -= Movement;
+            for (int32 Child = 0; Child < 4; ++Child)
+            {
+                NodeStack.Add(Cell.FirstChild + Child);
             }
+        }
 
-            // Attraction force between edges
-            for (const int32 Adj : Graph[Node])
+        return Force;
+    }
+
+    void FruchtermanReingold::BuildQuadTree(const FLayoutPositions& Positions)
+    {
+        Cells.Reset();
+
+        FBox2D Bounds(ForceInit);
+        for (int32 Body = 0; Body < Positions.Num(); ++Body)
+        {
+            Bounds += Positions[Body];
+        }
+
+        FQuadCell& Root = Cells.AddDefaulted_GetRef();
+        Root.Center = Bounds.GetCenter();
+        Root.HalfSize = FMath::Max(Bounds.GetExtent().GetMax(), 1.0);
+
+        auto ChildFor = [this](const int32 Cell, const FVector2D& Position)
             {
-                if (Adj > Node)
+                const FQuadCell& Parent = Cells[Cell];
+                return Parent.FirstChild
+                    + (Position.X >= Parent.Center.X ? 1 : 0)
+                    + (Position.Y >= Parent.Center.Y ? 2 : 0);
+            };
+
+        for (int32 Body = 0; Body < Positions.Num(); ++Body)
+        {
+            const FVector2D Position = Positions[Body];
+
+            int32 Cell = 0;
+            for (int32 Depth = 0; ; ++Depth)
+            {
+                Cells[Cell].Mass++;
+                Cells[Cell].MassCenter += Position;
+
+                if (Cells[Cell].FirstChild != INDEX_NONE)
                 {
+                    Cell = ChildFor(Cell, Position);
                     continue;
                 }
 
-                FVector2D Delta = Positions[Node] - Positions[Adj];
-                const double Distance = Delta.Size();
-                if (FMath::IsNearlyZero(Distance))
+                if (Cells[Cell].Mass == 1)
                 {
-                    continue;
+                    Cells[Cell].Body = Body;
+                    break;
                 }
 
-                const double Attraction = Distance * Distance / Strength;
+                if (Depth >= MaxQuadTreeDepth)
+                {
+                    // Too close to tell apart; the leaf holds all of them as one mass.
+                    Cells[Cell].Body = INDEX_NONE;
+                    break;
+                }
+
+                // Split the leaf, moving its body down into the matching child.
+                const int32 Existing = Cells[Cell].Body;
+                const FVector2D ParentCenter = Cells[Cell].Center;
+                const double ChildHalfSize = Cells[Cell].HalfSize * 0.5;
+
+                Cells[Cell].Body = INDEX_NONE;
+                Cells[Cell].FirstChild = Cells.Num();
+
+                for (int32 Child = 0; Child < 4; ++Child)
+                {
+                    FQuadCell& NewCell = Cells.AddDefaulted_GetRef();
+                    NewCell.HalfSize = ChildHalfSize;
+                    NewCell.Center = ParentCenter + FVector2D(
+                        Child & 1 ? ChildHalfSize : -ChildHalfSize,
+                        Child & 2 ? ChildHalfSize : -ChildHalfSize);
+                }
+
+                if (Existing != INDEX_NONE)
+                {
+                    FQuadCell& ExistingCell = Cells[ChildFor(Cell, Positions[Existing])];
+                    ExistingCell.Mass = 1;
+                    ExistingCell.MassCenter = Positions[Existing];
+                    ExistingCell.Body = Existing;
+                }
 
-                const FVector2D Movement = Delta / Distance * Attraction;
-                Movements[Node] -= Movement;
-                Movements[Adj] += Movement;
+                Cell = ChildFor(Cell, Position);
             }
         }
 
-        // Max movement capped by current temperature
-        for (int32 Node = 0; Node < Graph.Num(); Node++)
+        for (FQuadCell& Cell : Cells)
         {
-            const double MovementSize = Movements[Node].Size();
-            // < 1.0: not worth computing
-            if (MovementSize < 1.0)
+            if (Cell.Mass > 0)
             {
-                continue;
+                Cell.MassCenter /= Cell.Mass;
             }
-            const double CappedMovementSize = FMath::Min(MovementSize, Temperature);
-            const FVector2D CappedMovement = Movements[Node] / MovementSize * CappedMovementSize;
-
-            Positions[Node] += CappedMovement;
-        }
-
-        // Cool down fast until we reach 1.5, then stay at low temperature
-        if (Temperature > 1.5)
-        {
-            Temperature *= 0.85;
-        }
-        else
-        {
-            Temperature = 1.5;
         }
     }
 }
@@ -0,0 +1,665 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Algorithms/GraphAlgorithms.h"
+#include "Algo/Reverse.h"
+#include "Algo/Unique.h"
+
+namespace Heart::Algorithms
+{
+    namespace
+    {
+        // Walk parent links back from Target, and write the path in forward order.
+        void BuildPath(const TConstArrayView<int32> Parents, int32 Target, TArray<int32>& OutPath)
+        {
+            OutPath.Reset();
+            for (int32 Vertex = Target; Vertex != INDEX_NONE; Vertex = Parents[Vertex])
+            {
+                OutPath.Add(Vertex);
+            }
+            Algo::Reverse(OutPath);
+        }
+
+        // Find a cycle among the vertices Kahn's algorithm could not order (those with remaining in-degree).
+        void FindCycle(const FCsrGraph& Graph, const TConstArrayView<int32> InDegree, TArray<int32>& OutCycle,
+                       FGraphScratch& S)
+        {
+            enum : int32 { Unseen, OnStack, Done };
+
+            const int32 N = Graph.NumVertices();
+            TArray<int32>& State = S.LowLink;
+            State.Init(Unseen, N);
+            S.Stack.Reset();
+            S.Cursor.Reset();
+            OutCycle.Reset();
+
+            for (int32 Start = 0; Start < N; ++Start)
+            {
+                if (InDegree[Start] == 0 || State[Start] != Unseen)
+                {
+                    continue;
+                }
+
+                State[Start] = OnStack;
+                S.Stack.Add(Start);
+                S.Cursor.Add(Graph.Offsets[Start]);
+
+                while (!S.Stack.IsEmpty())
+                {
+                    const int32 Vertex = S.Stack.Last();
+                    if (S.Cursor.Last() == Graph.Offsets[Vertex + 1])
+                    {
+                        State[Vertex] = Done;
+                        S.Stack.Pop(EAllowShrinking::No);
+                        S.Cursor.Pop(EAllowShrinking::No);
+                        continue;
+                    }
+
+                    const int32 Next = Graph.Targets[S.Cursor.Last()++];
+
+                    // Ordered vertices cannot be part of a cycle.
+                    if (InDegree[Next] == 0)
+                    {
+                        continue;
+                    }
+
+                    if (State[Next] == OnStack)
+                    {
+                        // Back edge: the stack from Next up to here is a cycle.
+                        const int32 First = S.Stack.Find(Next);
+                        OutCycle.Append(S.Stack.GetData() + First, S.Stack.Num() - First);
+                        return;
+                    }
+
+                    if (State[Next] == Unseen)
+                    {
+                        State[Next] = OnStack;
+                        S.Stack.Add(Next);
+                        S.Cursor.Add(Graph.Offsets[Next]);
+                    }
+                }
+            }
+        }
+    }
+
+    FCsrGraph FCsrGraph::FromEdges(const int32 NumVertices, const TConstArrayView<TPair<int32, int32>> Edges,
+                                   const TConstArrayView<double> EdgeWeights)
+    {
+        check(EdgeWeights.IsEmpty() || EdgeWeights.Num() == Edges.Num());
+
+        FCsrGraph Out;
+        Out.Offsets.SetNumZeroed(NumVertices + 1);
+
+        // Count the edges of each vertex, then prefix-sum the counts into offsets.
+        for (const TPair<int32, int32>& Edge : Edges)
+        {
+            check(Edge.Key >= 0 && Edge.Key < NumVertices && Edge.Value >= 0 && Edge.Value < NumVertices);
+            Out.Offsets[Edge.Key + 1]++;
+        }
+        for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+        {
+            Out.Offsets[Vertex + 1] += Out.Offsets[Vertex];
+        }
+
+        Out.Targets.SetNumUninitialized(Edges.Num());
+        if (!EdgeWeights.IsEmpty())
+        {
+            Out.Weights.SetNumUninitialized(Edges.Num());
+        }
+
+        TArray<int32> Fill(Out.Offsets.GetData(), NumVertices);
+        for (int32 i = 0; i < Edges.Num(); ++i)
+        {
+            const int32 Slot = Fill[Edges[i].Key]++;
+            Out.Targets[Slot] = Edges[i].Value;
+            if (!EdgeWeights.IsEmpty())
+            {
+                Out.Weights[Slot] = EdgeWeights[i];
+            }
+        }
+
+        return Out;
+    }
+
+    FCsrGraph FCsrGraph::FromAdjacencyList(const TArray<TArray<int32>>& Adjacency)
+    {
+        FCsrGraph Out;
+        Out.Offsets.Reserve(Adjacency.Num() + 1);
+        Out.Offsets.Add(0);
+
+        for (const TArray<int32>& Neighbors : Adjacency)
+        {
+            Out.Targets.Append(Neighbors);
+            Out.Offsets.Add(Out.Targets.Num());
+        }
+
+        return Out;
+    }
+
+    FCsrGraph FCsrGraph::Transposed() const
+    {
+        const int32 N = NumVertices();
+
+        FCsrGraph Out;
+        Out.Offsets.SetNumZeroed(N + 1);
+        for (const int32 Target : Targets)
+        {
+            Out.Offsets[Target + 1]++;
+        }
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            Out.Offsets[Vertex + 1] += Out.Offsets[Vertex];
+        }
+
+        Out.Targets.SetNumUninitialized(Targets.Num());
+        if (!Weights.IsEmpty())
+        {
+            Out.Weights.SetNumUninitialized(Weights.Num());
+        }
+
+        TArray<int32> Fill(Out.Offsets.GetData(), N);
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            for (int32 Edge = Offsets[Vertex]; Edge < Offsets[Vertex + 1]; ++Edge)
+            {
+                const int32 Slot = Fill[Targets[Edge]]++;
+                Out.Targets[Slot] = Vertex;
+                if (!Weights.IsEmpty())
+                {
+                    Out.Weights[Slot] = Weights[Edge];
+                }
+            }
+        }
+
+        return Out;
+    }
+
+    FCsrGraph FCsrGraph::Undirected() const
+    {
+        const int32 N = NumVertices();
+
+        TArray<TArray<int32>> Adjacency;
+        Adjacency.SetNum(N);
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            for (const int32 Target : GetNeighbors(Vertex))
+            {
+                if (Target != Vertex)
+                {
+                    Adjacency[Vertex].Add(Target);
+                    Adjacency[Target].Add(Vertex);
+                }
+            }
+        }
+
+        for (TArray<int32>& Neighbors : Adjacency)
+        {
+            Neighbors.Sort();
+            Neighbors.SetNum(Algo::Unique(Neighbors));
+        }
+
+        return FromAdjacencyList(Adjacency);
+    }
+
+    void BreadthFirst(const FCsrGraph& Graph, const TConstArrayView<int32> Sources, TArray<int32>& OutOrder,
+                      TArray<int32>* OutDepth, FGraphScratch* Scratch)
+    {
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+        S.Visited.Init(false, N);
+        OutOrder.Reset();
+        if (OutDepth)
+        {
+            OutDepth->Init(INDEX_NONE, N);
+        }
+
+        for (const int32 Source : Sources)
+        {
+            if (Graph.IsValidVertex(Source) && !S.Visited[Source])
+            {
+                S.Visited[Source] = true;
+                OutOrder.Add(Source);
+                if (OutDepth)
+                {
+                    (*OutDepth)[Source] = 0;
+                }
+            }
+        }
+
+        // OutOrder doubles as the queue.
+        for (int32 Head = 0; Head < OutOrder.Num(); ++Head)
+        {
+            const int32 Vertex = OutOrder[Head];
+            for (const int32 Next : Graph.GetNeighbors(Vertex))
+            {
+                if (!S.Visited[Next])
+                {
+                    S.Visited[Next] = true;
+                    OutOrder.Add(Next);
+                    if (OutDepth)
+                    {
+                        (*OutDepth)[Next] = (*OutDepth)[Vertex] + 1;
+                    }
+                }
+            }
+        }
+    }
+
+    void DepthFirst(const FCsrGraph& Graph, const TConstArrayView<int32> Sources, TArray<int32>& OutOrder,
+                    FGraphScratch* Scratch)
+    {
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        S.Visited.Init(false, Graph.NumVertices());
+        S.Stack.Reset();
+        S.Cursor.Reset();
+        OutOrder.Reset();
+
+        auto Enter = [&](const int32 Vertex)
+            {
+                S.Visited[Vertex] = true;
+                OutOrder.Add(Vertex);
+                S.Stack.Add(Vertex);
+                S.Cursor.Add(Graph.Offsets[Vertex]);
+            };
+
+        for (const int32 Source : Sources)
+        {
+            if (!Graph.IsValidVertex(Source) || S.Visited[Source])
+            {
+                continue;
+            }
+
+            Enter(Source);
+
+            // Each stack entry remembers which of its edges to take next, as the recursive version's loop would.
+            while (!S.Stack.IsEmpty())
+            {
+                const int32 Vertex = S.Stack.Last();
+                if (S.Cursor.Last() == Graph.Offsets[Vertex + 1])
+                {
+                    S.Stack.Pop(EAllowShrinking::No);
+                    S.Cursor.Pop(EAllowShrinking::No);
+                    continue;
+                }
+
+                if (const int32 Next = Graph.Targets[S.Cursor.Last()++];
+                    !S.Visited[Next])
+                {
+                    Enter(Next);
+                }
+            }
+        }
+    }
+
+    bool TopologicalSort(const FCsrGraph& Graph, TArray<int32>& OutOrder, TArray<int32>* OutCycle,
+                         FGraphScratch* Scratch)
+    {
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+
+        // Kahn's algorithm
+        TArray<int32>& InDegree = S.Marks;
+        InDegree.Init(0, N);
+        for (const int32 Target : Graph.Targets)
+        {
+            InDegree[Target]++;
+        }
+
+        OutOrder.Reset(N);
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            if (InDegree[Vertex] == 0)
+            {
+                OutOrder.Add(Vertex);
+            }
+        }
+
+        // OutOrder doubles as the queue.
+        for (int32 Head = 0; Head < OutOrder.Num(); ++Head)
+        {
+            for (const int32 Next : Graph.GetNeighbors(OutOrder[Head]))
+            {
+                if (--InDegree[Next] == 0)
+                {
+                    OutOrder.Add(Next);
+                }
+            }
+        }
+
+        if (OutOrder.Num() == N)
+        {
+            if (OutCycle)
+            {
+                OutCycle->Reset();
+            }
+            return true;
+        }
+
+        if (OutCycle)
+        {
+            FindCycle(Graph, InDegree, *OutCycle, S);
+        }
+        return false;
+    }
+
+    int32 StronglyConnectedComponents(const FCsrGraph& Graph, TArray<int32>& OutComponent, FGraphScratch* Scratch)
+    {
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+
+        TArray<int32>& Index = S.Marks;
+        TArray<int32>& LowLink = S.LowLink;
+        TArray<int32>& Members = S.Queue; // Tarjan's stack of vertices without a component yet
+        TBitArray<>& OnStack = S.Visited;
+
+        Index.Init(INDEX_NONE, N);
+        LowLink.SetNumUninitialized(N);
+        OnStack.Init(false, N);
+        Members.Reset();
+        S.Stack.Reset();
+        S.Cursor.Reset();
+        OutComponent.Init(INDEX_NONE, N);
+
+        int32 NextIndex = 0;
+        int32 NumComponents = 0;
+
+        auto Enter = [&](const int32 Vertex)
+            {
+                Index[Vertex] = LowLink[Vertex] = NextIndex++;
+                Members.Add(Vertex);
+                OnStack[Vertex] = true;
+                S.Stack.Add(Vertex);
+                S.Cursor.Add(Graph.Offsets[Vertex]);
+            };
+
+        for (int32 Root = 0; Root < N; ++Root)
+        {
+            if (Index[Root] != INDEX_NONE)
+            {
+                continue;
+            }
+
+            Enter(Root);
+
+            while (!S.Stack.IsEmpty())
+            {
+                const int32 Vertex = S.Stack.Last();
+
+                if (S.Cursor.Last() < Graph.Offsets[Vertex + 1])
+                {
+                    const int32 Next = Graph.Targets[S.Cursor.Last()++];
+                    if (Index[Next] == INDEX_NONE)
+                    {
+                        Enter(Next);
+                    }
+                    else if (OnStack[Next])
+                    {
+                        LowLink[Vertex] = FMath::Min(LowLink[Vertex], Index[Next]);
+                    }
+                    continue;
+                }
+
+                // All edges taken; return to the caller.
+                S.Stack.Pop(EAllowShrinking::No);
+                S.Cursor.Pop(EAllowShrinking::No);
+
+                if (!S.Stack.IsEmpty())
+                {
+                    const int32 Caller = S.Stack.Last();
+                    LowLink[Caller] = FMath::Min(LowLink[Caller], LowLink[Vertex]);
+                }
+
+                if (LowLink[Vertex] == Index[Vertex])
+                {
+                    int32 Member;
+                    do
+                    {
+                        Member = Members.Pop(EAllowShrinking::No);
+                        OnStack[Member] = false;
+                        OutComponent[Member] = NumComponents;
+                    }
+                    while (Member != Vertex);
+
+                    NumComponents++;
+                }
+            }
+        }
+
+        return NumComponents;
+    }
+
+    int32 ConnectedComponents(const FCsrGraph& Graph, TArray<int32>& OutComponent, FGraphScratch* Scratch)
+    {
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+
+        // Union-find, where each set is rooted at its lowest vertex.
+        TArray<int32>& Parent = S.Marks;
+        Parent.SetNumUninitialized(N);
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            Parent[Vertex] = Vertex;
+        }
+
+        auto FindRoot = [&Parent](int32 Vertex)
+            {
+                while (Parent[Vertex] != Vertex)
+                {
+                    // Path halving
+                    Parent[Vertex] = Parent[Parent[Vertex]];
+                    Vertex = Parent[Vertex];
+                }
+                return Vertex;
+            };
+
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            for (const int32 Next : Graph.GetNeighbors(Vertex))
+            {
+                const int32 A = FindRoot(Vertex);
+                const int32 B = FindRoot(Next);
+                if (A != B)
+                {
+                    Parent[FMath::Max(A, B)] = FMath::Min(A, B);
+                }
+            }
+        }
+
+        // A root is never higher than its members, so it's always numbered before them.
+        int32 NumComponents = 0;
+        OutComponent.SetNumUninitialized(N);
+        for (int32 Vertex = 0; Vertex < N; ++Vertex)
+        {
+            const int32 Root = FindRoot(Vertex);
+            OutComponent[Vertex] = Root == Vertex ? NumComponents++ : OutComponent[Root];
+        }
+
+        return NumComponents;
+    }
+
+    bool ShortestPath(const FCsrGraph& Graph, const int32 Source, const int32 Target, TArray<int32>& OutPath,
+                      FGraphScratch* Scratch)
+    {
+        OutPath.Reset();
+        if (!Graph.IsValidVertex(Source) || !Graph.IsValidVertex(Target))
+        {
+            return false;
+        }
+
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+        TArray<int32>& Parents = S.Marks;
+        Parents.Init(INDEX_NONE, N);
+        S.Visited.Init(false, N);
+        S.Queue.Reset();
+
+        S.Visited[Source] = true;
+        S.Queue.Add(Source);
+
+        for (int32 Head = 0; Head < S.Queue.Num() && !S.Visited[Target]; ++Head)
+        {
+            const int32 Vertex = S.Queue[Head];
+            for (const int32 Next : Graph.GetNeighbors(Vertex))
+            {
+                if (!S.Visited[Next])
+                {
+                    S.Visited[Next] = true;
+                    Parents[Next] = Vertex;
+                    S.Queue.Add(Next);
+                }
+            }
+        }
+
+        if (!S.Visited[Target])
+        {
+            return false;
+        }
+
+        BuildPath(Parents, Target, OutPath);
+        return true;
+    }
+
+    bool ShortestPathWeighted(const FCsrGraph& Graph, const int32 Source, const int32 Target, TArray<int32>& OutPath,
+                              double* OutCost, FGraphScratch* Scratch)
+    {
+        OutPath.Reset();
+        if (!Graph.IsValidVertex(Source) || !Graph.IsValidVertex(Target))
+        {
+            return false;
+        }
+
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        const int32 N = Graph.NumVertices();
+        TArray<int32>& Parents = S.Marks;
+        TArray<double>& Costs = S.Costs;
+        Parents.Init(INDEX_NONE, N);
+        Costs.Init(TNumericLimits<double>::Max(), N);
+        S.Visited.Init(false, N); // Settled vertices
+        S.Heap.Reset();
+
+        // Min-heap of (cost, vertex). Stale entries are skipped when popped, instead of being updated in place.
+        auto HeapPredicate = [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; };
+
+        Costs[Source] = 0.0;
+        S.Heap.HeapPush({0.0, Source}, HeapPredicate);
+
+        while (!S.Heap.IsEmpty())
+        {
+            TPair<double, int32> Top;
+            S.Heap.HeapPop(Top, HeapPredicate, EAllowShrinking::No);
+
+            const int32 Vertex = Top.Value;
+            if (S.Visited[Vertex])
+            {
+                continue;
+            }
+            S.Visited[Vertex] = true;
+
+            if (Vertex == Target)
+            {
+                break;
+            }
+
+            for (int32 Edge = Graph.Offsets[Vertex]; Edge < Graph.Offsets[Vertex + 1]; ++Edge)
+            {
+                const double Weight = Graph.GetWeight(Edge);
+                if (!ensureMsgf(Weight >= 0.0, TEXT("ShortestPathWeighted does not support negative edge weights")))
+                {
+                    continue;
+                }
+
+                const int32 Next = Graph.Targets[Edge];
+                if (const double Cost = Top.Key + Weight;
+                    Cost < Costs[Next])
+                {
+                    Costs[Next] = Cost;
+                    Parents[Next] = Vertex;
+                    S.Heap.HeapPush({Cost, Next}, HeapPredicate);
+                }
+            }
+        }
+
+        if (!S.Visited[Target])
+        {
+            return false;
+        }
+
+        if (OutCost)
+        {
+            *OutCost = Costs[Target];
+        }
+
+        BuildPath(Parents, Target, OutPath);
+        return true;
+    }
+
+    bool LongestPath(const FCsrGraph& Graph, TArray<int32>& OutPath, double* OutLength, FGraphScratch* Scratch)
+    {
+        OutPath.Reset();
+
+        const int32 N = Graph.NumVertices();
+        if (N == 0)
+        {
+            return false;
+        }
+
+        FGraphScratch LocalScratch;
+        FGraphScratch& S = Scratch ? *Scratch : LocalScratch;
+
+        TArray<int32>& Order = S.Queue;
+        if (!TopologicalSort(Graph, Order, nullptr, &S))
+        {
+            return false;
+        }
+
+        // Relax edges in topological order; each vertex's best path is final by the time it's reached.
+        TArray<double>& Lengths = S.Costs;
+        TArray<int32>& Parents = S.LowLink;
+        Lengths.Init(0.0, N);
+        Parents.Init(INDEX_NONE, N);
+
+        for (const int32 Vertex : Order)
+        {
+            for (int32 Edge = Graph.Offsets[Vertex]; Edge < Graph.Offsets[Vertex + 1]; ++Edge)
+            {
+                const int32 Next = Graph.Targets[Edge];
+                if (const double Length = Lengths[Vertex] + Graph.GetWeight(Edge);
+                    Length > Lengths[Next] || (Parents[Next] == INDEX_NONE && Length == Lengths[Next]))
+                {
+                    Lengths[Next] = Length;
+                    Parents[Next] = Vertex;
+                }
+            }
+        }
+
+        int32 End = 0;
+        for (int32 Vertex = 1; Vertex < N; ++Vertex)
+        {
+            if (Lengths[Vertex] > Lengths[End])
+            {
+                End = Vertex;
+            }
+        }
+
+        if (OutLength)
+        {
+            *OutLength = Lengths[End];
+        }
+
+        BuildPath(Parents, End, OutPath);
+        return true;
+    }
+}
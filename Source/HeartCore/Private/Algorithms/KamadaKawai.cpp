@@ -1,28 +1,65 @@
 // Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Algorithms/KamadaKawai.h"
+#include "Algorithms/GraphAlgorithms.h"
+#include "Async/ParallelFor.h"
 #include "Containers/ArrayView.h"
 #include "Math/Vector2D.h"
 
 namespace Nodesoup
 {
-    KamadaKawai::KamadaKawai(FGraphView InGraph, const double Strength, const double InEnergyThreshold)
+    KamadaKawai::KamadaKawai(FGraphView InGraph, const double Strength, const double InEnergyThreshold,
+                             const EForceKernelPath InKernelPath)
         : Graph(InGraph)
         , EnergyThreshold(InEnergyThreshold)
+        , KernelPath(InKernelPath)
     {
-        const FTwoDimIntArray Distances = FloydWarshall(Graph);
+        const int32 Num = Graph.Num();
+        SpringLengths.SetNumZeroed(Num * Num);
+        SpringStrengths.SetNumZeroed(Num * Num);
 
-        // find the biggest distance
-        size_t BiggestDistance = 0;
-        for (int32 i = 0; i < Graph.Num(); i++)
+        // Find the length of the shortest path for each pair of vertices, with a breadth-first search from each one.
+        // Until the biggest distance is known, the spring lengths hold the distances, or -1 for unreachable pairs.
+        const Heart::Algorithms::FCsrGraph Undirected = Heart::Algorithms::FCsrGraph::FromAdjacencyList(Graph).Undirected();
+
+        struct FSearchContext
         {
-            for (int32 j = 0; j < Graph.Num(); j++)
+            Heart::Algorithms::FGraphScratch Scratch;
+            TArray<int32> Order;
+            TArray<int32> Depth;
+            int32 BiggestDistance = 0;
+            bool HasUnreachable = false;
+        };
+        TArray<FSearchContext> Contexts;
+
+        ParallelForWithTaskContext(TEXT("KamadaKawai.Distances"), Contexts, Num, 16,
+            [this, &Undirected, Num](FSearchContext& Context, const int32 Vertex)
             {
-                if (Distances[i][j] > BiggestDistance)
+                Heart::Algorithms::BreadthFirst(Undirected, MakeArrayView(&Vertex, 1), Context.Order, &Context.Depth, &Context.Scratch);
+
+                float* Row = SpringLengths.GetData() + Vertex * Num;
+                for (int32 Other = 0; Other < Num; Other++)
                 {
-                    BiggestDistance = Distances[i][j];
+                    const int32 Distance = Context.Depth[Other];
+                    Row[Other] = static_cast<float>(Distance);
+                    Context.BiggestDistance = FMath::Max(Context.BiggestDistance, Distance);
+                    Context.HasUnreachable |= Distance == INDEX_NONE;
                 }
-            }
+            });
+
+        // find the biggest distance
+        int32 BiggestDistance = 1;
+        bool HasUnreachable = false;
+        for (const FSearchContext& Context : Contexts)
+        {
+            BiggestDistance = FMath::Max(BiggestDistance, Context.BiggestDistance);
+            HasUnreachable |= Context.HasUnreachable;
+        }
+
+        // Vertices in different components are kept one step further apart than any connected pair.
+        if (HasUnreachable)
+        {
+            BiggestDistance++;
         }
 
         // Ideal length for all edges. We don't really care, the layout is going to be scaled.
@@ -31,59 +68,22 @@ namespace Nodesoup
         const double Length = 1.0 / BiggestDistance;
 
         // init springs lengths and strengths matrices
-        for (int32 i = 0; i < Graph.Num(); i++)
-        {
-            TArray<FSpring> VertexSprings;
-
-            for (int32 j = 0; j < Graph.Num(); j++)
-            {
-                FSpring& Spring = VertexSprings.AddDefaulted_GetRef();
-                if (i != j)
-                {
-                    const size_t Distance = Distances[i][j];
-                    Spring.Length = Distance * Length;
-                    Spring.Strength = Strength / (Distance * Distance);
-                }
-            }
-            Springs.Add(VertexSprings);
-        }
-    }
-
-    FTwoDimIntArray KamadaKawai::FloydWarshall(FGraphView Graph)
-    {
-        // build adjacency matrix (infinity = no edge, 1 = edge)
-        constexpr uint32 Infinity = TNumericLimits<uint32>::Max() / 2;
-        TArray<int32> InnerArray;
-        FTwoDimIntArray Distances;
-        InnerArray.Init(Infinity, Graph.Num());
-        Distances.Init(InnerArray, Graph.Num());
-
-        for (int32 Vertex = 0; Vertex < Graph.Num(); Vertex++)
-        {
-            Distances[Vertex][Vertex] = 0;
-            for (const int32 Adjacent : Graph[Vertex])
-            {
-                if (Adjacent > Vertex)
-                {
-                    Distances[Vertex][Adjacent] = 1;
-                    Distances[Adjacent][Vertex] = 1;
-                }
-            }
-        }
-
-        // floyd warshall itself, find length of the shortest path for each pair of vertices
-        for (int32 k = 0; k < Graph.Num(); k++)
-        {
-            for (int32 i = 0; i < Graph.Num(); i++)
+        ParallelFor(TEXT("KamadaKawai.Springs"), Num, 16,
+            [this, Num, Length, Strength, BiggestDistance](const int32 i)
             {
-                for (int32 j = 0; j < Graph.Num(); j++)
+                for (int32 j = 0; j < Num; j++)
                 {
-                    Distances[i][j] = FMath::Min(Distances[i][j], Distances[i][k] + Distances[k][j]);
+                    const int32 Index = i * Num + j;
+                    if (i == j)
+                    {
+                        continue;
+                    }
+
+                    const double Distance = SpringLengths[Index] < 0.f ? BiggestDistance : SpringLengths[Index];
+                    SpringLengths[Index] = Distance * Length;
+                    SpringStrengths[Index] = Strength / (Distance * Distance);
                 }
-            }
-        }
-
-        return Distances;
+            });
     }
 
     #define MAX_VERTEX_ITERS_COUNT 50
@@ -94,6 +94,14 @@ namespace Nodesoup
     an energy below energy_threshold
     */
     void KamadaKawai::operator()(TArray<FVector2D>& Positions) const
+    {
+        FLayoutPositions Converted;
+        Converted.Set(Positions);
+        (*this)(Converted);
+        Converted.Get(Positions);
+    }
+
+    void KamadaKawai::operator()(FLayoutPositions& Positions) const
     {
         int32 Vertex;
         uint32 SteadyEnergyCount = 0;
@@ -106,7 +114,7 @@ namespace Nodesoup
             uint32 VertexCount = 0;
             do
             {
-                Positions[Vertex] = ComputeNextVertexPosition(Vertex, Positions);
+                MoveVertex(Vertex, Positions);
                 VertexCount++;
             } while (ComputeVertexEnergy(Vertex, Positions) > EnergyThreshold && VertexCount < MAX_VERTEX_ITERS_COUNT);
 
@@ -123,11 +131,19 @@ namespace Nodesoup
         }
     }
 
+    ForceKernels::FSpringTerms KamadaKawai::ComputeSpringTerms(const int32 Vertex, const FLayoutPositions& Positions) const
+    {
+        const int32 Num = Graph.Num();
+        return ForceKernels::SpringTerms(KernelPath, Positions, Vertex,
+            MakeArrayView(SpringLengths.GetData() + Vertex * Num, Num),
+            MakeArrayView(SpringStrengths.GetData() + Vertex * Num, Num));
+    }
+
     /**
     Find @p max_energy_v_id with the most potential energy and @return its energy
     // https://gist.github.com/terakun/b7eff90c889c1485898ec9256ca9f91d
     */
-    double KamadaKawai::FindMaxVertexEnergy(const TConstArrayView<FVector2D> Positions, int32& MaxEnergyVertex) const
+    double KamadaKawai::FindMaxVertexEnergy(const FLayoutPositions& Positions, int32& MaxEnergyVertex) const
     {
         double MaxEnergy = -1.0;
         for (int32 i = 0; i < Graph.Num(); i++)
@@ -144,64 +160,23 @@ namespace Nodesoup
     }
 
     /** @return the potential energies of springs between @p v_id and all other vertices */
-    double KamadaKawai::ComputeVertexEnergy(const int32 Vertex, const TConstArrayView<FVector2D> Positions) const
+    double KamadaKawai::ComputeVertexEnergy(const int32 Vertex, const FLayoutPositions& Positions) const
     {
-        FVector2D Energy = FVector2D::ZeroVector;
-
-        for (int32 i = 0; i < Graph.Num(); i++)
-        {
-            if (Vertex == i)
-            {
-                continue;
-            }
-
-            const FVector2D Delta = Positions[Vertex] - Positions[i];
-            const double Distance = Delta.Size();
-
-            const FSpring& Spring = Springs[Vertex][i];
-            Energy += Delta * (Spring.Strength * (1.0 - Spring.Length / Distance));
-        }
-
-        return Energy.Size();
+        return ComputeSpringTerms(Vertex, Positions).Energy();
     }
 
     /**
-    @returns next position for @param Vertex reducing its potential energy, ie the energy in the whole graph
+    Moves @param Vertex to reduce its potential energy, ie the energy in the whole graph
     caused by its position.
     The position's delta depends on K (TODO bigger K = faster?).
     This is the complicated part of the algorithm.
     */
-    FVector2D KamadaKawai::ComputeNextVertexPosition(const int32 Vertex, const TConstArrayView<FVector2D> Positions) const
+    void KamadaKawai::MoveVertex(const int32 Vertex, FLayoutPositions& Positions) const
     {
-        FVector2D Energy = FVector2D::ZeroVector;
-        FVector2D XEnergy = FVector2D::ZeroVector;
-        FVector2D YEnergy = FVector2D::ZeroVector;
-
-        for (int32 i = 0; i < Graph.Num(); i++)
-        {
-            if (Vertex == i)
-            {
-                continue;
-            }
-
-            const FVector2D Delta = Positions[Vertex] - Positions[i];
-            const double Distance = Delta.Size();
-            const double CubedDistance = FMath::Cube(Distance);
-
-            const FSpring& Spring = Springs[Vertex][i];
-
-            Energy += Delta * (Spring.Strength * (1.0 - Spring.Length / Distance));
-            XEnergy.Y += Spring.Strength * Spring.Length * Delta.X * Delta.Y / CubedDistance;
-            XEnergy.X += Spring.Strength * (1.0 - Spring.Length * Delta.Y * Delta.Y / CubedDistance);
-            YEnergy.Y += Spring.Strength * (1.0 - Spring.Length * Delta.X * Delta.X / CubedDistance);
-        }
-        YEnergy.X = XEnergy.Y;
-
-        FVector2D Position = Positions[Vertex];
-        const double Denom = XEnergy.X * YEnergy.Y - XEnergy.Y * YEnergy.X;
-        Position.X += (XEnergy.Y * Energy.Y - YEnergy.Y * Energy.X) / Denom;
-        Position.Y += (XEnergy.Y * Energy.X - XEnergy.X * Energy.Y) / Denom;
+        const ForceKernels::FSpringTerms Terms = ComputeSpringTerms(Vertex, Positions);
 
-        return Position;
+        const float Denom = Terms.XX * Terms.YY - Terms.XY * Terms.XY;
+        Positions.X[Vertex] += (Terms.XY * Terms.EnergyY - Terms.YY * Terms.EnergyX) / Denom;
+        Positions.Y[Vertex] += (Terms.XY * Terms.EnergyX - Terms.XX * Terms.EnergyY) / Denom;
     }
 }
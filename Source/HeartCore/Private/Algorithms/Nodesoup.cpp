@@ -4,6 +4,7 @@
 #include "Algorithms/FruchtermanReingold.h"
 #include "Algorithms/KamadaKawai.h"
 #include "Algorithms/Layout.h"
+#include "Algorithms/SparseStress.h"
 #include "Containers/Array.h"
 #include "Math/Vector2D.h"
 
@@ -42,19 +43,80 @@ namespace Nodesoup
         const uint32 Width,
         const uint32 Height,
         const double Strength,
-        const double EnergyThreshold)
+        const double EnergyThreshold,
+        const EForceKernelPath KernelPath)
     {
         TArray<FVector2D> Positions;
         Positions.SetNumZeroed(Graph.Num());
         // Initial layout on a circle
         Circle(Positions);
-        const KamadaKawai kk(Graph, Strength, EnergyThreshold);
+        const KamadaKawai kk(Graph, Strength, EnergyThreshold, KernelPath);
         kk(Positions);
         CenterAndScale(Width, Height, Positions);
 
         return Positions;
     }
 
+    static TArray<FVector2D> SparseStressImpl(
+        FGraphView Graph,
+        const FGraphIterationPredicate* Callback,
+        const uint32 Width,
+        const uint32 Height,
+        const int32 NumPivots,
+        const uint32 Iterations,
+        const double Tolerance)
+    {
+        SparseStress ss(Graph, NumPivots);
+
+        TArray<FVector2D> Positions;
+        ss.InitialPositions(Positions);
+
+        TArray<FVector2D> ScaledPositions;
+        for (uint32 i = 0; i < Iterations; i++)
+        {
+            if (ss(Positions) < Tolerance)
+            {
+                break;
+            }
+
+            if (Callback)
+            {
+                ScaledPositions = Positions;
+                CenterAndScale(Width, Height, ScaledPositions);
+                if (!(*Callback)(ScaledPositions, i))
+                {
+                    return TArray<FVector2D>();
+                }
+            }
+        }
+
+        CenterAndScale(Width, Height, Positions);
+        return Positions;
+    }
+
+    TArray<FVector2D> sparse_stress(
+        FGraphView Graph,
+        const uint32 Width,
+        const uint32 Height,
+        const int32 NumPivots,
+        const uint32 Iterations,
+        const double Tolerance)
+    {
+        return SparseStressImpl(Graph, nullptr, Width, Height, NumPivots, Iterations, Tolerance);
+    }
+
+    TArray<FVector2D> sparse_stress(
+        FGraphView Graph,
+        const FGraphIterationPredicate& Callback,
+        const uint32 Width,
+        const uint32 Height,
+        const int32 NumPivots,
+        const uint32 Iterations,
+        const double Tolerance)
+    {
+        return SparseStressImpl(Graph, &Callback, Width, Height, NumPivots, Iterations, Tolerance);
+    }
+
     TArray<double> SizeRadii(FGraphView Graph, const double MinRadius, const double Strength)
     {
         TArray<double> Radii;
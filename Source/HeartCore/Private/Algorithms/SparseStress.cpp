@@ -0,0 +1,339 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "Algorithms/SparseStress.h"
+#include "Algorithms/GraphAlgorithms.h"
+#include "Algorithms/Layout.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Math/Vector2D.h"
+
+namespace Nodesoup
+{
+    // Power iteration steps used to find each principal axis in pivot MDS.
+    static constexpr int32 PowerIterations = 100;
+
+    SparseStress::SparseStress(FGraphView InGraph, const int32 NumPivots)
+        : NumVertices(InGraph.Num())
+    {
+        const Heart::Algorithms::FCsrGraph Undirected = Heart::Algorithms::FCsrGraph::FromAdjacencyList(InGraph).Undirected();
+        const int32 NumPicked = FMath::Clamp(NumPivots, 1, FMath::Max(NumVertices, 1));
+
+        if (NumVertices == 0)
+        {
+            TermOffsets.Add(0);
+            return;
+        }
+
+        for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+        {
+            for (const int32 Adjacent : Undirected.GetNeighbors(Vertex))
+            {
+                if (Adjacent > Vertex)
+                {
+                    Edges.Emplace(Vertex, Adjacent);
+                }
+            }
+        }
+
+        // Pick pivots max-min: each one is the vertex furthest from every pivot picked so far. Unreached vertices count
+        // as furthest, so every component gets a pivot before any gets a second.
+        TArray<int32> NearestPivotDistance;
+        NearestPivotDistance.Init(MAX_int32, NumVertices);
+
+        Heart::Algorithms::FGraphScratch Scratch;
+        TArray<int32> Order;
+        TArray<int32> Depth;
+        int32 BiggestDistance = 1;
+
+        PivotDistances.SetNumUninitialized(NumPicked * NumVertices);
+
+        int32 Next = 0;
+        for (int32 Pivot = 0; Pivot < NumPicked; Pivot++)
+        {
+            Pivots.Add(Next);
+            Heart::Algorithms::BreadthFirst(Undirected, MakeArrayView(&Next, 1), Order, &Depth, &Scratch);
+
+            float* Row = PivotDistances.GetData() + Pivot * NumVertices;
+            for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                Row[Vertex] = static_cast<float>(Depth[Vertex]);
+                if (Depth[Vertex] != INDEX_NONE)
+                {
+                    BiggestDistance = FMath::Max(BiggestDistance, Depth[Vertex]);
+                    NearestPivotDistance[Vertex] = FMath::Min(NearestPivotDistance[Vertex], Depth[Vertex]);
+                }
+            }
+
+            Next = 0;
+            for (int32 Vertex = 1; Vertex < NumVertices; Vertex++)
+            {
+                if (NearestPivotDistance[Vertex] > NearestPivotDistance[Next])
+                {
+                    Next = Vertex;
+                }
+            }
+        }
+
+        // Vertices in different components are kept one step further apart than any connected pair.
+        for (float& Distance : PivotDistances)
+        {
+            if (Distance < 0.f)
+            {
+                Distance = static_cast<float>(BiggestDistance + 1);
+            }
+        }
+
+        // Every vertex belongs to the region of its nearest pivot. A pivot's term for a vertex stands in for the part of
+        // its region at most half as far from the pivot as that vertex is.
+        TArray<TArray<float>> RegionDistances;
+        RegionDistances.SetNum(NumPicked);
+        for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+        {
+            int32 Nearest = 0;
+            for (int32 Pivot = 1; Pivot < NumPicked; Pivot++)
+            {
+                if (PivotDistances[Pivot * NumVertices + Vertex] < PivotDistances[Nearest * NumVertices + Vertex])
+                {
+                    Nearest = Pivot;
+                }
+            }
+            RegionDistances[Nearest].Add(PivotDistances[Nearest * NumVertices + Vertex]);
+        }
+        for (TArray<float>& Region : RegionDistances)
+        {
+            Region.Sort();
+        }
+
+        TermOffsets.Reserve(NumVertices + 1);
+        TermOffsets.Add(0);
+        Terms.Reserve(Undirected.NumEdges() + NumVertices * NumPicked);
+
+        for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+        {
+            const TConstArrayView<int32> Neighbors = Undirected.GetNeighbors(Vertex);
+            for (const int32 Adjacent : Neighbors)
+            {
+                Terms.Add({Adjacent, 1.f, 1.f});
+            }
+
+            for (int32 Pivot = 0; Pivot < NumPicked; Pivot++)
+            {
+                // Neighbors are already exact terms.
+                if (Pivots[Pivot] == Vertex || Algo::BinarySearch(Neighbors, Pivots[Pivot]) != INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const float Distance = PivotDistances[Pivot * NumVertices + Vertex];
+                const int32 Represented = Algo::UpperBound(RegionDistances[Pivot], Distance * 0.5f);
+                if (Represented > 0)
+                {
+                    Terms.Add({Pivots[Pivot], Distance, Represented / (Distance * Distance)});
+                }
+            }
+
+            TermOffsets.Add(Terms.Num());
+        }
+    }
+
+    void SparseStress::InitialPositions(TArray<FVector2D>& Positions) const
+    {
+        Positions.SetNumZeroed(NumVertices);
+
+        const int32 NumPicked = Pivots.Num();
+        if (NumVertices < 3 || NumPicked < 2)
+        {
+            Circle(Positions);
+            return;
+        }
+
+        // Double center the squared distances to the pivots, column-major, one column per pivot.
+        TArray<double> Centered;
+        Centered.SetNumUninitialized(NumPicked * NumVertices);
+
+        TArray<double> RowMeans;
+        RowMeans.SetNumZeroed(NumVertices);
+        double TotalMean = 0.0;
+
+        for (int32 Pivot = 0; Pivot < NumPicked; Pivot++)
+        {
+            double ColumnMean = 0.0;
+            for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                const double Distance = PivotDistances[Pivot * NumVertices + Vertex];
+                const double DistanceSqr = Distance * Distance;
+                Centered[Pivot * NumVertices + Vertex] = DistanceSqr;
+                ColumnMean += DistanceSqr;
+                RowMeans[Vertex] += DistanceSqr / NumPicked;
+            }
+            TotalMean += ColumnMean;
+            ColumnMean /= NumVertices;
+
+            for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                Centered[Pivot * NumVertices + Vertex] -= ColumnMean;
+            }
+        }
+        TotalMean /= static_cast<double>(NumPicked) * NumVertices;
+
+        for (int32 Pivot = 0; Pivot < NumPicked; Pivot++)
+        {
+            for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+            {
+                double& Value = Centered[Pivot * NumVertices + Vertex];
+                Value = -0.5 * (Value - RowMeans[Vertex] + TotalMean);
+            }
+        }
+
+        // Inner products of the columns, which is only K by K.
+        TArray<double> Inner;
+        Inner.SetNumZeroed(NumPicked * NumPicked);
+        ParallelFor(TEXT("SparseStress.PivotMDS"), NumPicked, 1,
+            [&](const int32 A)
+            {
+                for (int32 B = 0; B < NumPicked; B++)
+                {
+                    double Sum = 0.0;
+                    for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+                    {
+                        Sum += Centered[A * NumVertices + Vertex] * Centered[B * NumVertices + Vertex];
+                    }
+                    Inner[A * NumPicked + B] = Sum;
+                }
+            });
+
+        // The two principal axes, by power iteration, keeping the second orthogonal to the first.
+        TArray<double> Axes[2];
+        TArray<double> Product;
+        Product.SetNumUninitialized(NumPicked);
+
+        for (int32 Axis = 0; Axis < 2; Axis++)
+        {
+            TArray<double>& Vector = Axes[Axis];
+            Vector.SetNumUninitialized(NumPicked);
+            for (int32 i = 0; i < NumPicked; i++)
+            {
+                // Any start that isn't orthogonal to the answer will do; this one is deterministic.
+                Vector[i] = 1.0 + static_cast<double>(i % (Axis + 2));
+            }
+
+            for (int32 Iteration = 0; Iteration < PowerIterations; Iteration++)
+            {
+                if (Axis == 1)
+                {
+                    double Projection = 0.0;
+                    for (int32 i = 0; i < NumPicked; i++)
+                    {
+                        Projection += Vector[i] * Axes[0][i];
+                    }
+                    for (int32 i = 0; i < NumPicked; i++)
+                    {
+                        Vector[i] -= Projection * Axes[0][i];
+                    }
+                }
+
+                double Length = 0.0;
+                for (int32 i = 0; i < NumPicked; i++)
+                {
+                    double Sum = 0.0;
+                    for (int32 j = 0; j < NumPicked; j++)
+                    {
+                        Sum += Inner[i * NumPicked + j] * Vector[j];
+                    }
+                    Product[i] = Sum;
+                    Length += Sum * Sum;
+                }
+
+                Length = FMath::Sqrt(Length);
+                if (Length < UE_DOUBLE_SMALL_NUMBER)
+                {
+                    break;
+                }
+                for (int32 i = 0; i < NumPicked; i++)
+                {
+                    Vector[i] = Product[i] / Length;
+                }
+            }
+        }
+
+        for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+        {
+            FVector2D& Position = Positions[Vertex];
+            for (int32 Pivot = 0; Pivot < NumPicked; Pivot++)
+            {
+                const double Value = Centered[Pivot * NumVertices + Vertex];
+                Position.X += Value * Axes[0][Pivot];
+                Position.Y += Value * Axes[1][Pivot];
+            }
+        }
+
+        // Scale so the average edge is one unit long, matching the graph distances the stress is measured against.
+        double TotalEdgeLength = 0.0;
+        for (const TPair<int32, int32>& Edge : Edges)
+        {
+            TotalEdgeLength += FVector2D::Distance(Positions[Edge.Key], Positions[Edge.Value]);
+        }
+
+        if (Edges.IsEmpty() || TotalEdgeLength < UE_DOUBLE_SMALL_NUMBER)
+        {
+            Circle(Positions);
+            return;
+        }
+
+        const double Scale = Edges.Num() / TotalEdgeLength;
+        for (FVector2D& Position : Positions)
+        {
+            Position *= Scale;
+        }
+    }
+
+    double SparseStress::operator()(TArray<FVector2D>& Positions)
+    {
+        check(Positions.Num() == NumVertices);
+
+        NextPositions.SetNumUninitialized(NumVertices);
+
+        // Every vertex moves against the previous positions, so the vertices are independent, and the result is the
+        // same on any number of threads.
+        TArray<double> Moved;
+        Moved.SetNumZeroed(NumVertices);
+
+        ParallelFor(TEXT("SparseStress.Step"), NumVertices, 64,
+            [this, &Positions, &Moved](const int32 Vertex)
+            {
+                const FVector2D Position = Positions[Vertex];
+                FVector2D Sum = FVector2D::ZeroVector;
+                double TotalWeight = 0.0;
+
+                for (int32 Index = TermOffsets[Vertex]; Index < TermOffsets[Vertex + 1]; Index++)
+                {
+                    const FTerm& Term = Terms[Index];
+                    const FVector2D Other = Positions[Term.Vertex];
+                    const FVector2D Delta = Position - Other;
+                    const double Distance = Delta.Size();
+
+                    // Where this term alone would put the vertex: its ideal distance from the other, in the current direction.
+                    FVector2D Target = Other;
+                    if (Distance > UE_DOUBLE_SMALL_NUMBER)
+                    {
+                        Target += Delta * (Term.Distance / Distance);
+                    }
+
+                    Sum += Target * Term.Weight;
+                    TotalWeight += Term.Weight;
+                }
+
+                NextPositions[Vertex] = TotalWeight > 0.0 ? Sum / TotalWeight : Position;
+                Moved[Vertex] = FVector2D::Distance(NextPositions[Vertex], Position);
+            });
+
+        Swap(Positions, NextPositions);
+
+        double MaxMoved = 0.0;
+        for (const double Distance : Moved)
+        {
+            MaxMoved = FMath::Max(MaxMoved, Distance);
+        }
+        return MaxMoved;
+    }
+}
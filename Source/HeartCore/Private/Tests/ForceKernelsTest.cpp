@@ -0,0 +1,115 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Algorithms/ForceKernels.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(ForceKernelsTest,
+								 "HeartCore.ForceKernelsTest",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool ForceKernelsTest::RunTest(const FString& Parameters)
+{
+	using namespace Nodesoup;
+
+	// An odd count, so the vector kernels also run their scalar tails.
+	constexpr int32 Num = 37;
+
+	// The paths sum in a different order, so they are compared relative to magnitude.
+	auto NearlyEqual = [](const float Vector, const float Scalar)
+		{
+			return FMath::IsNearlyEqual(Vector, Scalar, 1e-3f * FMath::Max(1.f, FMath::Abs(Scalar)));
+		};
+
+	FRandomStream Random(1234);
+
+	FLayoutPositions Positions;
+	Positions.SetNumZeroed(Num);
+	for (int32 i = 0; i < Num; i++)
+	{
+		Positions.X[i] = Random.FRandRange(-100.f, 100.f);
+		Positions.Y[i] = Random.FRandRange(-100.f, 100.f);
+	}
+
+	// A coincident pair, which both paths must ignore.
+	Positions.X[5] = Positions.X[4];
+	Positions.Y[5] = Positions.Y[4];
+
+	TArray<int32> EdgesA;
+	TArray<int32> EdgesB;
+	for (int32 i = 1; i < Num; i++)
+	{
+		EdgesA.Add(i);
+		EdgesB.Add(Random.RandHelper(i));
+	}
+
+	auto TestNearlyEqual = [this, &NearlyEqual](const TCHAR* What, const FLayoutPositions& Vector, const FLayoutPositions& Scalar)
+		{
+			for (int32 i = 0; i < Vector.Num(); i++)
+			{
+				if (!NearlyEqual(Vector.X[i], Scalar.X[i]) ||
+					!NearlyEqual(Vector.Y[i], Scalar.Y[i]))
+				{
+					AddError(FString::Printf(TEXT("%s differs at %d"), What, i));
+					return;
+				}
+			}
+		};
+
+	FLayoutPositions VectorMovements;
+	FLayoutPositions ScalarMovements;
+	VectorMovements.SetNumZeroed(Num);
+	ScalarMovements.SetNumZeroed(Num);
+
+	ForceKernels::Repulsion(EForceKernelPath::Vector, Positions, 900.f, 150.f, VectorMovements);
+	ForceKernels::Repulsion(EForceKernelPath::Scalar, Positions, 900.f, 150.f, ScalarMovements);
+	TestNearlyEqual(TEXT("Repulsion"), VectorMovements, ScalarMovements);
+
+	// Rows split into ranges, as the parallel layout step runs them, match a single pass.
+	for (const EForceKernelPath Path : {EForceKernelPath::Vector, EForceKernelPath::Scalar})
+	{
+		FLayoutPositions RowMovements;
+		RowMovements.SetNumZeroed(Num);
+		ForceKernels::RepulsionRows(Path, Positions, 900.f, 150.f, 0, 13, RowMovements);
+		ForceKernels::RepulsionRows(Path, Positions, 900.f, 150.f, 13, Num, RowMovements);
+		TestNearlyEqual(TEXT("Repulsion rows"), RowMovements, ScalarMovements);
+	}
+
+	ForceKernels::Attraction(EForceKernelPath::Vector, Positions, EdgesA, EdgesB, 1.f / 30.f, VectorMovements);
+	ForceKernels::Attraction(EForceKernelPath::Scalar, Positions, EdgesA, EdgesB, 1.f / 30.f, ScalarMovements);
+	TestNearlyEqual(TEXT("Attraction"), VectorMovements, ScalarMovements);
+
+	FLayoutPositions VectorPositions = Positions;
+	FLayoutPositions ScalarPositions = Positions;
+	ForceKernels::ApplyMovements(EForceKernelPath::Vector, VectorPositions, VectorMovements, 10.f);
+	ForceKernels::ApplyMovements(EForceKernelPath::Scalar, ScalarPositions, ScalarMovements, 10.f);
+	TestNearlyEqual(TEXT("Movement"), VectorPositions, ScalarPositions);
+
+	for (int32 i = 0; i < Num; i++)
+	{
+		const FVector2D Moved = VectorPositions[i] - Positions[i];
+		TestTrue("Movement is capped", Moved.Size() <= 10.0 + 1e-3);
+	}
+
+	TArray<float> Lengths;
+	TArray<float> Strengths;
+	for (int32 i = 0; i < Num; i++)
+	{
+		Lengths.Add(Random.FRandRange(0.1f, 1.f));
+		Strengths.Add(Random.FRandRange(1.f, 300.f));
+	}
+
+	const ForceKernels::FSpringTerms VectorTerms = ForceKernels::SpringTerms(EForceKernelPath::Vector, Positions, 4, Lengths, Strengths);
+	const ForceKernels::FSpringTerms ScalarTerms = ForceKernels::SpringTerms(EForceKernelPath::Scalar, Positions, 4, Lengths, Strengths);
+	TestTrue("Spring energy", NearlyEqual(VectorTerms.Energy(), ScalarTerms.Energy()));
+	TestTrue("Spring XX", NearlyEqual(VectorTerms.XX, ScalarTerms.XX));
+	TestTrue("Spring XY", NearlyEqual(VectorTerms.XY, ScalarTerms.XY));
+	TestTrue("Spring YY", NearlyEqual(VectorTerms.YY, ScalarTerms.YY));
+	TestFalse("Coincident spring is ignored", FMath::IsNaN(VectorTerms.Energy()));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,67 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Algorithms/FruchtermanReingold.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FruchtermanReingoldTest,
+								 "HeartCore.FruchtermanReingoldTest",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FruchtermanReingoldTest::RunTest(const FString& Parameters)
+{
+	using namespace Nodesoup;
+
+	constexpr int32 Num = 40;
+
+	// No edges, so the only difference between the two steps is how repulsion is computed.
+	FTwoDimIntArray Graph;
+	Graph.SetNum(Num);
+
+	// Every point is well within the exact kernel's cutoff, so both sum the forces of every pair.
+	FRandomStream Random(4321);
+
+	TArray<FVector2D> Start;
+	for (int32 i = 0; i < Num; i++)
+	{
+		Start.Add(FVector2D(Random.FRandRange(-150.f, 150.f), Random.FRandRange(-150.f, 150.f)));
+	}
+
+	// Coincident points can't be split apart, so the quadtree stops at its depth limit with all of them in one leaf.
+	Start[1] = Start[0];
+	Start[2] = Start[0];
+	Start[11] = Start[10];
+
+	TArray<FVector2D> Exact = Start;
+	FruchtermanReingold(Graph, 15.0, 0.0, EForceKernelPath::Scalar)(Exact);
+
+	TArray<FVector2D> BarnesHut = Start;
+	FruchtermanReingold(Graph, 15.0, 0.05, EForceKernelPath::Scalar)(BarnesHut);
+
+	for (int32 i = 0; i < Num; i++)
+	{
+		if (BarnesHut[i].ContainsNaN())
+		{
+			AddError(FString::Printf(TEXT("Barnes-Hut produced NaN at %d"), i));
+			return false;
+		}
+
+		// A small Theta opens nearly every cell, so only distant groups are approximated.
+		const double Tolerance = 0.5 + 0.02 * FVector2D::Distance(Exact[i], Start[i]);
+		if (!BarnesHut[i].Equals(Exact[i], Tolerance))
+		{
+			AddError(FString::Printf(TEXT("Barnes-Hut differs from the exact kernel at %d: %s vs %s"),
+				i, *BarnesHut[i].ToString(), *Exact[i].ToString()));
+		}
+	}
+
+	// Coincident points push each other nowhere, and feel the same forces from everything else.
+	TestTrue("Coincident points move together", BarnesHut[0].Equals(BarnesHut[1]) && BarnesHut[0].Equals(BarnesHut[2]));
+	TestTrue("Coincident pair moves together", BarnesHut[10].Equals(BarnesHut[11]));
+
+	return true;
+}
+
+#endif
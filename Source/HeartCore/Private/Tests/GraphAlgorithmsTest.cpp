@@ -0,0 +1,79 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Algorithms/GraphAlgorithms.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(GraphAlgorithmsTest,
+								 "HeartCore.GraphAlgorithmsTest",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool GraphAlgorithmsTest::RunTest(const FString& Parameters)
+{
+	using namespace Heart::Algorithms;
+
+	// 0 -> 1 -> 2 -> 3, 0 -> 2, and a separate 4 -> 5
+	const FCsrGraph Dag = FCsrGraph::FromEdges(6, {MakeTuple(0, 1), MakeTuple(1, 2), MakeTuple(2, 3), MakeTuple(0, 2), MakeTuple(4, 5)},
+		{1.0, 1.0, 1.0, 5.0, 2.0});
+
+	// 0 -> 1 -> 2 -> 0, 2 -> 3
+	const FCsrGraph Cyclic = FCsrGraph::FromEdges(4, {MakeTuple(0, 1), MakeTuple(1, 2), MakeTuple(2, 0), MakeTuple(2, 3)});
+
+	FGraphScratch Scratch;
+	TArray<int32> Result;
+
+	BreadthFirst(Dag, {0}, Result, nullptr, &Scratch);
+	TestTrue("BFS order", Result == TArray<int32>{0, 1, 2, 3});
+
+	DepthFirst(Dag, {0}, Result, &Scratch);
+	TestTrue("DFS order", Result == TArray<int32>{0, 1, 2, 3});
+
+	TestTrue("DAG sorts", TopologicalSort(Dag, Result, nullptr, &Scratch));
+	TestTrue("Sort places 0 before 2", Result.Find(0) < Result.Find(2));
+	TestTrue("Sort places 2 before 3", Result.Find(2) < Result.Find(3));
+
+	TArray<int32> Cycle;
+	TestFalse("Cycle is reported", TopologicalSort(Cyclic, Result, &Cycle, &Scratch));
+	TestEqual("Cycle length", Cycle.Num(), 3);
+	TestFalse("Cycle excludes downstream vertex", Cycle.Contains(3));
+
+	TestEqual("Strongly connected components", StronglyConnectedComponents(Cyclic, Result, &Scratch), 2);
+	TestTrue("Cycle shares a component", Result[0] == Result[1] && Result[1] == Result[2]);
+
+	TestEqual("Connected components", ConnectedComponents(Dag, Result, &Scratch), 2);
+
+	TestTrue("Unweighted path exists", ShortestPath(Dag, 0, 3, Result, &Scratch));
+	TestTrue("Unweighted path", Result == TArray<int32>{0, 2, 3});
+	TestFalse("No path between components", ShortestPath(Dag, 0, 5, Result, &Scratch));
+
+	double Cost = 0.0;
+	TestTrue("Weighted path exists", ShortestPathWeighted(Dag, 0, 3, Result, &Cost, &Scratch));
+	TestTrue("Weighted path", Result == TArray<int32>{0, 1, 2, 3});
+	TestEqual("Weighted path cost", Cost, 3.0);
+
+	double Length = 0.0;
+	TestTrue("Longest path on DAG", LongestPath(Dag, Result, &Length, &Scratch));
+	TestTrue("Longest path", Result == TArray<int32>{0, 2, 3});
+	TestEqual("Longest path length", Length, 6.0);
+	TestFalse("Longest path rejects cycles", LongestPath(Cyclic, Result, nullptr, &Scratch));
+
+	const FCsrGraph Undirected = Cyclic.Undirected();
+	TestEqual("Undirected edges", Undirected.NumEdges(), 8);
+	TestTrue("Undirected neighbors", TArray<int32>(Undirected.GetNeighbors(2)) == TArray<int32>{0, 1, 3});
+
+	// Deep chains must not exhaust the stack.
+	TArray<TPair<int32, int32>> Chain;
+	for (int32 i = 0; i < 100000; ++i)
+	{
+		Chain.Add(MakeTuple(i, i + 1));
+	}
+	const FCsrGraph Deep = FCsrGraph::FromEdges(100001, Chain);
+	DepthFirst(Deep, {0}, Result, &Scratch);
+	TestEqual("Deep DFS visits all", Result.Num(), 100001);
+	TestEqual("Deep SCC", StronglyConnectedComponents(Deep, Result, &Scratch), 100001);
+
+	return true;
+}
+
+#endif
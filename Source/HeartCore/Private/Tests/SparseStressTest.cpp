@@ -0,0 +1,69 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Algorithms/Nodesoup.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(SparseStressTest,
+								 "HeartCore.SparseStressTest",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool SparseStressTest::RunTest(const FString& Parameters)
+{
+	// A 20 by 20 grid, listed from one end of each edge only, as the layout helpers do.
+	constexpr int32 Side = 20;
+	TArray<TArray<int32>> Grid;
+	Grid.SetNum(Side * Side);
+	for (int32 Y = 0; Y < Side; Y++)
+	{
+		for (int32 X = 0; X < Side; X++)
+		{
+			if (X + 1 < Side)
+			{
+				Grid[Y * Side + X].Add(Y * Side + X + 1);
+			}
+			if (Y + 1 < Side)
+			{
+				Grid[Y * Side + X].Add((Y + 1) * Side + X);
+			}
+		}
+	}
+
+	const TArray<FVector2D> Positions = Nodesoup::sparse_stress(Grid, 1000, 1000, 16);
+	TestEqual("Every vertex is placed", Positions.Num(), Side * Side);
+
+	for (const FVector2D& Position : Positions)
+	{
+		if (Position.ContainsNaN())
+		{
+			AddError(TEXT("Layout produced NaN"));
+			return false;
+		}
+	}
+
+	// A grid should unfold: opposite corners end up much further apart than neighbors.
+	const double Neighbor = FVector2D::Distance(Positions[0], Positions[1]);
+	const double Corners = FVector2D::Distance(Positions[0], Positions[Side * Side - 1]);
+	TestTrue("Grid unfolds", Corners > Neighbor * Side);
+
+	// Disconnected graphs are placed too.
+	TArray<TArray<int32>> Pairs = {{1}, {}, {3}, {}};
+	TestEqual("Components are placed", Nodesoup::sparse_stress(Pairs, 100, 100).Num(), 4);
+
+	// Returning false from the callback abandons the layout.
+	int32 Calls = 0;
+	const TArray<FVector2D> Cancelled = Nodesoup::sparse_stress(Grid,
+		[&Calls](const TConstArrayView<FVector2D> Frame, const int32 Iteration)
+		{
+			++Calls;
+			return Iteration < 2;
+		},
+		1000, 1000, 16);
+	TestEqual("Callback stops the layout", Calls, 3);
+	TestTrue("Cancelled layout is empty", Cancelled.IsEmpty());
+
+	return true;
+}
+
+#endif
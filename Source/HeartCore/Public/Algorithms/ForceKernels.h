@@ -0,0 +1,95 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Vector2D.h"
+
+namespace Nodesoup
+{
+    /**
+     * Vertex positions (or movements) stored as separate X and Y arrays of floats, so that the force kernels can load
+     * four vertices into a vector register at once.
+     */
+    struct HEARTCORE_API FLayoutPositions
+    {
+        TArray<float> X;
+        TArray<float> Y;
+
+        int32 Num() const { return X.Num(); }
+
+        void SetNumZeroed(int32 Num);
+
+        /** Resizes to Num and zeroes every element, keeping the allocation. */
+        void Zero(int32 Num);
+
+        /** Copies positions in, converting to float. */
+        void Set(TConstArrayView<FVector2D> Positions);
+
+        /** Copies positions out, resizing the array to match. */
+        void Get(TArray<FVector2D>& Positions) const;
+
+        FVector2D operator[](const int32 Index) const { return FVector2D(X[Index], Y[Index]); }
+    };
+
+    /** Which implementation of the force kernels to run. */
+    enum class EForceKernelPath : uint8
+    {
+        // Process four vertices at a time with VectorRegister math.
+        Vector,
+
+        // Process one vertex at a time. Slower, but useful to validate the vector kernels against.
+        Scalar
+    };
+
+    namespace ForceKernels
+    {
+        /**
+         * Adds the Fruchterman-Reingold repulsion, StrengthSqr / Distance, between every pair of vertices closer than
+         * Cutoff to Movements. Coincident vertices are ignored.
+         */
+        HEARTCORE_API void Repulsion(EForceKernelPath Path, const FLayoutPositions& Positions, float StrengthSqr,
+            float Cutoff, FLayoutPositions& Movements);
+
+        /**
+         * Adds the repulsion from every other vertex to the vertices in [Begin, End) only. Every vertex sums its own
+         * forces, so disjoint ranges can run on different threads, with the same results as running them in order.
+         */
+        HEARTCORE_API void RepulsionRows(EForceKernelPath Path, const FLayoutPositions& Positions, float StrengthSqr,
+            float Cutoff, int32 Begin, int32 End, FLayoutPositions& Movements);
+
+        /**
+         * Adds the Fruchterman-Reingold attraction, Distance^2 * InvStrength, along each edge from EdgesA[i] to
+         * EdgesB[i] to Movements.
+         */
+        HEARTCORE_API void Attraction(EForceKernelPath Path, const FLayoutPositions& Positions,
+            TConstArrayView<int32> EdgesA, TConstArrayView<int32> EdgesB, float InvStrength, FLayoutPositions& Movements);
+
+        /** Moves each vertex along its movement, capped to MaxDistance. Movements shorter than 1.0 are skipped. */
+        HEARTCORE_API void ApplyMovements(EForceKernelPath Path, FLayoutPositions& Positions,
+            const FLayoutPositions& Movements, float MaxDistance);
+
+        /** Moves the vertices in [Begin, End) only. */
+        HEARTCORE_API void ApplyMovements(EForceKernelPath Path, FLayoutPositions& Positions,
+            const FLayoutPositions& Movements, float MaxDistance, int32 Begin, int32 End);
+
+        /** Sums of the Kamada-Kawai spring forces acting on a vertex, and their partial derivatives. */
+        struct FSpringTerms
+        {
+            float EnergyX = 0.f;
+            float EnergyY = 0.f;
+            float XX = 0.f;
+            float XY = 0.f;
+            float YY = 0.f;
+
+            float Energy() const { return FMath::Sqrt(EnergyX * EnergyX + EnergyY * EnergyY); }
+        };
+
+        /**
+         * Sums the springs between Vertex and every other vertex. Lengths and Strengths are the row of the spring
+         * matrices for Vertex.
+         */
+        HEARTCORE_API FSpringTerms SpringTerms(EForceKernelPath Path, const FLayoutPositions& Positions, int32 Vertex,
+            TConstArrayView<float> Lengths, TConstArrayView<float> Strengths);
+    }
+}
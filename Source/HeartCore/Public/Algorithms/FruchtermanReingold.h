@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ForceKernels.h"
 #include "Nodesoup.h"
 #include "Containers/Array.h"
 
@@ -10,15 +11,71 @@ namespace Nodesoup
     class HEARTCORE_API FruchtermanReingold
     {
     public:
-        FruchtermanReingold(FGraphView InGraph, double InStrength = 15.0);
+        /**
+         * A Theta of 0 computes repulsion between all pairs of vertices within a fixed cutoff, in O(N^2). Otherwise,
+         * repulsion is approximated with Barnes-Hut in O(N log N), without a cutoff: a quadtree is rebuilt every step,
+         * and any cell that appears smaller than Theta times its distance is treated as one body. Around 0.5 to 1.0
+         * is a good tradeoff; lower is more accurate.
+         *
+         * When Parallel, each step is split across worker threads, in fixed-size chunks of vertices and edges, so the
+         * results don't depend on the number of threads. Small graphs always run on the calling thread.
+         *
+         * Each step moves vertices only by the forces computed in that step. Earlier versions carried the forces of
+         * every previous step along, so layouts converge differently than they used to.
+         */
+        FruchtermanReingold(FGraphView InGraph, double InStrength = 15.0, double InTheta = 0.0,
+            EForceKernelPath InKernelPath = EForceKernelPath::Vector, bool InParallel = false);
 
         void operator()(TArray<FVector2D>& Positions);
 
+        /** Runs a step on positions that are already split into X and Y arrays, which avoids converting every step. */
+        void operator()(FLayoutPositions& Positions);
+
     private:
+        struct FQuadCell
+        {
+            FVector2D Center;
+            double HalfSize = 0.0;
+
+            // Sum of the positions of the bodies inside, until the tree is finished, then their mean.
+            FVector2D MassCenter = FVector2D::ZeroVector;
+            int32 Mass = 0;
+
+            // The four children are stored consecutively from here, or INDEX_NONE for a leaf.
+            int32 FirstChild = INDEX_NONE;
+
+            // The only body in a leaf, or INDEX_NONE.
+            int32 Body = INDEX_NONE;
+        };
+
+        void SerialStep(FLayoutPositions& Positions);
+        void ParallelStep(FLayoutPositions& Positions);
+        void ApplyBarnesHutRepulsion(const FLayoutPositions& Positions);
+        FVector2D ComputeBarnesHutForce(int32 Node, const FLayoutPositions& Positions, TArray<int32>& NodeStack) const;
+        void BuildQuadTree(const FLayoutPositions& Positions);
+
         FGraphView Graph;
         const double Strength;
         const double StrengthSqr;
+        const double Theta;
+        const EForceKernelPath KernelPath;
+        const bool Parallel;
         double Temperature;
-        TArray<FVector2D> Movements;
+        FLayoutPositions Movements;
+
+        // Each edge once, as the ends of the edge at the same index in each array.
+        TArray<int32> EdgesA;
+        TArray<int32> EdgesB;
+
+        // Positions converted from FVector2D, kept between steps to avoid allocations.
+        FLayoutPositions Converted;
+
+        // Barnes-Hut scratch, kept between steps to avoid allocations.
+        TArray<FQuadCell> Cells;
+        TArray<int32> Stack;
+
+        // Parallel scratch: a Barnes-Hut stack per worker, and a movement buffer per chunk of edges.
+        TArray<TArray<int32>> WorkerStacks;
+        TArray<FLayoutPositions> EdgeChunkMovements;
     };
 }
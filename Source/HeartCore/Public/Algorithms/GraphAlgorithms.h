@@ -0,0 +1,118 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "Templates/Tuple.h"
+
+/**
+ * Graph algorithms over flat, compressed-sparse-row graphs. Vertices are dense indices, and nothing here recurses, so
+ * graphs of any depth are safe. Every function can be given an FGraphScratch to reuse its working memory across calls.
+ */
+namespace Heart::Algorithms
+{
+    /** Directed graph in compressed-sparse-row form. The out-edges of vertex V are Targets[Offsets[V] .. Offsets[V+1]). */
+    struct HEARTCORE_API FCsrGraph
+    {
+        TArray<int32> Offsets;
+        TArray<int32> Targets;
+
+        // Optional, parallel to Targets. Edges weigh 1 when empty.
+        TArray<double> Weights;
+
+        /** Build from an edge list. Edges keep their relative order per source vertex. */
+        static FCsrGraph FromEdges(int32 NumVertices, TConstArrayView<TPair<int32, int32>> Edges,
+                                   TConstArrayView<double> EdgeWeights = {});
+
+        /** Build from an adjacency list, such as the ones used by the Nodesoup layouts. */
+        static FCsrGraph FromAdjacencyList(const TArray<TArray<int32>>& Adjacency);
+
+        /** The same graph, with every edge reversed. */
+        FCsrGraph Transposed() const;
+
+        /** The same graph, with edges going both ways, and without self-loops or duplicate edges. Weights are dropped. */
+        FCsrGraph Undirected() const;
+
+        int32 NumVertices() const { return FMath::Max(Offsets.Num() - 1, 0); }
+        int32 NumEdges() const { return Targets.Num(); }
+
+        TConstArrayView<int32> GetNeighbors(const int32 Vertex) const
+        {
+            return TConstArrayView<int32>(Targets.GetData() + Offsets[Vertex], Offsets[Vertex + 1] - Offsets[Vertex]);
+        }
+
+        double GetWeight(const int32 Edge) const
+        {
+            return Weights.IsEmpty() ? 1.0 : Weights[Edge];
+        }
+
+        bool IsValidVertex(const int32 Vertex) const
+        {
+            return Vertex >= 0 && Vertex < NumVertices();
+        }
+    };
+
+    /** Reusable working memory. Contents are meaningless between calls. */
+    struct FGraphScratch
+    {
+        TArray<int32> Stack;
+        TArray<int32> Cursor;
+        TArray<int32> Queue;
+        TArray<int32> Marks;
+        TArray<int32> LowLink;
+        TArray<double> Costs;
+        TArray<TPair<double, int32>> Heap;
+        TBitArray<> Visited;
+    };
+
+    /**
+     * Visit every vertex reachable from the sources in breadth-first order.
+     * OutDepth, if given, receives the number of edges from the nearest source per vertex, or INDEX_NONE if unreached.
+     */
+    HEARTCORE_API void BreadthFirst(const FCsrGraph& Graph, TConstArrayView<int32> Sources, TArray<int32>& OutOrder,
+                                    TArray<int32>* OutDepth = nullptr, FGraphScratch* Scratch = nullptr);
+
+    /** Visit every vertex reachable from the sources in depth-first pre-order, taking edges in order. */
+    HEARTCORE_API void DepthFirst(const FCsrGraph& Graph, TConstArrayView<int32> Sources, TArray<int32>& OutOrder,
+                                  FGraphScratch* Scratch = nullptr);
+
+    /**
+     * Order the vertices so that every edge points forward. Returns false if the graph has a cycle, in which case
+     * OutOrder holds only the vertices that could be ordered, and OutCycle, if given, receives the vertices of one cycle
+     * in edge order.
+     */
+    HEARTCORE_API bool TopologicalSort(const FCsrGraph& Graph, TArray<int32>& OutOrder, TArray<int32>* OutCycle = nullptr,
+                                       FGraphScratch* Scratch = nullptr);
+
+    /**
+     * Tarjan's strongly connected components. OutComponent receives the component of each vertex. Components are
+     * numbered in reverse topological order of the condensed graph. Returns the number of components.
+     */
+    HEARTCORE_API int32 StronglyConnectedComponents(const FCsrGraph& Graph, TArray<int32>& OutComponent,
+                                                    FGraphScratch* Scratch = nullptr);
+
+    /**
+     * Weakly connected components, ignoring edge direction. OutComponent receives the component of each vertex,
+     * numbered in order of each component's lowest vertex. Returns the number of components.
+     */
+    HEARTCORE_API int32 ConnectedComponents(const FCsrGraph& Graph, TArray<int32>& OutComponent,
+                                            FGraphScratch* Scratch = nullptr);
+
+    /** Fewest-edges path from Source to Target, inclusive of both. Returns false if Target is unreachable. */
+    HEARTCORE_API bool ShortestPath(const FCsrGraph& Graph, int32 Source, int32 Target, TArray<int32>& OutPath,
+                                    FGraphScratch* Scratch = nullptr);
+
+    /**
+     * Lowest-cost path from Source to Target by edge weight (Dijkstra), inclusive of both. Weights must not be negative.
+     * Returns false if Target is unreachable.
+     */
+    HEARTCORE_API bool ShortestPathWeighted(const FCsrGraph& Graph, int32 Source, int32 Target, TArray<int32>& OutPath,
+                                            double* OutCost = nullptr, FGraphScratch* Scratch = nullptr);
+
+    /**
+     * Highest-weight path anywhere in a directed acyclic graph. Returns false if the graph has a cycle, or no vertices.
+     */
+    HEARTCORE_API bool LongestPath(const FCsrGraph& Graph, TArray<int32>& OutPath, double* OutLength = nullptr,
+                                   FGraphScratch* Scratch = nullptr);
+}
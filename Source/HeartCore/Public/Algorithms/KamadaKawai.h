@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ForceKernels.h"
 #include "Nodesoup.h"
 #include "Containers/Array.h"
 
@@ -11,27 +12,28 @@ namespace Nodesoup
     class KamadaKawai
     {
     public:
-        KamadaKawai(FGraphView InGraph, double Strength = 300.0, double InEnergyThreshold = 1e-2);
+        KamadaKawai(FGraphView InGraph, double Strength = 300.0, double InEnergyThreshold = 1e-2,
+            EForceKernelPath InKernelPath = EForceKernelPath::Vector);
 
         void operator()(TArray<FVector2D>& Positions) const;
 
-    private:
-        struct FSpring
-        {
-            double Length = 0.0;
-            double Strength = 0.0;
-        };
+        void operator()(FLayoutPositions& Positions) const;
 
+    private:
         FGraphView Graph;
         const double EnergyThreshold;
-        TArray<TArray<FSpring>> Springs;
+        const EForceKernelPath KernelPath;
+
+        // Spring matrices, N by N in one buffer, so that a vertex's row can be loaded alongside the positions.
+        TArray<float> SpringLengths;
+        TArray<float> SpringStrengths;
 
-        static FTwoDimIntArray FloydWarshall(FGraphView Graph);
+        ForceKernels::FSpringTerms ComputeSpringTerms(int32 Vertex, const FLayoutPositions& Positions) const;
 
-        double FindMaxVertexEnergy(TConstArrayView<FVector2D> Positions, int32& MaxEnergyVertex) const;
+        double FindMaxVertexEnergy(const FLayoutPositions& Positions, int32& MaxEnergyVertex) const;
 
-        double ComputeVertexEnergy(int32 Vertex, TConstArrayView<FVector2D> Positions) const;
+        double ComputeVertexEnergy(int32 Vertex, const FLayoutPositions& Positions) const;
 
-        FVector2D ComputeNextVertexPosition(int32 Vertex, TConstArrayView<FVector2D> Positions) const;
+        void MoveVertex(int32 Vertex, FLayoutPositions& Positions) const;
     };
 }
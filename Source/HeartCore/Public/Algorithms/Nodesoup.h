@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ForceKernels.h"
 #include "Templates/Function.h"
 
 namespace Nodesoup
@@ -16,6 +17,9 @@ namespace Nodesoup
 
     using FGraphIterationCallback = TFunctionRef<void(TConstArrayView<FVector2D>, int32)>;
 
+    /** As FGraphIterationCallback, but returning false stops the layout. */
+    using FGraphIterationPredicate = TFunctionRef<bool(TConstArrayView<FVector2D>, int32)>;
+
     /**
      * Applies the Freuchterman-Reingold algorithm to layout graph @p in a frame of dimensions
      * @p width and @p height, in @p iter-count iterations
@@ -33,7 +37,33 @@ namespace Nodesoup
         uint32 Width,
         uint32 Height,
         double Strength = 300.0,
-        double EnergyThreshold = 1e-2);
+        double EnergyThreshold = 1e-2,
+        EForceKernelPath KernelPath = EForceKernelPath::Vector);
+
+    /**
+     * Lays out the graph with the sparse stress model, starting from pivot MDS, for graphs too large for kamada_kawai.
+     * Stops after @p Iterations, or once no vertex moves more than @p Tolerance, relative to an edge length of 1.
+     */
+    HEARTCORE_API TArray<FVector2D> sparse_stress(
+        FGraphView Graph,
+        uint32 Width,
+        uint32 Height,
+        int32 NumPivots = 50,
+        uint32 Iterations = 200,
+        double Tolerance = 1e-3);
+
+    /**
+     * As above, calling @p Callback with the scaled positions after each iteration. If it returns false, the layout
+     * is abandoned, and an empty array is returned.
+     */
+    HEARTCORE_API TArray<FVector2D> sparse_stress(
+        FGraphView Graph,
+        const FGraphIterationPredicate& Callback,
+        uint32 Width,
+        uint32 Height,
+        int32 NumPivots = 50,
+        uint32 Iterations = 200,
+        double Tolerance = 1e-3);
 
     /** Assigns diameters to vertices based on their degree */
     HEARTCORE_API TArray<double> SizeRadii(FGraphView Graph, double MinRadius = 4.0, double Strength = 300.0);
@@ -0,0 +1,50 @@
+// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#pragma once
+
+#include "Nodesoup.h"
+#include "Containers/Array.h"
+
+namespace Nodesoup
+{
+    /**
+     * The sparse stress model (Ortmann, Klimenta & Brandes, 2016), for graphs too large for Kamada-Kawai.
+     * Instead of a spring between every pair of vertices, each vertex has springs to its neighbors and to a small set of
+     * pivots, each weighted by how many vertices around the pivot it stands in for. Distances take one breadth-first
+     * search per pivot, so building is O(K * M), and each step is O(N * K + M), for K pivots and M edges.
+     */
+    class HEARTCORE_API SparseStress
+    {
+    public:
+        SparseStress(FGraphView InGraph, int32 NumPivots = 50);
+
+        /** Initial layout with pivot MDS, which projects the distances to the pivots onto the plane. */
+        void InitialPositions(TArray<FVector2D>& Positions) const;
+
+        /** Moves every vertex to reduce its stress, in parallel. Returns the furthest any vertex moved. */
+        double operator()(TArray<FVector2D>& Positions);
+
+    private:
+        struct FTerm
+        {
+            int32 Vertex = INDEX_NONE;
+            float Distance = 0.f;
+            float Weight = 0.f;
+        };
+
+        int32 NumVertices = 0;
+
+        // Pivots, in the order they were picked, and their distance to every vertex, one row per pivot.
+        TArray<int32> Pivots;
+        TArray<float> PivotDistances;
+
+        // Each edge once, to measure the layout scale.
+        TArray<TPair<int32, int32>> Edges;
+
+        // The terms of vertex V are Terms[TermOffsets[V] .. TermOffsets[V+1]).
+        TArray<int32> TermOffsets;
+        TArray<FTerm> Terms;
+
+        TArray<FVector2D> NextPositions;
+    };
+}
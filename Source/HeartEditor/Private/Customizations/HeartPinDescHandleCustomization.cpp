@@ -0,0 +1,50 @@
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+
+#include "HeartPinDescHandleCustomization.h"
+
+#include "DetailWidgetRow.h"
+#include "IDetailChildrenBuilder.h"
+#include "IDetailPropertyRow.h"
+#include "Model/HeartPinDescHandle.h"
+#include "UObject/StructOnScope.h"
+
+TSharedRef<IPropertyTypeCustomization> FHeartPinDescHandleCustomization::MakeInstance()
+{
+	return MakeShared<FHeartPinDescHandleCustomization>();
+}
+
+void FHeartPinDescHandleCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> StructPropertyHandle,
+													   FDetailWidgetRow& HeaderRow,
+													   IPropertyTypeCustomizationUtils& StructCustomizationUtils)
+{
+	HeaderRow
+		.NameContent()
+		[
+			StructPropertyHandle->CreatePropertyNameWidget()
+		];
+}
+
+void FHeartPinDescHandleCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> StructPropertyHandle,
+														 IDetailChildrenBuilder& StructBuilder,
+														 IPropertyTypeCustomizationUtils& StructCustomizationUtils)
+{
+	TArray<void*> RawData;
+	StructPropertyHandle->AccessRawData(RawData);
+
+	if (RawData.Num() != 1 || RawData[0] == nullptr)
+	{
+		return;
+	}
+
+	// Show a copy, as the shared description may be replaced while the panel is open.
+	const FHeartPinDescHandle& Handle = *static_cast<const FHeartPinDescHandle*>(RawData[0]);
+	UScriptStruct* DescStruct = FHeartGraphPinDesc::StaticStruct();
+	TSharedRef<FStructOnScope> DescCopy = MakeShared<FStructOnScope>(DescStruct);
+	DescStruct->CopyScriptStruct(DescCopy->GetStructMemory(), &Handle.Get());
+
+	if (IDetailPropertyRow* Row = StructBuilder.AddExternalStructure(DescCopy))
+	{
+		Row->IsEnabled(false);
+		Row->ShouldAutoExpand(true);
+	}
+}
\ No newline at end of file
@@ -1,4 +1,4 @@
-// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
+﻿// Copyright Guy (Drakynfly) Lundvall. All Rights Reserved.
 
 #include "Graph/HeartEdGraph.h"
 #include "Editor.h"
@@ -266,40 +266,56 @@ void UHeartEdGraph::OnNodeAddedOrRemoved(const FHeartNodeAddOrRemoveEvent& Event
 
 void UHeartEdGraph::OnNodeConnectionsChanged(const FHeartGraphConnectionEvent& HeartGraphConnectionEvent)
 {
-	// @todo this needs to be more robust, and not break with bulk ConnectionEvents
+	const UHeartGraph* HeartGraph = GetHeartGraph_Implementation();
 
-	if (HeartGraphConnectionEvent.AffectedNodes.Num() != 2 ||
-		HeartGraphConnectionEvent.AffectedPins.Num() != 2)
-	{
-		return;
-	}
+	auto FindEdGraphPin = [this, HeartGraph](const FHeartGraphPinReference& Pin) -> UEdGraphPin*
+		{
+			const UHeartGraphNode* Node = HeartGraph->GetNode(Pin.NodeGuid);
+			const UHeartEdGraphNode* EdNode = FindEdGraphNodeForNode(Pin.NodeGuid);
+			if (!IsValid(Node) || !EdNode)
+			{
+				return nullptr;
+			}
 
-	const UHeartGraphNode* NodeA = HeartGraphConnectionEvent.AffectedNodes.Get(FSetElementId::FromInteger(0));
-	const UHeartGraphNode* NodeB = HeartGraphConnectionEvent.AffectedNodes.Get(FSetElementId::FromInteger(1));
-	const UEdGraphNode* EdNodeA = FindEdGraphNodeForNode(NodeA->GetGuid());
-	const UEdGraphNode* EdNodeB = FindEdGraphNodeForNode(NodeB->GetGuid());
-	const FHeartPinGuid PinAGuid = HeartGraphConnectionEvent.AffectedPins.Get(FSetElementId::FromInteger(0));
-	const FHeartPinGuid PinBGuid = HeartGraphConnectionEvent.AffectedPins.Get(FSetElementId::FromInteger(1));
+			const TConstStructView<FHeartGraphPinDesc> Desc = Node->ViewPin(Pin.PinGuid);
+			return Desc.IsValid() ? EdNode->FindPin(Desc.Get().Name) : nullptr;
+		};
 
-	if (EdNodeA && EdNodeB)
+	// Events from a transaction carry every pin it touched, so resync the links of each from the runtime graph.
+	for (const FHeartGraphPinReference& Pin : HeartGraphConnectionEvent.AffectedPinReferences)
 	{
-		auto&& EdGraphPinA = EdNodeA->FindPin(NodeA->GetPinDescChecked(PinAGuid).Name);
-		auto&& EdGraphPinB = EdNodeB->FindPin(NodeB->GetPinDescChecked(PinBGuid).Name);
+		UEdGraphPin* EdGraphPin = FindEdGraphPin(Pin);
+		if (!EdGraphPin)
+		{
+			continue;
+		}
 
-		if (EdGraphPinA && EdGraphPinB)
+		TArray<UEdGraphPin*, TInlineAllocator<4>> ExpectedLinks;
+		if (auto Connections = HeartGraph->GetNode(Pin.NodeGuid)->ViewConnections(Pin.PinGuid);
+			Connections.IsValid())
 		{
-			auto NodeAView = NodeA->ViewConnections(PinAGuid);
-			auto NodeBView = NodeB->ViewConnections(PinBGuid);
+			for (const FHeartGraphPinReference& Link : Connections.Get())
+			{
+				if (UEdGraphPin* LinkedEdGraphPin = FindEdGraphPin(Link))
+				{
+					ExpectedLinks.Add(LinkedEdGraphPin);
+				}
+			}
+		}
 
-			if (NodeAView.IsValid() && NodeBView.IsValid() &&
-				NodeAView.Get().GetLinks().Contains(NodeB->GetPinReference(PinBGuid)) &&
-				NodeBView.Get().GetLinks().Contains(NodeA->GetPinReference(PinAGuid)))
+		for (UEdGraphPin* LinkedEdGraphPin : TArray<UEdGraphPin*>(EdGraphPin->LinkedTo))
+		{
+			if (!ExpectedLinks.Contains(LinkedEdGraphPin))
 			{
-				EdGraphPinA->MakeLinkTo(EdGraphPinB);
+				EdGraphPin->BreakLinkTo(LinkedEdGraphPin);
 			}
-			else
+		}
+
+		for (UEdGraphPin* LinkedEdGraphPin : ExpectedLinks)
+		{
+			if (!EdGraphPin->LinkedTo.Contains(LinkedEdGraphPin))
 			{
-				EdGraphPinA->BreakLinkTo(EdGraphPinB);
+				EdGraphPin->MakeLinkTo(LinkedEdGraphPin);
 			}
 		}
 	}
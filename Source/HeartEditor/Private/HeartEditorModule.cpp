@@ -30,6 +30,7 @@
 #include "Graph/HeartGraphSchemaCustomization.h"
 
 #include "Customizations/HeartGuidCustomization.h"
+#include "Customizations/HeartPinDescHandleCustomization.h"
 
 #include "AssetEditor/ApplicationMode_Editor.h"
 #include "Graph/HeartEdGraphSchema.h"
@@ -249,6 +250,8 @@ void FHeartEditorModule::RegisterPropertyCustomizations()
 		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FHeartGuidCustomization::MakeInstance));
 	Customizations.Add(FHeartPinGuid::StaticStruct()->GetFName(),
 		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FHeartGuidCustomization::MakeInstance));
+	Customizations.Add(FHeartPinDescHandle::StaticStruct()->GetFName(),
+		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FHeartPinDescHandleCustomization::MakeInstance));
 
 	//Customizations.Add(FClassList::StaticStruct()->GetFName(),
 	//	FOnGetPropertyTypeCustomizationInstance::CreateStatic(&Heart::FItemsArrayCustomization::MakeInstance));
@@ -844,21 +844,19 @@ void UHeartGraphNetProxy::OnNodeConnectionsChanged_Proxy(const FHeartGraphConnec
 	UE_LOG(LogHeartNet, Log, TEXT("Proxy: OnNodeConnectionsChanged"))
 	ensure(LocalClient->GetOwnerRole() == ROLE_AutonomousProxy);
 
-	auto ByAffected = [&GraphConnectionEvent](const FHeartPinGuid Pin)
-		{
-			return GraphConnectionEvent.AffectedPins.Contains(Pin);
-		};
-
 	FHeartGraphConnectionEvent_Net Event;
 	Algo::Transform(GraphConnectionEvent.AffectedNodes, Event.AffectedNodes,
-		[&ByAffected](const TObjectPtr<UHeartGraphNode>& Node)
+		[&GraphConnectionEvent](const TObjectPtr<UHeartGraphNode>& Node)
 		{
 			FHeartReplicatedFlake NodeData;
 			NodeData.Guid = Node->GetGuid();
 
 			FHeartGraphConnectionEvent_Net_PinElement PinElement;
 			Node->QueryPins()
-				.Filter(ByAffected)
+				.Filter([&GraphConnectionEvent, NodeGuid = Node->GetGuid()](const FHeartPinGuid Pin)
+				{
+					return GraphConnectionEvent.AffectedPinReferences.Contains({NodeGuid, Pin});
+				})
 				.ForEach([Node, &PinElement](const FHeartPinGuid Pin)
 				{
 					if (auto&& Connections = Node->ViewConnections(Pin);
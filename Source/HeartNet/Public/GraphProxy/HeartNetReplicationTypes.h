@@ -81,7 +81,7 @@ struct FHeartRemoteGraphActionArguments
 
 		if (HasValidPinGuid)
 		{
-			Ar << NodeAndPinGuid.PinGuid;
+			NodeAndPinGuid.PinGuid.SerializeCompact(Ar);
 		}
 
 		Ar << PinTarget;